@@ -0,0 +1,244 @@
+// winpal_discovery_bench: Misst die Anwendungssuche (ApplicationDiscovery) über einem
+// synthetischen Verzeichnisbaum, der wie ein Startmenü aufgebaut ist (Hersteller/Produkt/…).
+// Der FileHandler liest wie unter Windows pro Datei den Kopf der Datei als "Versionsressource";
+// zum Vergleich läuft auch die alte Variante mit drei Lesevorgängen pro Datei auf einem Worker.
+// Danach das inkrementelle Nachprüfen mit dem Fingerabdruck-Baum eines vollen Laufs: einmal
+// ohne Änderung, einmal nach einer neuen und einer gelöschten Datei tief im Baum, und zuletzt
+// so, wie es mit den Meldungen des Verzeichnis-Watchers läuft: nur die beiden gemeldeten
+// Verzeichnisse werden gelesen, alle anderen nicht einmal abgefragt.
+// Alle Läufe müssen denselben Katalog liefern wie ein voller Lauf über denselben Baum.
+//
+// Aufruf: winpal_discovery_bench [directories] [filesPerDirectory] [threads]
+
+#include "Plugins/ApplicationLauncher/ApplicationDiscovery.h"
+#include "Plugins/ApplicationLauncher/DirectoryFingerprints.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Candidate = ApplicationDiscovery::Candidate;
+
+const size_t kVersionBlockBytes = 4096; // etwa eine kleine VS_VERSIONINFO-Ressource
+const int kRepetitions = 3;
+
+// --- Synthetischer Baum ------------------------------------------------------
+
+void GenerateTree(const std::filesystem::path& root, size_t directories, size_t filesPerDirectory) {
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+
+    const char* const extensions[] = { ".lnk", ".exe", ".txt", ".lnk", ".ini", ".url" };
+    std::string padding(kVersionBlockBytes, ' ');
+    for (size_t d = 0; d < directories; ++d) {
+        // Drei Ebenen wie Startmenü\Programs\Hersteller\Produkt\Werkzeuge
+        std::filesystem::path dir = root / ("Vendor " + std::to_string(d % 37)) /
+                                    ("Product " + std::to_string(d % 211)) / ("Tools " + std::to_string(d));
+        std::filesystem::create_directories(dir, ec);
+        for (size_t f = 0; f < filesPerDirectory; ++f) {
+            std::string name = "App " + std::to_string(d) + "-" + std::to_string(f);
+            std::ofstream out(dir / (name + extensions[(d + f) % 6]), std::ios::binary);
+            out << "Description=" << name << " Tool\nPublisher=Vendor " << (d % 37) << "\nVersion=1." << f << "\n";
+            out << padding;
+        }
+    }
+}
+
+// --- FileHandler -------------------------------------------------------------
+
+struct VersionBlock {
+    std::string description;
+    std::string publisher;
+    std::string version;
+};
+
+VersionBlock ReadVersionBlock(const std::filesystem::path& file) {
+    VersionBlock block;
+    std::ifstream in(file, std::ios::binary);
+    std::string data(kVersionBlockBytes, '\0');
+    in.read(&data[0], static_cast<std::streamsize>(data.size()));
+    data.resize(static_cast<size_t>(in.gcount()));
+
+    auto value = [&data](const char* key) {
+        size_t pos = data.find(key);
+        if (pos == std::string::npos) return std::string();
+        pos += std::char_traits<char>::length(key);
+        return data.substr(pos, data.find('\n', pos) - pos);
+    };
+    block.description = value("Description=");
+    block.publisher = value("Publisher=");
+    block.version = value("Version=");
+    return block;
+}
+
+std::wstring Widen(const std::string& text) {
+    return std::wstring(text.begin(), text.end());
+}
+
+bool IsApplication(const std::filesystem::path& file) {
+    std::string extension = file.extension().string();
+    return extension == ".lnk" || extension == ".exe";
+}
+
+// Wie ApplicationFinder::DescribeFile: eine Versionsressource pro Datei
+bool DescribeFile(const std::filesystem::path& file, Candidate& candidate) {
+    if (!IsApplication(file)) return false;
+    VersionBlock block = ReadVersionBlock(file);
+    candidate.name = file.stem().wstring();
+    candidate.path = file.wstring();
+    candidate.description = Widen(block.description);
+    candidate.publisher = Widen(block.publisher);
+    candidate.version = Widen(block.version);
+    return true;
+}
+
+// Vorheriges Verhalten: Beschreibung, Herausgeber und Version lasen die Ressource je einmal
+bool DescribeFileThreeReads(const std::filesystem::path& file, Candidate& candidate) {
+    if (!IsApplication(file)) return false;
+    candidate.name = file.stem().wstring();
+    candidate.path = file.wstring();
+    candidate.description = Widen(ReadVersionBlock(file).description);
+    candidate.publisher = Widen(ReadVersionBlock(file).publisher);
+    candidate.version = Widen(ReadVersionBlock(file).version);
+    return true;
+}
+
+// --- Messung -----------------------------------------------------------------
+
+struct Result {
+    double bestSeconds = 0.0;
+    std::vector<Candidate> catalogue;
+    size_t directoriesRead = 0;
+    size_t directoriesReused = 0;
+    DirectoryFingerprints fingerprints;
+};
+
+// previous: Fingerabdrücke eines früheren Laufs für das inkrementelle Nachprüfen
+Result Measure(const std::filesystem::path& root, size_t threads, const ApplicationDiscovery::FileHandler& handler,
+               const DirectoryFingerprints* previous = nullptr, const ApplicationDiscovery::Changes* changes = nullptr) {
+    Result result;
+    for (int i = 0; i < kRepetitions; ++i) {
+        // Zwei Verzeichnisquellen mit Überschneidung, wie Benutzer- und gemeinsames Startmenü
+        ApplicationDiscovery discovery(threads);
+        discovery.AddProducer([](std::vector<Candidate>& out) {
+            out.push_back({ L"Calculator", L"calc.exe", L"Windows Calculator", L"Microsoft", L"", false });
+        });
+        discovery.AddDirectory(root, true, handler);
+        discovery.AddDirectory(root / "Vendor 0", true, handler);
+
+        DirectoryFingerprints fingerprints;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Candidate> catalogue;
+        if (!discovery.Run(catalogue, previous, &fingerprints, changes)) {
+            std::fprintf(stderr, "discovery run failed\n");
+            std::exit(1);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (i == 0 || seconds < result.bestSeconds) result.bestSeconds = seconds;
+        result.catalogue = std::move(catalogue);
+        result.directoriesRead = discovery.DirectoriesRead();
+        result.directoriesReused = discovery.DirectoriesReused();
+        result.fingerprints = std::move(fingerprints);
+    }
+    return result;
+}
+
+// Wie beim Start: die Fingerabdrücke kommen serialisiert aus dem Cache
+DirectoryFingerprints RoundTrip(const DirectoryFingerprints& fingerprints) {
+    DirectoryFingerprints parsed;
+    if (!DirectoryFingerprints::Parse(fingerprints.Serialize(), parsed)) {
+        std::fprintf(stderr, "fingerprints did not survive serialization\n");
+    }
+    return parsed;
+}
+
+bool SameCatalogue(const std::vector<Candidate>& a, const std::vector<Candidate>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Candidate& x, const Candidate& y) {
+        return x.path == y.path && x.name == y.name && x.description == y.description &&
+               x.publisher == y.publisher && x.version == y.version;
+    });
+}
+
+void Report(const char* variant, size_t threads, const Result& result, const Result& baseline) {
+    std::printf("%-12s  %7zu  %10zu  %10.1f  %12.0f  %8.2fx  %s\n",
+                variant, threads, result.catalogue.size(), result.bestSeconds * 1e3,
+                result.bestSeconds > 0.0 ? static_cast<double>(result.catalogue.size()) / result.bestSeconds : 0.0,
+                result.bestSeconds > 0.0 ? baseline.bestSeconds / result.bestSeconds : 0.0,
+                SameCatalogue(result.catalogue, baseline.catalogue) ? "same" : "DIFFERENT");
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t directories = 2000;
+    size_t filesPerDirectory = 8;
+    size_t maxThreads = ApplicationDiscovery::DefaultThreadCount();
+    if (argc > 1) directories = std::strtoul(argv[1], nullptr, 10);
+    if (argc > 2) filesPerDirectory = std::strtoul(argv[2], nullptr, 10);
+    if (argc > 3) maxThreads = std::strtoul(argv[3], nullptr, 10);
+    if (directories == 0 || filesPerDirectory == 0 || maxThreads == 0) {
+        std::fprintf(stderr, "usage: winpal_discovery_bench [directories] [filesPerDirectory] [threads]\n");
+        return 1;
+    }
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "winpal_discovery_bench";
+    GenerateTree(root, directories, filesPerDirectory);
+
+    std::printf("winpal_discovery_bench  directories: %zu  files per directory: %zu  best of %d\n\n",
+                directories, filesPerDirectory, kRepetitions);
+    std::printf("%-12s  %7s  %10s  %10s  %12s  %9s  %s\n",
+                "variant", "threads", "apps", "time [ms]", "apps/s", "speedup", "catalogue");
+
+    Result baseline = Measure(root, 1, DescribeFileThreeReads);
+    Report("three reads", 1, baseline, baseline);
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        Report("one read", threads, Measure(root, threads, DescribeFile), baseline);
+    }
+
+    // Inkrementell über dem Stand eines vollen Laufs
+    std::printf("\n%-12s  %7s  %10s  %10s  %10s  %9s  %s\n",
+                "rescan", "threads", "apps", "time [ms]", "dirs read", "reused", "catalogue");
+    auto reportRescan = [maxThreads](const char* variant, const Result& result, const Result& full) {
+        std::printf("%-12s  %7zu  %10zu  %10.1f  %10zu  %9zu  %s\n",
+                    variant, maxThreads, result.catalogue.size(), result.bestSeconds * 1e3,
+                    result.directoriesRead, result.directoriesReused,
+                    SameCatalogue(result.catalogue, full.catalogue) ? "same" : "DIFFERENT");
+        std::fflush(stdout);
+    };
+
+    Result full = Measure(root, maxThreads, DescribeFile);
+    reportRescan("full", full, full);
+    DirectoryFingerprints previous = RoundTrip(full.fingerprints);
+    Result unchanged = Measure(root, maxThreads, DescribeFile, &previous);
+    reportRescan("unchanged", unchanged, full);
+    if (unchanged.fingerprints.Fingerprint() != previous.Fingerprint()) {
+        std::printf("unchanged tree produced a different fingerprint\n");
+    }
+
+    // Eine neue Anwendung tief im Baum, eine andere verschwindet
+    std::filesystem::path deep = root / "Vendor 5" / "Product 5" / "Tools 5";
+    std::ofstream(deep / "Added Tool.exe", std::ios::binary) << "Description=Added Tool\nPublisher=Vendor 5\nVersion=2.0\n";
+    std::error_code ec;
+    std::filesystem::remove(root / "Vendor 7" / "Product 7" / "Tools 7" / "App 7-0.exe", ec);
+
+    Result changedFull = Measure(root, maxThreads, DescribeFile);
+    Result changed = Measure(root, maxThreads, DescribeFile, &previous);
+    reportRescan("changed", changed, changedFull);
+
+    ApplicationDiscovery::Changes changes;
+    changes.directories.insert(deep.wstring());
+    changes.directories.insert((root / "Vendor 7" / "Product 7" / "Tools 7").wstring());
+    Result watched = Measure(root, maxThreads, DescribeFile, &previous, &changes);
+    reportRescan("watched", watched, changedFull);
+
+    std::filesystem::remove_all(root, ec);
+    return 0;
+}
@@ -0,0 +1,309 @@
+// winpal_bench: Misst Suche und Ranking ohne Win32 gegen synthetische Kataloge.
+// Pro Kataloggröße werden Tipp-Sitzungen simuliert (Query wächst Zeichen für Zeichen,
+// ein Teil davon mit Tippfehler) und für jeden Tastendruck Latenz und Allokationen erfasst.
+//
+// Aufruf: winpal_bench [maxEntries] [sessions]
+
+#include "Commands/CommandManager.h"
+#include "Commands/HistoryIndex.h"
+#include "Plugins/ApplicationLauncher/ApplicationIndex.h"
+#include "Search/StringSearch.h"
+#include "Search/TextFolding.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// --- Allokationszähler -------------------------------------------------------
+
+namespace {
+std::atomic<uint64_t> g_allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// --- Synthetischer Katalog ---------------------------------------------------
+
+const wchar_t* const kVendors[] = {
+    L"Microsoft", L"Adobe", L"Google", L"Mozilla", L"JetBrains", L"Autodesk", L"Oracle", L"Valve",
+    L"Epic Games", L"Spotify", L"Zoom", L"Slack", L"Docker", L"Python", L"Node.js", L"Git",
+    L"Intel", L"NVIDIA", L"Realtek", L"Logitech", L"Corsair", L"Blender", L"GIMP", L"Inkscape",
+    L"VLC", L"7-Zip", L"WinRAR", L"Notepad++", L"Audacity", L"OBS", L"Steam", L"Discord"
+};
+
+const wchar_t* const kProducts[] = {
+    L"Studio", L"Code", L"Photoshop", L"Illustrator", L"Chrome", L"Firefox", L"Thunderbird",
+    L"IntelliJ IDEA", L"PyCharm", L"Rider", L"AutoCAD", L"VirtualBox", L"Launcher", L"Player",
+    L"Editor", L"Manager", L"Settings", L"Control Center", L"Updater", L"Uninstaller", L"Terminal",
+    L"Explorer", L"Assistant", L"Monitor", L"Recorder", L"Viewer", L"Converter", L"Toolkit",
+    L"Client", L"Server", L"Desktop", L"Helper", L"Console", L"Designer", L"Profiler", L"Debugger"
+};
+
+const wchar_t* const kSuffixes[] = {
+    L"", L"", L"", L"", L" 2024", L" 2023", L" (x64)", L" Beta", L" Portable", L" Community", L" Pro", L" 11"
+};
+
+const wchar_t* const kKinds[] = {
+    L"application", L"utility", L"development tool", L"media player", L"system component", L"game"
+};
+
+struct CatalogueEntry {
+    std::wstring name;
+    std::wstring description;
+};
+
+// Wortwahl nach Zipf (Gewicht 1/Rang): wenige Hersteller/Produkte dominieren wie in echten Katalogen
+template <size_t N>
+std::discrete_distribution<size_t> ZipfDistribution(const wchar_t* const (&)[N]) {
+    std::vector<double> weights(N);
+    for (size_t i = 0; i < N; ++i) {
+        weights[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    return std::discrete_distribution<size_t>(weights.begin(), weights.end());
+}
+
+std::vector<CatalogueEntry> GenerateCatalogue(size_t count, std::mt19937& rng) {
+    auto vendor = ZipfDistribution(kVendors);
+    auto product = ZipfDistribution(kProducts);
+    std::uniform_int_distribution<size_t> suffix(0, std::size(kSuffixes) - 1);
+    std::uniform_int_distribution<size_t> kind(0, std::size(kKinds) - 1);
+    std::uniform_int_distribution<int> secondProduct(0, 3);
+
+    std::vector<CatalogueEntry> entries;
+    entries.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        CatalogueEntry entry;
+        std::wstring vendorName = kVendors[vendor(rng)];
+        entry.name = vendorName + L" " + kProducts[product(rng)];
+        if (secondProduct(rng) == 0) {
+            entry.name += L" ";
+            entry.name += kProducts[product(rng)];
+        }
+        entry.name += kSuffixes[suffix(rng)];
+        entry.description = vendorName + L" " + kKinds[kind(rng)] + L" #" + std::to_wstring(i);
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+// --- Tipp-Sitzungen ----------------------------------------------------------
+
+const size_t kMaxQueryLength = 12;
+const int kTypoPercent = 30;
+
+// Eine Sitzung tippt einen Namen (ggf. mit einem Tippfehler) Zeichen für Zeichen;
+// jede Zwischenstufe ist eine Query
+std::vector<std::wstring> GenerateKeystrokes(const std::vector<CatalogueEntry>& catalogue, size_t sessions, std::mt19937& rng) {
+    std::uniform_int_distribution<size_t> pick(0, catalogue.size() - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> typoKind(0, 2);
+
+    std::vector<std::wstring> keystrokes;
+    for (size_t s = 0; s < sessions; ++s) {
+        std::wstring target = catalogue[pick(rng)].name.substr(0, kMaxQueryLength);
+
+        if (target.size() > 3 && percent(rng) < kTypoPercent) {
+            std::uniform_int_distribution<size_t> position(1, target.size() - 2);
+            size_t pos = position(rng);
+            switch (typoKind(rng)) {
+                case 0: target[pos] = static_cast<wchar_t>(L'a' + (target[pos] + 7) % 26); break; // Ersetzen
+                case 1: std::swap(target[pos], target[pos + 1]); break;                             // Vertauschen
+                default: target.erase(pos, 1); break;                                               // Auslassen
+            }
+        }
+
+        for (size_t length = 1; length <= target.size(); ++length) {
+            keystrokes.push_back(target.substr(0, length));
+        }
+    }
+    return keystrokes;
+}
+
+// --- Messung -----------------------------------------------------------------
+
+class BenchCommand : public ICommand {
+public:
+    BenchCommand(const std::wstring& name, const std::wstring& description)
+        : m_name(name), m_description(description) {}
+
+    std::wstring GetName() const override { return m_name; }
+    std::wstring GetDescription() const override { return m_description; }
+    CommandCategory GetCategory() const override { return CommandCategory::APPLICATION_LAUNCHER; }
+    void Execute() override {}
+
+private:
+    std::wstring m_name;
+    std::wstring m_description;
+};
+
+struct Measurement {
+    std::vector<double> latenciesUs;
+    uint64_t allocations = 0;
+    double totalSeconds = 0.0;
+};
+
+template <typename SearchFn>
+Measurement Measure(const std::vector<std::wstring>& keystrokes, SearchFn&& search) {
+    // Aufwärmen: Puffer wachsen einmal auf ihre Endgröße, wie nach den ersten Tastendrücken im Betrieb
+    size_t warmup = std::min<size_t>(keystrokes.size(), 50);
+    for (size_t i = 0; i < warmup; ++i) {
+        search(keystrokes[i]);
+    }
+
+    Measurement result;
+    result.latenciesUs.reserve(keystrokes.size());
+    for (const auto& query : keystrokes) {
+        uint64_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        search(query);
+        auto end = std::chrono::steady_clock::now();
+        result.allocations += g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        result.totalSeconds += seconds;
+        result.latenciesUs.push_back(seconds * 1e6);
+    }
+    return result;
+}
+
+double Percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+void Report(size_t catalogueSize, const char* engine, const Measurement& m) {
+    size_t queries = m.latenciesUs.size();
+    std::printf("%9zu  %-9s  %10zu  %9.1f  %9.1f  %12.2f  %10.0f\n",
+                catalogueSize, engine, queries,
+                Percentile(m.latenciesUs, 0.50), Percentile(m.latenciesUs, 0.99),
+                queries ? static_cast<double>(m.allocations) / static_cast<double>(queries) : 0.0,
+                m.totalSeconds > 0.0 ? static_cast<double>(queries) / m.totalSeconds : 0.0);
+    std::fflush(stdout);
+}
+
+void BenchCommands(const std::vector<CatalogueEntry>& catalogue, const std::vector<std::wstring>& keystrokes) {
+    CommandManager manager;
+    for (const auto& entry : catalogue) {
+        manager.RegisterCommand(std::make_unique<BenchCommand>(entry.name, entry.description));
+    }
+    manager.RebuildSearchIndex();
+
+    std::vector<SearchResult> results;
+    Report(catalogue.size(), "commands", Measure(keystrokes, [&](const std::wstring& query) {
+        manager.FindCommandsWithRelevance(std::wstring_view(query), results);
+    }));
+}
+
+void BenchApplications(const std::vector<CatalogueEntry>& catalogue, const std::vector<std::wstring>& keystrokes) {
+    const size_t kApplicationResults = 15; // wie ApplicationFinder::MAX_APPLICATION_RESULTS
+
+    ApplicationIndex index;
+    size_t characters = 0;
+    for (const auto& entry : catalogue) {
+        characters += entry.name.size() + entry.description.size();
+    }
+    index.Reserve(catalogue.size(), characters);
+    for (const auto& entry : catalogue) {
+        index.Add(entry.name, entry.description);
+    }
+    index.BuildTrigrams();
+
+    std::wstring foldedQuery;
+    std::vector<uint32_t> ranked;
+    Report(catalogue.size(), "apps", Measure(keystrokes, [&](const std::wstring& query) {
+        FoldInto(query, foldedQuery);
+        index.Rank(foldedQuery, kApplicationResults, ranked);
+    }));
+}
+
+void BenchHistory(const std::vector<CatalogueEntry>& catalogue, const std::vector<std::wstring>& keystrokes) {
+    const size_t kHistoryResults = 6; // wie HistorySearchProvider::MAX_HISTORY_RESULTS
+
+    // Verlauf wie im Betrieb: Commands, Direktstarts und PowerShell-Zeilen, teils wiederholt
+    HistoryIndex index;
+    for (size_t i = 0; i < catalogue.size(); ++i) {
+        const auto& entry = catalogue[i];
+        switch (i % 3) {
+            case 0: index.Add(HistoryEntry(entry.name, entry.description, CommandCategory::UNKNOWN)); break;
+            case 1: index.Add(HistoryEntry(L"Launch " + entry.name, entry.description, CommandCategory::APPLICATION_LAUNCHER)); break;
+            default: index.Add(HistoryEntry(L"PowerShell: Get-Item '" + entry.name + L"'", entry.description, CommandCategory::DEVELOPER_TOOLS)); break;
+        }
+    }
+
+    std::wstring foldedQuery;
+    std::vector<HistoryIndex::Match> matches;
+    Report(catalogue.size(), "history", Measure(keystrokes, [&](const std::wstring& query) {
+        FoldInto(query, foldedQuery);
+        index.Search(foldedQuery, kHistoryResults, matches);
+    }));
+}
+
+void IsolateHistory() {
+    // ExecutionHistory liest %APPDATA%\WinPal; ein leeres Verzeichnis hält echte Verläufe aus der Messung heraus
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "winpal_bench";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+#ifdef _WIN32
+    _putenv_s("APPDATA", dir.string().c_str());
+#else
+    setenv("APPDATA", dir.string().c_str(), 1);
+#endif
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t maxEntries = 100000;
+    size_t sessions = 40;
+    if (argc > 1) maxEntries = std::strtoul(argv[1], nullptr, 10);
+    if (argc > 2) sessions = std::strtoul(argv[2], nullptr, 10);
+    if (maxEntries == 0 || sessions == 0) {
+        std::fprintf(stderr, "usage: winpal_bench [maxEntries] [sessions]\n");
+        return 1;
+    }
+
+    IsolateHistory();
+
+    std::printf("winpal_bench  string search kernel: %s  sessions per catalogue: %zu  typo rate: %d%%\n\n",
+                ActiveStringSearchKernel(), sessions, kTypoPercent);
+    std::printf("%9s  %-9s  %10s  %9s  %9s  %12s  %10s\n",
+                "catalogue", "engine", "keystrokes", "p50 [us]", "p99 [us]", "allocs/query", "queries/s");
+
+    for (size_t size = 100; size <= maxEntries; size *= 10) {
+        // Fester Seed pro Größe: Läufe sind untereinander vergleichbar
+        std::mt19937 rng(static_cast<uint32_t>(size));
+        std::vector<CatalogueEntry> catalogue = GenerateCatalogue(size, rng);
+        std::vector<std::wstring> keystrokes = GenerateKeystrokes(catalogue, sessions, rng);
+
+        BenchCommands(catalogue, keystrokes);
+        BenchApplications(catalogue, keystrokes);
+        BenchHistory(catalogue, keystrokes);
+    }
+    return 0;
+}
@@ -0,0 +1,444 @@
+#include "CommandManager.h"
+#include "../Platform/PlatformServices.h"
+#include "../Plugins/ProcessTools/ProcessTable.h"
+#include "../Search/StringSearch.h"
+#include "../Search/TextFolding.h"
+#include <algorithm>
+#include <cwctype>
+#include <filesystem>
+#include <map>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Shebang- ("!l", "!t", ...) und Natural-Commands ("launch x", "kill y") des CommandManagers.
+// Ohne Win32: Programme starten über ILauncher, Meldungen über INotifier und die
+// Zwischenablage über IClipboard, damit die Mock-Plattform diese Pfade prüfen kann.
+
+// Neue Shebang-Command-Implementierung
+bool CommandManager::IsShebangCommand(const std::wstring& input) const {
+    return !input.empty() && input[0] == L'!';
+}
+
+bool CommandManager::ExecuteShebangCommand(const std::wstring& input) {
+    if (!IsShebangCommand(input) || input.length() < 2) {
+        return false;
+    }
+    
+    wchar_t commandType = ::towlower(input[1]);
+    
+    // Extrahiere den Rest als Argument (skip "!x ")
+    std::wstring argument;
+    if (input.length() > 3 && input[2] == L' ') {
+        argument = input.substr(3);
+        
+        // Entferne führende und nachfolgende Leerzeichen
+        size_t start = argument.find_first_not_of(L' ');
+        size_t end = argument.find_last_not_of(L' ');
+        if (start != std::wstring::npos && end != std::wstring::npos) {
+            argument = argument.substr(start, end - start + 1);
+        }
+    }
+    
+    switch (commandType) {
+        case L'l': // Launch command
+            return ExecuteLaunchCommand(argument);
+            
+        case L't': // Terminate command
+            return ExecuteTerminateCommand(argument);
+            
+        case L'f': // File Tools command
+            return ExecuteFileToolCommand(argument);
+            
+        case L's': // System Info command
+            return ExecuteSystemInfoCommand(argument);
+            
+        case L'n': // Network Tools command
+            return ExecuteNetworkCommand(argument);
+            
+        case L'd': // Developer Tools command
+            return ExecuteDeveloperCommand(argument);
+            
+        case L'c': // Clipboard Manager command
+            return ExecuteClipboardCommand(argument);
+            
+        case L'z': // Settings command
+            return ExecuteSettingsCommand(argument);
+            
+        default:
+            return false;
+    }
+}
+
+bool CommandManager::ExecuteLaunchCommand(const std::wstring& appName) {
+    if (appName.empty()) {
+        return false;
+    }
+    
+    // Führe den Befehl direkt aus. Dies ist der robusteste Weg für Hotkeys.
+    // Wir umgehen hier bewusst die komplexere anwendungsinterne Suche,
+    // die für die interaktive UI gedacht ist.
+    bool success = PlatformServices::Instance().Launcher().Open(appName);
+    
+    if (success) {
+        m_executionHistory.AddExecution(
+            L"Launch " + appName,
+            L"Direct application launch via hotkey",
+            CommandCategory::APPLICATION_LAUNCHER
+        );
+    }
+    
+    return success;
+}
+
+bool CommandManager::ExecuteTerminateCommand(const std::wstring& processName) {
+    // Meldungen wie bei TerminateProcessByIdCommand über den Notifier der Plattform
+    INotifier& notifier = PlatformServices::Instance().Notifier();
+    if (processName.empty()) {
+        notifier.ShowError(L"WinPal - Fehler", L"Kein Prozessname angegeben.");
+        return false;
+    }
+    
+    // Stand der ProcessTable; ein neuer Prozess-Snapshot nur, wenn er älter als ein Aktualisierungs-Intervall ist
+    IProcessEnumerator& processEnumerator = PlatformServices::Instance().Processes();
+    ProcessTable::SnapshotPtr processes = ProcessTable::Instance().Fresh();
+    if (processes->Size() == 0) {
+        notifier.ShowError(L"WinPal - Fehler", L"Fehler beim Erstellen des Prozess-Snapshots.");
+        return false;
+    }
+    
+    bool found = false;
+    std::vector<uint32_t> processIds;
+    std::vector<std::wstring> foundProcessNames;
+    
+    // Suchbegriff einmal falten, die Prozessnamen liegen in der Tabelle bereits gefaltet vor
+    std::wstring foldedProcessName = FoldText(processName);
+    
+    // Durchsuche alle Prozesse
+    for (const auto& process : processes->Processes()) {
+        // Überprüfe ob der Prozessname übereinstimmt (exakt, mit .exe oder enthält)
+        if (ContainsFolded(process.foldedName, foldedProcessName)) {
+            processIds.push_back(process.processId);
+            foundProcessNames.push_back(process.name);
+            found = true;
+        }
+    }
+    
+    if (!found) {
+        std::wstring errorMsg = L"Prozess '" + processName + L"' nicht gefunden.";
+        notifier.ShowError(L"WinPal - Prozess nicht gefunden", errorMsg);
+        return false;
+    }
+    
+    // Terminiere gefundene Prozesse
+    int terminatedCount = 0;
+    int failedCount = 0;
+    std::wstring failedProcesses;
+    
+    for (size_t i = 0; i < processIds.size(); ++i) {
+        uint32_t pid = processIds[i];
+        std::wstring processNameForMsg = foundProcessNames[i];
+        
+        if (processEnumerator.Terminate(pid)) {
+            terminatedCount++;
+        } else {
+            failedCount++;
+            if (!failedProcesses.empty()) failedProcesses += L", ";
+            failedProcesses += processNameForMsg + L" (PID: " + std::to_wstring(pid) + L")";
+        }
+    }
+    
+    // Ergebnis-Benachrichtigungen
+    if (terminatedCount > 0) {
+        // Füge zum Verlauf hinzu
+        std::wstring description = L"Terminated " + std::to_wstring(terminatedCount) + L" process(es)";
+        if (failedCount > 0) {
+            description += L", " + std::to_wstring(failedCount) + L" failed";
+        }
+        m_executionHistory.AddExecution(
+            L"Terminate " + processName,
+            description,
+            CommandCategory::PROCESS_TOOLS
+        );
+        
+        // Erfolgs-Benachrichtigung
+        std::wstring successMsg = std::to_wstring(terminatedCount) + L" Prozess(e) erfolgreich beendet.";
+        if (failedCount > 0) {
+            successMsg += L"\n\nFehlgeschlagen: " + std::to_wstring(failedCount) + L" Prozess(e):\n" + failedProcesses;
+            notifier.ShowError(L"WinPal - Prozess teilweise beendet", successMsg);
+        } else {
+            notifier.ShowInfo(L"WinPal - Prozess beendet", successMsg);
+        }
+        return true;
+    } else {
+        // Alle Terminierungen fehlgeschlagen
+        std::wstring errorMsg = L"Alle " + std::to_wstring(failedCount) + L" gefundenen Prozesse konnten nicht beendet werden:\n" + failedProcesses;
+        errorMsg += L"\n\nMögliche Ursachen:\n• Unzureichende Berechtigungen\n• Systemgeschützte Prozesse\n• Prozess bereits beendet";
+        notifier.ShowError(L"WinPal - Terminierung fehlgeschlagen", errorMsg);
+        return false;
+    }
+}
+
+// Natürliche Command-Implementierung
+bool CommandManager::IsNaturalCommand(const std::wstring& input) const {
+    if (input.empty()) {
+        return false;
+    }
+    
+    // Konvertiere zu Kleinbuchstaben für Vergleich
+    std::wstring lowerInput = input;
+    std::transform(lowerInput.begin(), lowerInput.end(), lowerInput.begin(), ::towlower);
+    
+    // Prüfe auf bekannte Command-Wörter am Anfang
+    return (lowerInput.find(L"launch ") == 0 || 
+            lowerInput.find(L"start ") == 0 ||
+            lowerInput.find(L"run ") == 0 ||
+            lowerInput.find(L"open ") == 0 ||
+            lowerInput.find(L"terminate ") == 0 ||
+            lowerInput.find(L"term ") == 0 ||
+            lowerInput.find(L"kill ") == 0 ||
+            lowerInput.find(L"stop ") == 0);
+}
+
+bool CommandManager::ExecuteNaturalCommand(const std::wstring& input) {
+    auto [commandWord, argument] = ParseNaturalCommand(input);
+    
+    if (commandWord.empty() || argument.empty()) {
+        return false;
+    }
+    
+    // Konvertiere Command-Wort zu Kleinbuchstaben
+    std::wstring lowerCommand = commandWord;
+    std::transform(lowerCommand.begin(), lowerCommand.end(), lowerCommand.begin(), ::towlower);
+    
+    // Launch/Start/Run/Open Commands
+    if (lowerCommand == L"launch" || lowerCommand == L"start" || 
+        lowerCommand == L"run" || lowerCommand == L"open") {
+        return ExecuteLaunchCommand(argument);
+    }
+    
+    // Terminate/Term/Kill/Stop Commands
+    if (lowerCommand == L"terminate" || lowerCommand == L"term" ||
+        lowerCommand == L"kill" || lowerCommand == L"stop") {
+        return ExecuteTerminateCommand(argument);
+    }
+    
+    return false;
+}
+
+std::pair<std::wstring, std::wstring> CommandManager::ParseNaturalCommand(const std::wstring& input) const {
+    if (input.empty()) {
+        return {L"", L""};
+    }
+    
+    // Finde das erste Leerzeichen
+    size_t spacePos = input.find(L' ');
+    if (spacePos == std::wstring::npos) {
+        return {L"", L""};
+    }
+    
+    std::wstring commandWord = input.substr(0, spacePos);
+    std::wstring argument = input.substr(spacePos + 1);
+    
+    // Entferne führende und nachfolgende Leerzeichen vom Argument
+    size_t start = argument.find_first_not_of(L' ');
+    size_t end = argument.find_last_not_of(L' ');
+    if (start != std::wstring::npos && end != std::wstring::npos) {
+        argument = argument.substr(start, end - start + 1);
+    } else {
+        argument = L"";
+    }
+    
+    return {commandWord, argument};
+}
+
+// Neue Shebang-Command-Implementierungen
+
+bool CommandManager::ExecuteFileToolCommand(const std::wstring& target) {
+    ILauncher& launcher = PlatformServices::Instance().Launcher();
+    std::wstring lowerTarget = target;
+    std::transform(lowerTarget.begin(), lowerTarget.end(), lowerTarget.begin(), ::towlower);
+    
+    if (lowerTarget.empty() || lowerTarget == L"explorer" || lowerTarget == L"fileexplorer") {
+        // Open File Explorer
+        launcher.Open(L"explorer.exe");
+        m_executionHistory.AddExecution(L"Open File Explorer", L"Windows File Explorer opened", CommandCategory::FILE_TOOLS);
+        return true;
+    }
+    else if (lowerTarget == L"downloads" || lowerTarget == L"download") {
+        // Open Downloads
+        launcher.Open(L"shell:Downloads");
+        m_executionHistory.AddExecution(L"Open Downloads Folder", L"Downloads folder opened", CommandCategory::FILE_TOOLS);
+        return true;
+    }
+    else if (lowerTarget == L"desktop") {
+        // Open Desktop
+        launcher.Open(L"shell:Desktop");
+        m_executionHistory.AddExecution(L"Open Desktop Folder", L"Desktop folder opened", CommandCategory::FILE_TOOLS);
+        return true;
+    }
+    
+    return false;
+}
+
+bool CommandManager::ExecuteSystemInfoCommand(const std::wstring& infoType) {
+    ILauncher& launcher = PlatformServices::Instance().Launcher();
+    std::wstring lowerType = infoType;
+    std::transform(lowerType.begin(), lowerType.end(), lowerType.begin(), ::towlower);
+    
+    if (lowerType.empty() || lowerType == L"info" || lowerType == L"system") {
+        // Show System Information
+        launcher.Open(L"msinfo32.exe");
+        m_executionHistory.AddExecution(L"Show System Information", L"System Information utility opened", CommandCategory::SYSTEM_INFO);
+        return true;
+    }
+    else if (lowerType == L"disk" || lowerType == L"diskusage" || lowerType == L"cleanup") {
+        // Show Disk Usage
+        launcher.Open(L"cleanmgr.exe");
+        m_executionHistory.AddExecution(L"Show Disk Usage", L"Disk Cleanup utility opened", CommandCategory::SYSTEM_INFO);
+        return true;
+    }
+    
+    return false;
+}
+
+bool CommandManager::ExecuteNetworkCommand(const std::wstring& networkTool) {
+    ILauncher& launcher = PlatformServices::Instance().Launcher();
+    std::wstring lowerTool = networkTool;
+    std::transform(lowerTool.begin(), lowerTool.end(), lowerTool.begin(), ::towlower);
+    
+    if (lowerTool.empty() || lowerTool == L"ping") {
+        // Ping Google DNS
+        launcher.Open(L"cmd.exe", L"/k ping 8.8.8.8");
+        m_executionHistory.AddExecution(L"Ping Google DNS", L"Network connectivity test to 8.8.8.8", CommandCategory::NETWORK_TOOLS);
+        return true;
+    }
+    else if (lowerTool == L"info" || lowerTool == L"ipconfig") {
+        // Show Network Information
+        launcher.Open(L"cmd.exe", L"/k ipconfig /all");
+        m_executionHistory.AddExecution(L"Show Network Information", L"Network configuration displayed", CommandCategory::NETWORK_TOOLS);
+        return true;
+    }
+    
+    return false;
+}
+
+bool CommandManager::ExecuteDeveloperCommand(const std::wstring& devTool) {
+    ILauncher& launcher = PlatformServices::Instance().Launcher();
+    std::wstring lowerTool = devTool;
+    std::transform(lowerTool.begin(), lowerTool.end(), lowerTool.begin(), ::towlower);
+    
+    if (lowerTool.empty() || lowerTool == L"powershell" || lowerTool == L"ps") {
+        // Open PowerShell
+        launcher.Open(L"powershell.exe");
+        m_executionHistory.AddExecution(L"Open PowerShell", L"PowerShell terminal opened", CommandCategory::DEVELOPER_TOOLS);
+        return true;
+    }
+    else if (lowerTool == L"gitbash" || lowerTool == L"git" || lowerTool == L"bash") {
+        // Open Git Bash
+        std::vector<std::wstring> gitBashPaths = {
+            L"C:\\Program Files\\Git\\bin\\bash.exe",
+            L"C:\\Program Files (x86)\\Git\\bin\\bash.exe"
+        };
+        
+        bool found = false;
+        for (const auto& path : gitBashPaths) {
+            std::error_code ec;
+            if (std::filesystem::exists(path, ec)) {
+                launcher.Open(path);
+                found = true;
+                break;
+            }
+        }
+        
+        if (found) {
+            m_executionHistory.AddExecution(L"Open Git Bash", L"Git Bash terminal opened", CommandCategory::DEVELOPER_TOOLS);
+            return true;
+        } else {
+            PlatformServices::Instance().Notifier().ShowError(L"WinPal - Git Bash", L"Git Bash nicht gefunden. Bitte installieren Sie Git für Windows.");
+            return false;
+        }
+    }
+    
+    return false;
+}
+
+bool CommandManager::ExecuteClipboardCommand(const std::wstring& action) {
+    std::wstring lowerAction = action;
+    std::transform(lowerAction.begin(), lowerAction.end(), lowerAction.begin(), ::towlower);
+    
+    if (lowerAction.empty() || lowerAction == L"clear" || lowerAction == L"empty") {
+        // Clear Clipboard
+        INotifier& notifier = PlatformServices::Instance().Notifier();
+        if (PlatformServices::Instance().Clipboard().Clear()) {
+            m_executionHistory.AddExecution(L"Clear Clipboard", L"Clipboard contents cleared", CommandCategory::CLIPBOARD_MANAGER);
+            notifier.ShowInfo(L"WinPal - Zwischenablage", L"Zwischenablage erfolgreich geleert!");
+            return true;
+        } else {
+            notifier.ShowError(L"WinPal - Fehler", L"Fehler beim Zugriff auf die Zwischenablage!");
+            return false;
+        }
+    }
+    
+    return false;
+}
+
+bool CommandManager::ExecuteSettingsCommand(const std::wstring& settingName) {
+    ILauncher& launcher = PlatformServices::Instance().Launcher();
+    if (settingName.empty()) {
+        // Open main Windows Settings
+        launcher.Open(L"ms-settings:");
+        m_executionHistory.AddExecution(L"Windows Settings", L"Main Windows Settings opened", CommandCategory::SETTINGS);
+        return true;
+    }
+    
+    std::wstring lowerSetting = settingName;
+    std::transform(lowerSetting.begin(), lowerSetting.end(), lowerSetting.begin(), ::towlower);
+    
+    // Map common setting names to their ms-settings URIs
+    std::map<std::wstring, std::wstring> settingsMap = {
+        {L"display", L"ms-settings:display"},
+        {L"sound", L"ms-settings:sound"},
+        {L"bluetooth", L"ms-settings:bluetooth"},
+        {L"wifi", L"ms-settings:network-wifi"},
+        {L"network", L"ms-settings:network-status"},
+        {L"apps", L"ms-settings:appsfeatures"},
+        {L"system", L"ms-settings:about"},
+        {L"personalization", L"ms-settings:personalization"},
+        {L"background", L"ms-settings:personalization-background"},
+        {L"privacy", L"ms-settings:privacy"},
+        {L"updates", L"ms-settings:windowsupdate"},
+        {L"power", L"ms-settings:powersleep"},
+        {L"storage", L"ms-settings:storagesense"},
+        {L"accounts", L"ms-settings:yourinfo"},
+        {L"time", L"ms-settings:dateandtime"},
+        {L"language", L"ms-settings:regionlanguage"},
+        {L"ease", L"ms-settings:easeofaccess"},
+        {L"taskbar", L"ms-settings:taskbar"},
+        {L"startup", L"ms-settings:startupapps"}
+    };
+    
+    auto it = settingsMap.find(lowerSetting);
+    if (it != settingsMap.end()) {
+        launcher.Open(it->second);
+        m_executionHistory.AddExecution(L"Settings: " + settingName, L"Windows setting opened: " + it->second, CommandCategory::SETTINGS);
+        return true;
+    }
+    
+    // Fallback: try to search in registered settings commands
+    for (const auto& command : m_commands) {
+        if (command->GetCategory() == CommandCategory::SETTINGS) {
+            std::wstring commandName = command->GetName();
+            std::wstring lowerCommandName = commandName;
+            std::transform(lowerCommandName.begin(), lowerCommandName.end(), lowerCommandName.begin(), ::towlower);
+            
+            if (lowerCommandName.find(lowerSetting) != std::wstring::npos) {
+                command->Execute();
+                m_executionHistory.AddExecution(commandName, command->GetDescription(), CommandCategory::SETTINGS);
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
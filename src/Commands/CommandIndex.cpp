@@ -0,0 +1,41 @@
+#include "CommandIndex.h"
+#include "FrecencyStore.h"
+
+void CommandIndex::Rebuild(const std::vector<std::unique_ptr<ICommand>>& commands) {
+    Clear();
+
+    // Namen einmal abfragen, damit der Pool genau einmal alloziert wird
+    std::vector<std::pair<std::wstring, std::wstring>> texts;
+    texts.reserve(commands.size());
+    size_t totalLength = 0;
+    for (const auto& command : commands) {
+        texts.emplace_back(command->GetName(), command->GetDescription());
+        totalLength += texts.back().first.size() + texts.back().second.size();
+    }
+
+    m_entries.reserve(commands.size());
+    m_pool.Reserve(totalLength);
+    for (size_t i = 0; i < commands.size(); ++i) {
+        AddEntry(commands[i].get(), texts[i].first, texts[i].second);
+    }
+}
+
+void CommandIndex::Add(ICommand* command) {
+    if (command == nullptr) return;
+    AddEntry(command, command->GetName(), command->GetDescription());
+}
+
+void CommandIndex::Clear() {
+    m_entries.clear();
+    m_pool.Clear();
+}
+
+void CommandIndex::AddEntry(ICommand* command, const std::wstring& name, const std::wstring& description) {
+    Entry entry;
+    entry.command = command;
+    entry.category = command->GetCategory();
+    entry.id = FrecencyStore::MakeId(name);
+    entry.name = m_pool.Append(name);
+    entry.description = m_pool.Append(description);
+    m_entries.push_back(entry);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ICommand.h"
+#include "../Search/FoldedTextPool.h"
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Vorberechneter Suchindex über alle registrierten Commands.
+// Name und Beschreibung werden einmalig abgefragt und gefaltet abgelegt,
+// damit die Suche pro Tastendruck nur noch diesen Puffer liest.
+class CommandIndex {
+public:
+    struct Entry {
+        ICommand* command;
+        CommandCategory category;
+        uint64_t id; // FrecencyStore::MakeId(Name), einmalig beim Aufbau berechnet
+        FoldedTextPool::Span name;
+        FoldedTextPool::Span description;
+    };
+
+    // Baut den Index komplett neu auf (einmal nach RegisterAllPlugins)
+    void Rebuild(const std::vector<std::unique_ptr<ICommand>>& commands);
+
+    // Fügt einen einzelnen Command hinzu (RegisterCommand)
+    void Add(ICommand* command);
+
+    void Clear();
+
+    size_t Size() const { return m_entries.size(); }
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+    std::wstring_view GetName(const Entry& entry) const { return m_pool.Display(entry.name); }
+    std::wstring_view GetDescription(const Entry& entry) const { return m_pool.Display(entry.description); }
+    std::wstring_view GetFoldedName(const Entry& entry) const { return m_pool.Folded(entry.name); }
+    std::wstring_view GetFoldedDescription(const Entry& entry) const { return m_pool.Folded(entry.description); }
+
+private:
+    std::vector<Entry> m_entries;
+    FoldedTextPool m_pool;
+
+    void AddEntry(ICommand* command, const std::wstring& name, const std::wstring& description);
+};
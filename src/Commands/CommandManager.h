@@ -2,16 +2,23 @@
 
 #include "ICommand.h"
 #include "ExecutionHistory.h"
+#include "CommandIndex.h"
+#include "FrecencyStore.h"
+#include "SelectionModel.h"
+#include "../Search/FuzzyMatcher.h"
 #include <vector>
 #include <memory>
 #include <string>
 #include <map>
+#include <string_view>
 
-// Neue Struktur für erweiterte Suchergebnisse
+// Neue Struktur für erweiterte Suchergebnisse.
+// matchedText zeigt in den CommandIndex und bleibt gültig, bis ein weiterer
+// Command registriert wird.
 struct SearchResult {
     ICommand* command;
     double relevanceScore;
-    std::wstring matchedText;
+    std::wstring_view matchedText;
     enum MatchType {
         EXACT_NAME,
         STARTS_WITH_NAME,
@@ -23,7 +30,7 @@ struct SearchResult {
         CATEGORY_MATCH
     } matchType;
     
-    SearchResult(ICommand* cmd, double score, const std::wstring& matched, MatchType type)
+    SearchResult(ICommand* cmd, double score, std::wstring_view matched, MatchType type)
         : command(cmd), relevanceScore(score), matchedText(matched), matchType(type) {}
 };
 
@@ -40,19 +47,34 @@ public:
     void RegisterDeveloperToolsCommands();
     void RegisterProcessToolsCommands();
     void RegisterAllPlugins();
+
+    // Nach vielen RegisterCommand-Aufrufen: Suchindex kompakt neu aufbauen
+    void RebuildSearchIndex();
     
     // Verbesserte Suchfunktionen
     std::vector<ICommand*> FindCommands(const std::wstring& query);
     std::vector<SearchResult> FindCommandsWithRelevance(const std::wstring& query);
-    std::vector<std::wstring> GetSearchSuggestions(const std::wstring& partialQuery, int maxSuggestions = 8);
+
+    // Allokationsfreie Varianten: Die Ergebnisse landen im übergebenen Puffer,
+    // der vom Aufrufer wiederverwendet wird. Sobald Puffer und Query-Speicher
+    // einmal gewachsen sind, allokiert eine Suche nichts mehr.
+    void FindCommands(std::wstring_view query, std::vector<ICommand*>& commands);
+    void FindCommandsWithRelevance(std::wstring_view query, std::vector<SearchResult>& results);
+    std::vector<std::wstring> GetSearchSuggestions(const std::wstring& partialQuery, size_t maxSuggestions = 8);
     
-    std::vector<ICommand*> GetCommandsByCategory(CommandCategory category);
+    std::vector<ICommand*> GetCommandsByCategory(CommandCategory category);
+
+    // Registrierter Command mit genau diesem Namen oder nullptr (liest nur den Index)
+    ICommand* FindCommandByName(std::wstring_view name) const;
 
     // ExecutionHistory Funktionalität
-    void ExecuteCommand(ICommand* command);
+    // query: Eingabe, bei der der Command gewählt wurde (lernt die Auswahl für dieses Präfix)
+    void ExecuteCommand(ICommand* command, const std::wstring& query = L"");
     void ExecutePowerShellCommand(const std::wstring& command);
     ExecutionHistory& GetExecutionHistory();
     const ExecutionHistory& GetExecutionHistory() const;
+    FrecencyStore& GetFrecencyStore();
+    SelectionModel& GetSelectionModel();
 
     // Neue Shebang-Command-Funktionalität
     bool IsShebangCommand(const std::wstring& input) const;
@@ -63,15 +85,42 @@ public:
     bool ExecuteNaturalCommand(const std::wstring& input);
     
 private:
+    static constexpr size_t MAX_RELEVANCE_RESULTS = 8;
+    static constexpr double FUZZY_NAME_WEIGHT = 50.0;
+    static constexpr double FUZZY_DESCRIPTION_WEIGHT = 40.0;
+    static constexpr double MAX_FREQUENCY_BOOST = 0.5;
+
+    // Eine Ebene der inkrementellen Suche: gefaltete Query und die Indizes (aufsteigend)
+    // aller Einträge, die sie als Teilstring in Name oder Beschreibung enthalten
+    struct RefinementLevel {
+        std::wstring query;
+        std::vector<uint32_t> survivors;
+    };
+
     std::vector<std::unique_ptr<ICommand>> m_commands;
-    ExecutionHistory m_executionHistory;
+    CommandIndex m_commandIndex;
+    ExecutionHistory m_executionHistory;
+    FrecencyStore m_frecency;
+    SelectionModel m_selections;
+
+    // Wiederverwendete Puffer für den Suchpfad
+    std::wstring m_foldedQuery;
+    FuzzyMatcher m_fuzzyMatcher;
+    std::vector<SearchResult> m_resultBuffer;
+    SelectionModel::Choices m_queryChoices; // Gelernte Auswahlen zur aktuellen Query
+
+    // Präfix-Stack der letzten Queries; beim Weitertippen werden nur die Überlebenden neu bewertet
+    std::vector<RefinementLevel> m_refinementStack;
+    size_t m_refinementDepth = 0;
     
     // Neue Hilfsmethoden für erweiterte Suche
-    double CalculateRelevanceScore(const std::wstring& commandName, const std::wstring& commandDesc, 
-                                   const std::wstring& query, SearchResult::MatchType& matchType, 
-                                   std::wstring& matchedText);
-    double CalculateFuzzyScore(const std::wstring& text, const std::wstring& query);
-    double CalculateFrequencyBoost(ICommand* command);
+    double CalculateRelevanceScore(const CommandIndex::Entry& entry, std::wstring_view lowerQuery,
+                                   SearchResult::MatchType& matchType, std::wstring_view& matchedText);
+    double CalculateFuzzyRelevance(const CommandIndex::Entry& entry,
+                                   SearchResult::MatchType& matchType, std::wstring_view& matchedText);
+    double CalculateFuzzyScore(std::wstring_view text);
+    bool IsTopKSettled(const std::vector<SearchResult>& results) const;
+    double CalculateFrequencyBoost(const CommandIndex::Entry& entry, std::chrono::system_clock::time_point now);
     std::vector<std::wstring> SplitQuery(const std::wstring& query);
     bool ContainsIgnoreCase(const std::wstring& text, const std::wstring& search);
     std::wstring ToLower(const std::wstring& text);
@@ -0,0 +1,382 @@
+#include "CommandManager.h"
+#include "../Search/TextFolding.h"
+#include "../Search/TopK.h"
+#include "../Search/StringSearch.h"
+#include "../Platform/PlatformServices.h"
+#include <set>
+#include <sstream>
+
+// Registrierung, Suche, Ranking und Verlauf des CommandManagers. Bewusst ohne Win32,
+// damit winpal_bench diesen Teil auch unter Linux gegen synthetische Kataloge bauen kann.
+// Die Shebang-/Natural-Commands liegen in CommandExecution.cpp, die Registrierung der
+// Win32-Plugins in CommandManager.cpp.
+
+void CommandManager::RegisterCommand(std::unique_ptr<ICommand> command)
+{
+    m_commandIndex.Add(command.get());
+    m_refinementDepth = 0;
+    m_commands.push_back(std::move(command));
+}
+
+void CommandManager::RebuildSearchIndex()
+{
+    // Index einmal kompakt neu aufbauen, statt ihn pro Command wachsen zu lassen
+    m_commandIndex.Rebuild(m_commands);
+    m_refinementDepth = 0;
+}
+
+std::vector<ICommand*> CommandManager::FindCommands(const std::wstring& query)
+{
+    std::vector<ICommand*> found_commands;
+    FindCommands(query, found_commands);
+    return found_commands;
+}
+
+void CommandManager::FindCommands(std::wstring_view query, std::vector<ICommand*>& commands)
+{
+    FindCommandsWithRelevance(query, m_resultBuffer);
+    
+    commands.clear();
+    for (const auto& result : m_resultBuffer) {
+        commands.push_back(result.command);
+    }
+}
+
+std::vector<SearchResult> CommandManager::FindCommandsWithRelevance(const std::wstring& query)
+{
+    std::vector<SearchResult> results;
+    FindCommandsWithRelevance(query, results);
+    return results;
+}
+
+void CommandManager::FindCommandsWithRelevance(std::wstring_view query, std::vector<SearchResult>& results)
+{
+    results.clear();
+    
+    if (query.empty()) {
+        m_refinementDepth = 0;
+        return;
+    }
+    
+    // Query in den wiederverwendeten Puffer falten, Ergebnispuffer einmalig auf Maximalgröße bringen
+    FoldInto(query, m_foldedQuery);
+    std::wstring_view lowerQuery = m_foldedQuery;
+    m_fuzzyMatcher.SetPattern(lowerQuery);
+    if (results.capacity() < m_commandIndex.Size()) {
+        results.reserve(m_commandIndex.Size());
+    }
+    
+    // Stack auf die längste frühere Query zurücksetzen, die Präfix der neuen ist (Backspace, Editieren)
+    while (m_refinementDepth > 0 &&
+           lowerQuery.compare(0, m_refinementStack[m_refinementDepth - 1].query.size(),
+                              m_refinementStack[m_refinementDepth - 1].query) != 0) {
+        --m_refinementDepth;
+    }
+    
+    // Gleiche Query wie oben auf dem Stack: Kandidaten direkt übernehmen, sonst neue Ebene anlegen.
+    // Ebenen oberhalb von m_refinementDepth behalten ihren Speicher für die nächste Verlängerung.
+    // Allokiert wird damit nur, wenn eine Query tiefer reicht als alle bisherigen.
+    bool sameQuery = m_refinementDepth > 0 && m_refinementStack[m_refinementDepth - 1].query == lowerQuery;
+    if (!sameQuery) {
+        if (m_refinementDepth == m_refinementStack.size()) {
+            m_refinementStack.emplace_back();
+        }
+        m_refinementStack[m_refinementDepth].query.assign(lowerQuery.data(), lowerQuery.size());
+        m_refinementStack[m_refinementDepth].survivors.clear();
+        ++m_refinementDepth;
+    }
+    RefinementLevel& level = m_refinementStack[m_refinementDepth - 1];
+    const RefinementLevel* parent = (!sameQuery && m_refinementDepth > 1) ? &m_refinementStack[m_refinementDepth - 2] : nullptr;
+    if (!sameQuery && level.survivors.capacity() < m_commandIndex.Size()) {
+        // Jede Ebene einmal auf alle Einträge (bei einigen hundert Commands wenige KB), statt
+        // bei jeder Query mit mehr Überlebenden als bisher an dieser Stelle nachzuwachsen
+        level.survivors.reserve(m_commandIndex.Size());
+    }
+    
+    const auto& entries = m_commandIndex.GetEntries();
+    const auto now = PlatformServices::Instance().Clock().Now();
+    if (!m_selections.Lookup(lowerQuery, m_queryChoices)) {
+        m_queryChoices = SelectionModel::Choices();
+    }
+    auto addResult = [&](const CommandIndex::Entry& entry, double relevanceScore,
+                         std::wstring_view matchedText, SearchResult::MatchType matchType) {
+        // Frequency boost based on frecency
+        double frequencyBoost = CalculateFrequencyBoost(entry, now);
+        relevanceScore = relevanceScore * (1.0 + frequencyBoost);
+        // Gewohnte Wahl für genau diese Eingabe nach vorne ziehen
+        relevanceScore += SelectionModel::BOOST_WEIGHT * m_queryChoices.Affinity(entry.id);
+        results.emplace_back(entry.command, relevanceScore, matchedText, matchType);
+    };
+    
+    // Teilstring-Stufen: Wer die neue Query enthält, enthält auch jedes Präfix davon.
+    // Es reicht also, die Überlebenden der vorherigen Query neu zu bewerten.
+    auto scoreSubstring = [&](uint32_t index) {
+        SearchResult::MatchType matchType;
+        std::wstring_view matchedText;
+        double relevanceScore = CalculateRelevanceScore(entries[index], lowerQuery, matchType, matchedText);
+        if (relevanceScore > 0.0) {
+            addResult(entries[index], relevanceScore, matchedText, matchType);
+            if (!sameQuery) {
+                level.survivors.push_back(index);
+            }
+        }
+    };
+    
+    if (sameQuery) {
+        for (uint32_t index : level.survivors) scoreSubstring(index);
+    } else if (parent != nullptr) {
+        for (uint32_t index : parent->survivors) scoreSubstring(index);
+    } else {
+        for (uint32_t index = 0; index < entries.size(); ++index) scoreSubstring(index);
+    }
+    
+    // Fuzzy-Stufen sind nicht monoton und brauchen einen vollen Scan über alle übrigen Einträge.
+    // Der entfällt, wenn kein Fuzzy-Treffer mehr in die Top-K kommen kann.
+    if (FuzzyMatcher::TypoBudget(lowerQuery.size()) > 0 && !IsTopKSettled(results)) {
+        size_t next = 0;
+        for (uint32_t index = 0; index < entries.size(); ++index) {
+            // survivors ist nach Index sortiert
+            if (next < level.survivors.size() && level.survivors[next] == index) {
+                ++next;
+                continue;
+            }
+            SearchResult::MatchType matchType;
+            std::wstring_view matchedText;
+            double relevanceScore = CalculateFuzzyRelevance(entries[index], matchType, matchedText);
+            if (relevanceScore > 0.0) {
+                addResult(entries[index], relevanceScore, matchedText, matchType);
+            }
+        }
+    }
+    
+    // Nur die besten Treffer auswählen statt alles zu sortieren (reduziert für bessere Responsiveness)
+    KeepTopK(results, MAX_RELEVANCE_RESULTS, [](const SearchResult& a, const SearchResult& b) {
+        if (a.relevanceScore != b.relevanceScore) return a.relevanceScore > b.relevanceScore;
+        return a.matchType < b.matchType;
+    });
+}
+
+bool CommandManager::IsTopKSettled(const std::vector<SearchResult>& results) const
+{
+    // Bester möglicher Fuzzy-Score: Name ohne Fehler mit maximalem History- und Auswahl-Boost
+    const double maxFuzzyScore = FUZZY_NAME_WEIGHT * (1.0 + MAX_FREQUENCY_BOOST) +
+                                 (m_queryChoices.Empty() ? 0.0 : SelectionModel::BOOST_WEIGHT);
+    
+    size_t unbeatable = 0;
+    for (const auto& result : results) {
+        if (result.relevanceScore >= maxFuzzyScore && ++unbeatable >= MAX_RELEVANCE_RESULTS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::wstring> CommandManager::GetSearchSuggestions(const std::wstring& partialQuery, size_t maxSuggestions)
+{
+    std::vector<std::wstring> suggestions;
+    
+    if (partialQuery.empty()) {
+        return suggestions;
+    }
+    
+    std::wstring lowerQuery = ToLower(partialQuery);
+    std::set<std::wstring> uniqueSuggestions;
+    
+    for (const auto& entry : m_commandIndex.GetEntries()) {
+        std::wstring_view lowerName = m_commandIndex.GetFoldedName(entry);
+        std::wstring_view lowerDesc = m_commandIndex.GetFoldedDescription(entry);
+        
+        // Name (exakt, Anfang oder enthalten) oder Beschreibung
+        if (ContainsFolded(lowerName, lowerQuery) || ContainsFolded(lowerDesc, lowerQuery)) {
+            uniqueSuggestions.emplace(m_commandIndex.GetName(entry));
+        }
+    }
+    
+    // Convert to vector and limit results
+    for (const auto& suggestion : uniqueSuggestions) {
+        if (suggestions.size() >= maxSuggestions) break;
+        suggestions.push_back(suggestion);
+    }
+    
+    return suggestions;
+}
+
+double CommandManager::CalculateRelevanceScore(const CommandIndex::Entry& entry, std::wstring_view lowerQuery,
+                                              SearchResult::MatchType& matchType, std::wstring_view& matchedText)
+{
+    // Nur die Teilstring-Stufen; Fuzzy-Treffer bewertet CalculateFuzzyRelevance.
+    // Name und Beschreibung liegen bereits gefaltet im Index
+    std::wstring_view lowerName = m_commandIndex.GetFoldedName(entry);
+    std::wstring_view lowerDesc = m_commandIndex.GetFoldedDescription(entry);
+    std::wstring_view commandName = m_commandIndex.GetName(entry);
+    std::wstring_view commandDesc = m_commandIndex.GetDescription(entry);
+    
+    // Exact name match - highest priority
+    if (lowerName == lowerQuery) {
+        matchType = SearchResult::EXACT_NAME;
+        matchedText = commandName;
+        return 100.0;
+    }
+    
+    // Starts with name match
+    size_t namePos = FindFolded(lowerName, lowerQuery);
+    if (namePos == 0) {
+        matchType = SearchResult::STARTS_WITH_NAME;
+        matchedText = commandName;
+        return 90.0;
+    }
+    
+    // Contains in name
+    if (namePos != std::wstring_view::npos) {
+        matchType = SearchResult::CONTAINS_NAME;
+        matchedText = commandName;
+        return 80.0;
+    }
+    
+    // Exact description match
+    if (lowerDesc == lowerQuery) {
+        matchType = SearchResult::EXACT_DESCRIPTION;
+        matchedText = commandDesc;
+        return 70.0;
+    }
+    
+    // Contains in description
+    if (ContainsFolded(lowerDesc, lowerQuery)) {
+        matchType = SearchResult::CONTAINS_DESCRIPTION;
+        matchedText = commandDesc;
+        return 60.0;
+    }
+    
+    return 0.0; // No match
+}
+
+double CommandManager::CalculateFuzzyRelevance(const CommandIndex::Entry& entry,
+                                               SearchResult::MatchType& matchType, std::wstring_view& matchedText)
+{
+    // Fuzzy matching on name (Tippfehler-Budget hängt von der Query-Länge ab)
+    double fuzzyNameScore = CalculateFuzzyScore(m_commandIndex.GetFoldedName(entry));
+    if (fuzzyNameScore > 0.0) {
+        matchType = SearchResult::FUZZY_NAME;
+        matchedText = m_commandIndex.GetName(entry);
+        return FUZZY_NAME_WEIGHT * fuzzyNameScore;
+    }
+    
+    // Fuzzy matching on description
+    double fuzzyDescScore = CalculateFuzzyScore(m_commandIndex.GetFoldedDescription(entry));
+    if (fuzzyDescScore > 0.0) {
+        matchType = SearchResult::FUZZY_DESCRIPTION;
+        matchedText = m_commandIndex.GetDescription(entry);
+        return FUZZY_DESCRIPTION_WEIGHT * fuzzyDescScore;
+    }
+    
+    return 0.0; // No match
+}
+
+double CommandManager::CalculateFuzzyScore(std::wstring_view text)
+{
+    // Das Muster wurde pro Query in m_fuzzyMatcher vorbereitet
+    size_t queryLen = m_fuzzyMatcher.PatternLength();
+    uint32_t maxTypos = FuzzyMatcher::TypoBudget(queryLen);
+    if (maxTypos == 0 || text.empty()) return 0.0;
+    
+    // Edit-Distanz (inkl. Vertauschungen) der Query zur besten Stelle im Text
+    FuzzyMatcher::Match match;
+    if (!m_fuzzyMatcher.Search(text, maxTypos, match)) return 0.0;
+    
+    return 1.0 - static_cast<double>(match.distance) / (queryLen + 1);
+}
+
+double CommandManager::CalculateFrequencyBoost(const CommandIndex::Entry& entry, std::chrono::system_clock::time_point now)
+{
+    // Läuft auf einem Such-Worker; FrecencyStore ist thread-sicher und schlägt per Hash nach
+    double frecency = m_frecency.GetScore(entry.id, now);
+    
+    // Return boost factor (0.0 to 0.5 for 50% max boost)
+    double boost = frecency * 0.1;
+    return (boost < MAX_FREQUENCY_BOOST) ? boost : MAX_FREQUENCY_BOOST;
+}
+
+std::vector<std::wstring> CommandManager::SplitQuery(const std::wstring& query)
+{
+    std::vector<std::wstring> words;
+    std::wistringstream iss(query);
+    std::wstring word;
+    
+    while (iss >> word) {
+        words.push_back(word);
+    }
+    
+    return words;
+}
+
+bool CommandManager::ContainsIgnoreCase(const std::wstring& text, const std::wstring& search)
+{
+    return ContainsFolded(text, ToLower(search));
+}
+
+std::wstring CommandManager::ToLower(const std::wstring& text)
+{
+    // Gleiche Faltung wie im CommandIndex, sonst passen Query und Index nicht zusammen
+    return FoldText(text);
+}
+
+std::vector<ICommand*> CommandManager::GetCommandsByCategory(CommandCategory category)
+{
+    std::vector<ICommand*> category_commands;
+    
+    for (const auto& command : m_commands)
+    {
+        if (command->GetCategory() == category)
+        {
+            category_commands.push_back(command.get());
+        }
+    }
+    
+    return category_commands;
+}
+
+ICommand* CommandManager::FindCommandByName(std::wstring_view name) const
+{
+    for (const auto& entry : m_commandIndex.GetEntries()) {
+        if (m_commandIndex.GetName(entry) == name) {
+            return entry.command;
+        }
+    }
+    return nullptr;
+}
+
+void CommandManager::ExecuteCommand(ICommand* command, const std::wstring& query) {
+    if (command != nullptr) {
+        // Zum Verlauf und zur Frecency hinzufügen
+        m_executionHistory.AddExecution(command);
+        FrecencyStore::CommandId id = FrecencyStore::MakeId(command->GetName());
+        m_frecency.RecordExecution(id);
+        if (!query.empty()) {
+            m_selections.RecordSelection(query, id);
+        }
+        
+        // Command ausführen
+        command->Execute();
+    }
+}
+
+void CommandManager::ExecutePowerShellCommand(const std::wstring& command) {
+    // Zum Verlauf hinzufügen
+    m_executionHistory.AddPowerShellExecution(command);
+}
+
+ExecutionHistory& CommandManager::GetExecutionHistory() {
+    return m_executionHistory;
+}
+
+const ExecutionHistory& CommandManager::GetExecutionHistory() const {
+    return m_executionHistory;
+}
+
+FrecencyStore& CommandManager::GetFrecencyStore() {
+    return m_frecency;
+}
+
+SelectionModel& CommandManager::GetSelectionModel() {
+    return m_selections;
+}
@@ -0,0 +1,15 @@
+#include "CommandSearchProvider.h"
+
+CommandSearchProvider::CommandSearchProvider(CommandManager& commandManager)
+    : m_commandManager(commandManager) {
+}
+
+void CommandSearchProvider::Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) {
+    m_commandManager.FindCommandsWithRelevance(query, m_results);
+    if (token.IsCancelled()) return;
+
+    for (const auto& result : m_results) {
+        // Registrierte Commands gehören dem CommandManager, der shared_ptr besitzt nichts
+        hits.push_back({ std::shared_ptr<ICommand>(std::shared_ptr<ICommand>(), result.command), result.relevanceScore });
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../Search/SearchScheduler.h"
+#include "CommandManager.h"
+
+// Bewertet die registrierten Commands über den CommandManager.
+// Der Scheduler ruft den Provider nie parallel zu sich selbst auf; die Suchpuffer
+// des CommandManagers gehören damit exklusiv diesem Provider.
+class CommandSearchProvider : public ISearchProvider {
+public:
+    explicit CommandSearchProvider(CommandManager& commandManager);
+
+    void Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) override;
+
+private:
+    CommandManager& m_commandManager;
+    std::vector<SearchResult> m_results;
+};
@@ -1,103 +1,168 @@
 #include "ExecutionHistory.h"
 
+#include "../Platform/PlatformServices.h"
+#include "../Storage/PersistenceService.h"
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
-#include <cstdlib>
 
 using namespace std::chrono;
 
-namespace {
-// Helper to build the base application data directory
-std::filesystem::path GetBaseDir() {
-    std::filesystem::path base;
-    if (const char* appData = std::getenv("APPDATA")) {
-        base = appData;
-    } else {
-        base = std::filesystem::current_path();
-    }
-    base /= "WinPal";
-    std::filesystem::create_directories(base);
-    return base;
-}
-}
-
-ExecutionHistory::ExecutionHistory() : m_maxHistorySize(4) {
+ExecutionHistory::ExecutionHistory()
+    : m_history(4), m_maxHistorySize(4), m_journal(GetJournalFilePath()), m_persistence(PersistenceService::Instance()) {
     LoadSettings();
+    m_history.SetCapacity(m_maxHistorySize);
     LoadHistory();
 }
 
+ExecutionHistory::~ExecutionHistory() {
+    // Ausstehenden Journal-Job jetzt ausführen, er greift auf dieses Objekt zu
+    m_persistence.Flush(m_journal.GetPath());
+}
+
 void ExecutionHistory::AddExecution(const ICommand* command) {
     if (command == nullptr) return;
 
-    // Neuen Eintrag am Anfang hinzufügen
-    m_history.insert(m_history.begin(),
-        HistoryEntry(command->GetName(), command->GetDescription(), command->GetCategory()));
+    Insert(HistoryEntry(command->GetName(), command->GetDescription(), command->GetCategory()));
+}
 
-    // Auf maximale Größe begrenzen
-    if (m_history.size() > m_maxHistorySize) {
-        m_history.resize(m_maxHistorySize);
-    }
+void ExecutionHistory::AddExecution(const std::wstring& name, const std::wstring& description, CommandCategory category) {
+    Insert(HistoryEntry(name, description, category));
+}
 
-    SaveHistory();
+void ExecutionHistory::AddPowerShellExecution(const std::wstring& command) {
+    // Neuen PowerShell-Eintrag am Anfang hinzufügen
+    Insert(HistoryEntry(L"PowerShell: " + command, L"Direkte PowerShell-Ausführung", CommandCategory::DEVELOPER_TOOLS));
 }
 
-void ExecutionHistory::AddExecution(const std::wstring& name, const std::wstring& description, CommandCategory category) {
-    // Neuen Eintrag am Anfang hinzufügen
-    m_history.insert(m_history.begin(), HistoryEntry(name, description, category));
+void ExecutionHistory::Insert(HistoryEntry entry) {
+    // Zeitstempel über die Plattform-Uhr, damit Tests eine feste Zeit vorgeben können
+    entry.executionTime = PlatformServices::Instance().Clock().Now();
 
-    // Auf maximale Größe begrenzen
-    if (m_history.size() > m_maxHistorySize) {
-        m_history.resize(m_maxHistorySize);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Index mitführen: der älteste Eintrag fällt gleich aus dem vollen Ring
+    if (m_history.size() == m_history.capacity()) {
+        m_index.Remove(m_history.back());
     }
+    m_index.Add(entry);
+
+    // Neuen Eintrag vorne einreihen; ist der Ring voll, fällt der älteste weg
+    m_history.PushFront(std::move(entry));
 
-    SaveHistory();
+    // Nur im Speicher puffern; geschrieben wird gebündelt auf dem Persistenz-Thread
+    m_journal.Append(m_history.front());
+    m_persistence.Schedule(m_journal.GetPath(), [this]() { return PersistJournal(); });
 }
 
-void ExecutionHistory::AddPowerShellExecution(const std::wstring& command) {
-    // Neuen PowerShell-Eintrag am Anfang hinzufügen
-    m_history.insert(m_history.begin(),
-        HistoryEntry(L"PowerShell: " + command, L"Direkte PowerShell-Ausführung", CommandCategory::DEVELOPER_TOOLS));
+bool ExecutionHistory::PersistJournal() {
+    // Läuft auf dem Persistenz-Thread. Der Snapshot enthält alle bis jetzt gepufferten
+    // Datensätze; was danach angehängt wird, bleibt gepuffert und folgt mit dem nächsten Job.
+    std::vector<HistoryEntry> snapshot;
+    bool rewrite;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        rewrite = m_rewriteJournal ||
+                  m_journal.RecordCount() > std::max(COMPACTION_MIN_RECORDS, 2 * m_maxHistorySize);
+        if (rewrite) {
+            snapshot = OldestFirstLocked();
+            m_journal.DiscardPending();
+            m_rewriteJournal = false;
+        }
+    }
 
-    // Auf maximale Größe begrenzen
-    if (m_history.size() > m_maxHistorySize) {
-        m_history.resize(m_maxHistorySize);
+    if (!rewrite) {
+        // Nicht geschriebene Datensätze bleiben gepuffert, der Dienst versucht es erneut
+        return m_journal.Flush();
+    }
+    if (!m_journal.Rewrite(snapshot)) {
+        // Die verworfenen Datensätze fehlen in der Datei; beim nächsten Versuch neu schreiben
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rewriteJournal = true;
+        return false;
     }
+    return true;
+}
 
-    SaveHistory();
+std::vector<HistoryEntry> ExecutionHistory::OldestFirstLocked() const {
+    std::vector<HistoryEntry> entries;
+    entries.reserve(m_history.size());
+    for (size_t i = m_history.size(); i-- > 0;) {
+        entries.push_back(m_history[i]);
+    }
+    return entries;
 }
 
-const std::vector<HistoryEntry>& ExecutionHistory::GetHistory() const {
+const RingBuffer<HistoryEntry>& ExecutionHistory::GetHistory() const {
     return m_history;
 }
 
+std::vector<HistoryEntry> ExecutionHistory::GetSnapshot() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<HistoryEntry>(m_history.begin(), m_history.end());
+}
+
+int ExecutionHistory::CountExecutions(std::wstring_view commandName) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_index.CountOf(commandName));
+}
+
+void ExecutionHistory::Search(std::wstring_view foldedQuery, size_t limit, std::vector<HistorySearchMatch>& matches) {
+    matches.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.Search(foldedQuery, limit, m_indexMatches);
+    for (const auto& match : m_indexMatches) {
+        const HistoryIndex::Item& item = m_index.GetItem(match.item);
+        matches.push_back({ std::wstring(m_index.GetName(item)), item.description, item.category, item.count, match.score });
+    }
+}
+
 bool ExecutionHistory::IsEmpty() const {
     return m_history.empty();
 }
 
 void ExecutionHistory::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_history.clear();
-    SaveHistory();
+    m_index.Clear();
+    m_rewriteJournal = true;
+    m_persistence.Schedule(m_journal.GetPath(), [this]() { return PersistJournal(); });
 }
 
 // --- Persistence helpers ---
 
-void ExecutionHistory::SaveHistory() const {
-    std::wofstream file(GetHistoryFilePath());
-    if (!file.is_open()) return;
+void ExecutionHistory::LoadHistory() {
+    std::vector<HistoryEntry> replayed;
+    if (m_journal.Replay(replayed)) {
+        // Journal ist älteste zuerst; der Ring behält davon die neuesten m_maxHistorySize
+        for (auto& entry : replayed) {
+            m_history.PushFront(std::move(entry));
+        }
+        RebuildIndexLocked();
+        return;
+    }
+
+    // Noch kein Journal: einmalig aus dem alten Textformat übernehmen
+    LoadLegacyHistory();
+    RebuildIndexLocked();
+    m_rewriteJournal = true;
+    m_persistence.Schedule(m_journal.GetPath(), [this]() { return PersistJournal(); });
+}
 
-    for (const auto& entry : m_history) {
-        file << entry.commandName << L'\n'
-             << entry.commandDescription << L'\n'
-             << static_cast<int>(entry.category) << L'\n'
-             << duration_cast<milliseconds>(entry.executionTime.time_since_epoch()).count() << L'\n';
+void ExecutionHistory::RebuildIndexLocked() {
+    // Älteste zuerst, damit die Reihenfolge der Sequenznummern der Ausführung entspricht
+    m_index.Clear();
+    for (size_t i = m_history.size(); i-- > 0;) {
+        m_index.Add(m_history[i]);
     }
 }
 
-void ExecutionHistory::LoadHistory() {
-    std::wifstream file(GetHistoryFilePath());
+void ExecutionHistory::LoadLegacyHistory() {
+    std::wifstream file(GetLegacyHistoryFilePath());
     if (!file.is_open()) return;
 
-    m_history.clear();
+    // Die Datei steht neueste zuerst, der Ring wird von alt nach neu befüllt
+    std::vector<HistoryEntry> entries;
     std::wstring name, desc, catStr, timeStr;
     while (std::getline(file, name) && std::getline(file, desc) &&
            std::getline(file, catStr) && std::getline(file, timeStr)) {
@@ -106,12 +171,17 @@ void ExecutionHistory::LoadHistory() {
             long long ms = std::stoll(timeStr);
             HistoryEntry entry(name, desc, cat);
             entry.executionTime = system_clock::time_point(milliseconds(ms));
-            m_history.push_back(entry);
-            if (m_history.size() >= m_maxHistorySize) break;
+            entries.push_back(std::move(entry));
+            if (entries.size() >= m_maxHistorySize) break;
         } catch (...) {
             // ignore malformed entries
         }
     }
+
+    m_history.clear();
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        m_history.PushFront(std::move(*it));
+    }
 }
 
 void ExecutionHistory::LoadSettings() {
@@ -135,11 +205,15 @@ void ExecutionHistory::LoadSettings() {
     }
 }
 
-std::filesystem::path ExecutionHistory::GetHistoryFilePath() const {
-    return GetBaseDir() / "history.txt";
+std::filesystem::path ExecutionHistory::GetJournalFilePath() const {
+    return PlatformServices::Instance().FileSystem().GetDataDirectory() / "history.journal";
+}
+
+std::filesystem::path ExecutionHistory::GetLegacyHistoryFilePath() const {
+    return PlatformServices::Instance().FileSystem().GetDataDirectory() / "history.txt";
 }
 
 std::filesystem::path ExecutionHistory::GetSettingsFilePath() const {
-    return GetBaseDir() / "settings.txt";
+    return PlatformServices::Instance().FileSystem().GetDataDirectory() / "settings.txt";
 }
 
@@ -1,10 +1,17 @@
 #pragma once
 
 #include "ICommand.h"
+#include "HistoryJournal.h"
+#include "HistoryIndex.h"
+#include "../Storage/RingBuffer.h"
 #include <vector>
 #include <string>
 #include <chrono>
 #include <filesystem>
+#include <mutex>
+#include <string_view>
+
+class PersistenceService;
 
 struct HistoryEntry {
     std::wstring commandName;
@@ -21,9 +28,22 @@ struct HistoryEntry {
         : commandName(name), commandDescription(desc), category(cat), executionTime(std::chrono::system_clock::now()) {}
 };
 
+// Ein (zusammengefasster) Treffer der Verlaufssuche
+struct HistorySearchMatch {
+    std::wstring commandName;
+    std::wstring commandDescription;
+    CommandCategory category;
+    uint32_t executionCount;
+    double score;
+};
+
 class ExecutionHistory {
 public:
     ExecutionHistory();
+    ~ExecutionHistory();
+
+    ExecutionHistory(const ExecutionHistory&) = delete;
+    ExecutionHistory& operator=(const ExecutionHistory&) = delete;
 
     // Fügt einen Command zum Verlauf hinzu
     void AddExecution(const ICommand* command);
@@ -34,8 +54,19 @@ public:
     // Fügt eine PowerShell-Ausführung zum Verlauf hinzu
     void AddPowerShellExecution(const std::wstring& command);
 
-    // Gibt die History-Einträge zurück (neueste zuerst)
-    const std::vector<HistoryEntry>& GetHistory() const;
+    // Gibt die History-Einträge zurück (neueste zuerst, Index 0 ist der neueste).
+    // Nur auf dem UI-Thread verwenden; Such-Worker nutzen GetSnapshot/CountExecutions.
+    const RingBuffer<HistoryEntry>& GetHistory() const;
+
+    // Thread-sichere Kopie der Einträge (neueste zuerst)
+    std::vector<HistoryEntry> GetSnapshot() const;
+
+    // Thread-sicher: Wie oft ein Command mit diesem Namen im Verlauf steht
+    int CountExecutions(std::wstring_view commandName) const;
+
+    // Thread-sicher: Durchsucht den Verlauf über den HistoryIndex, gleiche Einträge
+    // zusammengefasst. foldedQuery muss bereits gefaltet sein.
+    void Search(std::wstring_view foldedQuery, size_t limit, std::vector<HistorySearchMatch>& matches);
 
     // Prüft ob History leer ist
     bool IsEmpty() const;
@@ -44,12 +75,31 @@ public:
     void Clear();
 
 private:
-    std::vector<HistoryEntry> m_history;
+    // Schreibzugriffe kommen vom UI-Thread, Lesezugriffe auch von den Such-Workern
+    mutable std::mutex m_mutex;
+    RingBuffer<HistoryEntry> m_history;
     size_t m_maxHistorySize;
 
-    void SaveHistory() const;
+    // Persistenz: jede Ausführung wird im Journal gepuffert und über den PersistenceService
+    // gebündelt angehängt; ab COMPACTION_MIN_RECORDS bzw. der doppelten Verlaufsgröße (oder
+    // nach Clear/Import) schreibt derselbe Job das Journal stattdessen kompakt neu
+    static constexpr size_t COMPACTION_MIN_RECORDS = 64;
+    HistoryJournal m_journal;
+    bool m_rewriteJournal = false;
+    PersistenceService& m_persistence;
+
+    // Suchindex über alle Einträge im Ring, wird bei jedem Insert mitgeführt
+    HistoryIndex m_index;
+    std::vector<HistoryIndex::Match> m_indexMatches;
+
+    void Insert(HistoryEntry entry);
+    bool PersistJournal(); // false: der PersistenceService versucht es erneut
+    std::vector<HistoryEntry> OldestFirstLocked() const;
+    void RebuildIndexLocked();
     void LoadHistory();
+    void LoadLegacyHistory();
     void LoadSettings();
-    std::filesystem::path GetHistoryFilePath() const;
+    std::filesystem::path GetJournalFilePath() const;
+    std::filesystem::path GetLegacyHistoryFilePath() const;
     std::filesystem::path GetSettingsFilePath() const;
 };
@@ -0,0 +1,157 @@
+#include "FrecencyStore.h"
+
+#include "../Platform/PlatformServices.h"
+#include "../Storage/PersistenceService.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace std::chrono;
+
+FrecencyStore::FrecencyStore()
+    : m_halfLife(hours(72)), m_filePath(GetFilePath()), m_persistence(PersistenceService::Instance()) {
+    LoadSettings();
+    Load();
+}
+
+FrecencyStore::~FrecencyStore() {
+    // Ausstehenden Schreibjob jetzt ausführen, er greift auf dieses Objekt zu
+    m_persistence.Flush(m_filePath);
+}
+
+FrecencyStore::CommandId FrecencyStore::MakeId(std::wstring_view commandName) {
+    uint64_t hash = 14695981039346656037ull;
+    for (wchar_t ch : commandName) {
+        // Nur 16 Bit pro Zeichen, damit der Schlüssel unter Windows und Linux gleich ist
+        uint16_t unit = static_cast<uint16_t>(ch);
+        hash = (hash ^ (unit & 0xFF)) * 1099511628211ull;
+        hash = (hash ^ (unit >> 8)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+void FrecencyStore::RecordExecution(CommandId id) {
+    system_clock::time_point now = PlatformServices::Instance().Clock().Now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Record& record = m_records[id];
+    record.score = DecayedScore(record, now) + 1.0;
+    record.lastUse = now;
+    ++record.count;
+
+    if (m_records.size() > MAX_RECORDS) {
+        PruneLocked(now);
+    }
+    ScheduleSave();
+}
+
+double FrecencyStore::GetScore(CommandId id, system_clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_records.find(id);
+    return it != m_records.end() ? DecayedScore(it->second, now) : 0.0;
+}
+
+uint32_t FrecencyStore::GetExecutionCount(CommandId id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_records.find(id);
+    return it != m_records.end() ? it->second.count : 0;
+}
+
+void FrecencyStore::SetHalfLife(hours halfLife) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (halfLife.count() > 0) m_halfLife = halfLife;
+}
+
+void FrecencyStore::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.clear();
+    ScheduleSave();
+}
+
+double FrecencyStore::DecayedScore(const Record& record, system_clock::time_point now) const {
+    if (record.score <= 0.0) return 0.0;
+    // Uhr zurückgestellt: nicht aufwerten, nur nicht abklingen lassen
+    double elapsed = std::max(0.0, duration<double, std::ratio<3600>>(now - record.lastUse).count());
+    return record.score * std::exp2(-elapsed / static_cast<double>(m_halfLife.count()));
+}
+
+void FrecencyStore::PruneLocked(system_clock::time_point now) {
+    // Auf drei Viertel der Obergrenze kürzen, damit nicht bei jeder Ausführung erneut sortiert wird
+    std::vector<std::pair<double, CommandId>> ranked;
+    ranked.reserve(m_records.size());
+    for (const auto& [id, record] : m_records) {
+        ranked.emplace_back(DecayedScore(record, now), id);
+    }
+    size_t keep = MAX_RECORDS * 3 / 4;
+    std::nth_element(ranked.begin(), ranked.begin() + keep, ranked.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t i = keep; i < ranked.size(); ++i) {
+        m_records.erase(ranked[i].second);
+    }
+}
+
+// --- Persistence helpers ---
+
+void FrecencyStore::ScheduleSave() {
+    m_persistence.ScheduleWrite(m_filePath, [this]() { return Serialize(); });
+}
+
+std::string FrecencyStore::Serialize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Eine Zeile pro Command: id score lastUse(ms) count
+    std::ostringstream file;
+    for (const auto& [id, record] : m_records) {
+        file << id << ' ' << record.score << ' '
+             << duration_cast<milliseconds>(record.lastUse.time_since_epoch()).count() << ' '
+             << record.count << '\n';
+    }
+    return file.str();
+}
+
+void FrecencyStore::Load() {
+    std::ifstream file(m_filePath);
+    if (!file.is_open()) return;
+
+    m_records.clear();
+    CommandId id;
+    double score;
+    long long lastUseMs;
+    uint32_t count;
+    while (file >> id >> score >> lastUseMs >> count) {
+        if (score <= 0.0 || !std::isfinite(score)) continue;
+        Record& record = m_records[id];
+        record.score = score;
+        record.lastUse = system_clock::time_point(milliseconds(lastUseMs));
+        record.count = count;
+    }
+}
+
+void FrecencyStore::LoadSettings() {
+    std::wifstream file(GetSettingsFilePath());
+    if (!file.is_open()) return;
+
+    std::wstring line;
+    while (std::getline(file, line)) {
+        size_t pos = line.find(L'=');
+        if (pos == std::wstring::npos) continue;
+        if (line.substr(0, pos) == L"frecency_half_life_hours") {
+            try {
+                long val = std::stol(line.substr(pos + 1));
+                if (val > 0) m_halfLife = hours(val);
+            } catch (...) {
+                // ignore invalid values
+            }
+        }
+    }
+}
+
+std::filesystem::path FrecencyStore::GetFilePath() const {
+    return PlatformServices::Instance().FileSystem().GetDataDirectory() / "frecency.txt";
+}
+
+std::filesystem::path FrecencyStore::GetSettingsFilePath() const {
+    return PlatformServices::Instance().FileSystem().GetDataDirectory() / "settings.txt";
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class PersistenceService;
+
+// Frecency je Command: ein exponentiell abklingender Nutzungswert (jede Ausführung +1,
+// halbiert sich nach der Halbwertszeit), dazu letzte Nutzung und Gesamtzahl.
+// Schlüssel ist ein Hash des Command-Namens, damit die Suche pro Kandidat nur eine
+// Hash-Tabelle befragt statt den Verlauf zu durchlaufen.
+// Unabhängig vom sichtbaren Verlauf in frecency.txt gespeichert; Halbwertszeit über
+// settings.txt (frecency_half_life_hours); geschrieben wird gebündelt über den PersistenceService.
+class FrecencyStore {
+public:
+    using CommandId = uint64_t;
+
+    FrecencyStore();
+    ~FrecencyStore();
+
+    FrecencyStore(const FrecencyStore&) = delete;
+    FrecencyStore& operator=(const FrecencyStore&) = delete;
+
+    // Stabiler Schlüssel für einen Command-Namen (FNV-1a über die UTF-16-Einheiten)
+    static CommandId MakeId(std::wstring_view commandName);
+
+    // Vermerkt eine Ausführung zum aktuellen Zeitpunkt der Plattform-Uhr; gespeichert wird verzögert
+    void RecordExecution(CommandId id);
+
+    // Abgeklungener Wert zum Zeitpunkt now; 0.0 für unbekannte Commands. Thread-sicher, O(1).
+    double GetScore(CommandId id, std::chrono::system_clock::time_point now) const;
+
+    // Wie oft der Command insgesamt ausgeführt wurde
+    uint32_t GetExecutionCount(CommandId id) const;
+
+    std::chrono::hours GetHalfLife() const { return m_halfLife; }
+    void SetHalfLife(std::chrono::hours halfLife);
+
+    void Clear();
+
+private:
+    struct Record {
+        double score = 0.0; // Wert zum Zeitpunkt lastUse
+        std::chrono::system_clock::time_point lastUse;
+        uint32_t count = 0;
+    };
+
+    static constexpr size_t MAX_RECORDS = 2048;
+
+    // Schreibzugriffe kommen vom UI-Thread, Lesezugriffe von den Such-Workern
+    mutable std::mutex m_mutex;
+    std::unordered_map<CommandId, Record> m_records;
+    std::chrono::hours m_halfLife;
+    std::filesystem::path m_filePath;
+    PersistenceService& m_persistence;
+
+    double DecayedScore(const Record& record, std::chrono::system_clock::time_point now) const;
+    void PruneLocked(std::chrono::system_clock::time_point now);
+    void ScheduleSave();
+    std::string Serialize() const;
+    void Load();
+    void LoadSettings();
+    std::filesystem::path GetFilePath() const;
+    std::filesystem::path GetSettingsFilePath() const;
+};
@@ -0,0 +1,229 @@
+#include "HistoryIndex.h"
+
+#include "ExecutionHistory.h"
+#include "../Search/StringSearch.h"
+#include "../Search/TopK.h"
+#include "../Search/TrigramIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Trennzeichen zwischen Wörtern; Nicht-ASCII zählt immer als Wortzeichen
+bool IsWordChar(wchar_t c) {
+    if (c >= 0x80) return true;
+    return (c >= L'a' && c <= L'z') || (c >= L'0' && c <= L'9');
+}
+
+template <typename Fn>
+void ForEachWordStart(std::wstring_view folded, Fn&& fn) {
+    for (size_t i = 0; i < folded.size(); ++i) {
+        if (IsWordChar(folded[i]) && (i == 0 || !IsWordChar(folded[i - 1]))) {
+            size_t end = i;
+            while (end < folded.size() && end - i < 2 && IsWordChar(folded[end])) ++end;
+            fn(folded.substr(i, end - i));
+        }
+    }
+}
+
+} // namespace
+
+void HistoryIndex::Add(const HistoryEntry& entry) {
+    auto it = m_itemByName.find(entry.commandName);
+    if (it != m_itemByName.end()) {
+        Item& item = m_items[it->second];
+        if (item.count == 0) --m_deadItems;
+        ++item.count;
+        item.lastSequence = ++m_sequence;
+        item.description = entry.commandDescription;
+        item.category = entry.category;
+        return;
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_items.size());
+    Item item;
+    item.name = m_pool.Append(entry.commandName);
+    item.description = entry.commandDescription;
+    item.category = entry.category;
+    item.count = 1;
+    item.lastSequence = ++m_sequence;
+    m_items.push_back(std::move(item));
+    m_itemByName.emplace(entry.commandName, id);
+    IndexItem(id);
+}
+
+void HistoryIndex::Remove(const HistoryEntry& entry) {
+    auto it = m_itemByName.find(entry.commandName);
+    if (it == m_itemByName.end()) return;
+
+    Item& item = m_items[it->second];
+    if (item.count == 0) return;
+    if (--item.count == 0) {
+        ++m_deadItems;
+        if (m_deadItems >= REBUILD_MIN_DEAD_ITEMS && m_deadItems > LiveItems()) {
+            Rebuild();
+        }
+    }
+}
+
+uint32_t HistoryIndex::CountOf(std::wstring_view name) const {
+    auto it = m_itemByName.find(std::wstring(name));
+    return it != m_itemByName.end() ? m_items[it->second].count : 0;
+}
+
+void HistoryIndex::Clear() {
+    m_items.clear();
+    m_pool.Clear();
+    m_itemByName.clear();
+    m_trigrams.clear();
+    m_wordPrefixes.clear();
+    m_deadItems = 0;
+    m_sequence = 0;
+}
+
+void HistoryIndex::Search(std::wstring_view foldedQuery, size_t limit, std::vector<Match>& out) {
+    out.clear();
+
+    // Query wie die Namen an Nicht-Wortzeichen in Wörter zerlegen; jedes Wort steuert
+    // seine Posting-Listen bei
+    m_queryWords.clear();
+    m_lists.clear();
+    // Höchstens ein Wort bzw. eine Liste je Zeichen
+    if (m_queryWords.capacity() < foldedQuery.size()) m_queryWords.reserve(foldedQuery.size());
+    if (m_lists.capacity() < foldedQuery.size()) m_lists.reserve(foldedQuery.size());
+    for (size_t start = 0; start < foldedQuery.size();) {
+        if (!IsWordChar(foldedQuery[start])) {
+            ++start;
+            continue;
+        }
+        size_t end = start;
+        while (end < foldedQuery.size() && IsWordChar(foldedQuery[end])) ++end;
+        m_queryWords.push_back(foldedQuery.substr(start, end - start));
+        start = end;
+    }
+    if (m_queryWords.empty() || limit == 0) return;
+
+    for (std::wstring_view word : m_queryWords) {
+        if (word.size() >= TrigramIndex::GRAM_LENGTH) {
+            for (size_t i = 0; i + TrigramIndex::GRAM_LENGTH <= word.size(); ++i) {
+                auto it = m_trigrams.find(TrigramIndex::MakeKey(word.data() + i));
+                if (it == m_trigrams.end()) return;
+                m_lists.push_back(&it->second);
+            }
+        } else {
+            auto it = m_wordPrefixes.find(PrefixKey(word));
+            if (it == m_wordPrefixes.end()) return;
+            m_lists.push_back(&it->second);
+        }
+    }
+
+    // Kürzeste Liste zuerst, dann galoppierend schneiden
+    std::sort(m_lists.begin(), m_lists.end(),
+              [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+    // Kandidaten und Treffer sind höchstens alle Einträge; wachsen also nur mit dem Verlauf
+    if (m_candidates.capacity() < m_items.size()) m_candidates.reserve(m_items.size());
+    if (out.capacity() < m_items.size()) out.reserve(m_items.size());
+    m_candidates.assign(m_lists.front()->begin(), m_lists.front()->end());
+    for (size_t i = 1; i < m_lists.size() && !m_candidates.empty(); ++i) {
+        TrigramIndex::IntersectGalloping(m_candidates, m_lists[i]->data(), m_lists[i]->size());
+    }
+
+    for (uint32_t id : m_candidates) {
+        const Item& item = m_items[id];
+        if (item.count == 0) continue;
+
+        // Trigramme liefern eine Obermenge; Wörter ab vier Zeichen am Text bestätigen
+        std::wstring_view name = m_pool.Folded(item.name);
+        bool matches = true;
+        for (std::wstring_view word : m_queryWords) {
+            if (word.size() > TrigramIndex::GRAM_LENGTH && !ContainsFolded(name, word)) {
+                matches = false;
+                break;
+            }
+        }
+        if (matches) {
+            out.push_back({ id, Score(item, foldedQuery) });
+        }
+    }
+
+    KeepTopK(out, limit, [](const Match& a, const Match& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return a.item > b.item;
+    });
+}
+
+void HistoryIndex::IndexItem(uint32_t id) {
+    std::wstring_view folded = m_pool.Folded(m_items[id].name);
+
+    // Jeder Schlüssel höchstens einmal pro Item, damit die Listen duplikatfrei bleiben
+    std::vector<uint64_t> keys;
+    for (size_t i = 0; i + TrigramIndex::GRAM_LENGTH <= folded.size(); ++i) {
+        keys.push_back(TrigramIndex::MakeKey(folded.data() + i));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (uint64_t key : keys) {
+        m_trigrams[key].push_back(id);
+    }
+
+    keys.clear();
+    ForEachWordStart(folded, [&keys](std::wstring_view prefix) {
+        keys.push_back(PrefixKey(prefix.substr(0, 1)));
+        if (prefix.size() > 1) keys.push_back(PrefixKey(prefix));
+    });
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (uint64_t key : keys) {
+        m_wordPrefixes[key].push_back(id);
+    }
+}
+
+void HistoryIndex::Rebuild() {
+    // Nur noch ausgeführte Items übernehmen; Reihenfolge und Sequenznummern bleiben erhalten
+    std::vector<std::pair<std::wstring, Item>> live;
+    live.reserve(LiveItems());
+    for (const auto& item : m_items) {
+        if (item.count > 0) {
+            live.emplace_back(std::wstring(m_pool.Display(item.name)), item);
+        }
+    }
+
+    uint64_t sequence = m_sequence;
+    Clear();
+    m_sequence = sequence;
+    for (auto& [name, item] : live) {
+        uint32_t id = static_cast<uint32_t>(m_items.size());
+        item.name = m_pool.Append(name);
+        m_items.push_back(std::move(item));
+        m_itemByName.emplace(std::move(name), id);
+        IndexItem(id);
+    }
+}
+
+double HistoryIndex::Score(const Item& item, std::wstring_view foldedQuery) const {
+    std::wstring_view name = m_pool.Folded(item.name);
+
+    double score;
+    size_t pos = FindFolded(name, foldedQuery);
+    if (pos == 0) {
+        score = 85.0; // Name beginnt mit der Query
+    } else if (pos != std::wstring_view::npos && !IsWordChar(name[pos - 1])) {
+        score = 75.0; // Query beginnt an einer Wortgrenze
+    } else if (pos != std::wstring_view::npos) {
+        score = 65.0; // Query irgendwo im Namen
+    } else {
+        score = 55.0; // Nur die einzelnen Wörter kommen vor
+    }
+
+    // Häufig und kürzlich Ausgeführtes nach vorne
+    score += std::min(10.0, 3.0 * std::log2(1.0 + item.count));
+    score += 5.0 * static_cast<double>(item.lastSequence) / static_cast<double>(m_sequence);
+    return score;
+}
+
+uint64_t HistoryIndex::PrefixKey(std::wstring_view word) {
+    auto unit = [](wchar_t c) { return static_cast<uint64_t>(static_cast<uint32_t>(c) & 0x1FFFFF); };
+    uint64_t key = static_cast<uint64_t>(word.size()) << 62 | unit(word[0]) << 21;
+    if (word.size() > 1) key |= unit(word[1]);
+    return key;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ICommand.h"
+#include "../Search/FoldedTextPool.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct HistoryEntry;
+
+// Inkrementeller Suchindex über den Ausführungsverlauf.
+// Gleiche Einträge (gleicher Name) werden zu einem Item mit Zähler zusammengefasst.
+// Pro Item werden die Trigramme des gefalteten Namens und die ersten ein bis zwei
+// Zeichen jedes Wortes indiziert; IDs wachsen nur, Posting-Listen bleiben also sortiert.
+// Fällt ein Eintrag aus dem Verlauf, sinkt der Zähler; Items ohne Ausführung bleiben
+// als Leiche stehen, bis der Index sie beim nächsten Neuaufbau verwirft.
+class HistoryIndex {
+public:
+    struct Item {
+        FoldedTextPool::Span name;
+        std::wstring description;
+        CommandCategory category = CommandCategory::UNKNOWN;
+        uint32_t count = 0;
+        uint64_t lastSequence = 0;
+    };
+
+    struct Match {
+        uint32_t item;
+        double score;
+    };
+
+    void Add(const HistoryEntry& entry);
+    void Remove(const HistoryEntry& entry);
+    void Clear();
+
+    // Ausführungen eines Namens, O(1)
+    uint32_t CountOf(std::wstring_view name) const;
+
+    // Anzahl der Items mit mindestens einer Ausführung
+    size_t LiveItems() const { return m_items.size() - m_deadItems; }
+
+    const Item& GetItem(uint32_t item) const { return m_items[item]; }
+    std::wstring_view GetName(const Item& item) const { return m_pool.Display(item.name); }
+
+    // Jedes Wort der gefalteten Query muss im Namen vorkommen (Wörter bis zwei Zeichen
+    // als Wortanfang). Liefert höchstens limit Treffer, bester zuerst. Die Puffer wachsen nur
+    // mit dem Verlauf und mit der längsten bisherigen Query, nicht pro Tastendruck.
+    void Search(std::wstring_view foldedQuery, size_t limit, std::vector<Match>& out);
+
+private:
+    static constexpr size_t REBUILD_MIN_DEAD_ITEMS = 1024;
+
+    std::vector<Item> m_items;
+    FoldedTextPool m_pool;
+    std::unordered_map<std::wstring, uint32_t> m_itemByName;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_trigrams;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_wordPrefixes;
+    size_t m_deadItems = 0;
+    uint64_t m_sequence = 0;
+
+    // Wiederverwendete Puffer für den Suchpfad
+    std::vector<std::wstring_view> m_queryWords;
+    std::vector<const std::vector<uint32_t>*> m_lists;
+    std::vector<uint32_t> m_candidates;
+
+    void IndexItem(uint32_t item);
+    void Rebuild();
+    double Score(const Item& item, std::wstring_view foldedQuery) const;
+
+    static uint64_t PrefixKey(std::wstring_view word);
+};
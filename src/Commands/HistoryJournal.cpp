@@ -0,0 +1,245 @@
+#include "HistoryJournal.h"
+
+#include "ExecutionHistory.h"
+#include "../Platform/PlatformServices.h"
+#include "../Storage/Crc32.h"
+#include <cstring>
+#include <system_error>
+
+using namespace std::chrono;
+
+namespace {
+
+const uint32_t kJournalMagic = 0x4A485057; // "WPHJ"
+const uint32_t kJournalVersion = 1;
+const uint32_t kMaxRecordSize = 64 * 1024;
+const size_t kHeaderSize = 3 * sizeof(uint32_t);
+
+template <typename T>
+void AppendValue(std::vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendString(std::vector<char>& buffer, const std::wstring& text) {
+    AppendValue(buffer, static_cast<uint32_t>(text.size()));
+    const char* bytes = reinterpret_cast<const char*>(text.data());
+    buffer.insert(buffer.end(), bytes, bytes + text.size() * sizeof(wchar_t));
+}
+
+// Liest sequenziell aus den Nutzdaten eines Datensatzes; false bei zu kurzen Daten
+class PayloadReader {
+public:
+    PayloadReader(const std::vector<char>& payload) : m_payload(payload) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (m_payload.size() - m_offset < sizeof(T)) return false;
+        std::memcpy(&value, m_payload.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::wstring& text) {
+        uint32_t length = 0;
+        if (!Read(length) || (m_payload.size() - m_offset) / sizeof(wchar_t) < length) return false;
+        text.resize(length);
+        std::memcpy(text.data(), m_payload.data() + m_offset, length * sizeof(wchar_t));
+        m_offset += length * sizeof(wchar_t);
+        return true;
+    }
+
+    bool AtEnd() const { return m_offset == m_payload.size(); }
+
+private:
+    const std::vector<char>& m_payload;
+    size_t m_offset = 0;
+};
+
+// Übergroße Datensätze (z.B. riesige PowerShell-Eingaben) würden beim Laden als beschädigt gelten
+bool IsStorable(const std::vector<char>& record) {
+    return record.size() - 2 * sizeof(uint32_t) <= kMaxRecordSize;
+}
+
+void WriteHeader(std::ofstream& out) {
+    uint32_t header[] = { kJournalMagic, kJournalVersion, static_cast<uint32_t>(sizeof(wchar_t)) };
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+} // namespace
+
+HistoryJournal::HistoryJournal(std::filesystem::path path) : m_path(std::move(path)) {
+}
+
+bool HistoryJournal::Replay(std::vector<HistoryEntry>& entries) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entries.clear();
+    m_fileRecords = 0;
+    m_pending.clear();
+    m_pendingRecords = 0;
+
+    std::ifstream in(m_path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    uint32_t header[3] = {};
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        header[0] != kJournalMagic || header[1] != kJournalVersion || header[2] != sizeof(wchar_t)) {
+        return false;
+    }
+
+    // Bis zum ersten unvollständigen oder beschädigten Datensatz lesen
+    uint64_t validEnd = kHeaderSize;
+    std::vector<char> payload;
+    for (;;) {
+        uint32_t length = 0, crc = 0;
+        if (!in.read(reinterpret_cast<char*>(&length), sizeof(length)) ||
+            !in.read(reinterpret_cast<char*>(&crc), sizeof(crc)) ||
+            length > kMaxRecordSize) {
+            break;
+        }
+        payload.resize(length);
+        if (!in.read(payload.data(), length) || Crc32(payload.data(), length) != crc) {
+            break;
+        }
+
+        PayloadReader reader(payload);
+        int64_t timeMs = 0;
+        int32_t category = 0;
+        HistoryEntry entry;
+        if (!reader.Read(timeMs) || !reader.Read(category) ||
+            !reader.ReadString(entry.commandName) || !reader.ReadString(entry.commandDescription) ||
+            !reader.AtEnd()) {
+            break;
+        }
+        entry.category = static_cast<CommandCategory>(category);
+        entry.executionTime = system_clock::time_point(milliseconds(timeMs));
+        entries.push_back(std::move(entry));
+        ++m_fileRecords;
+        validEnd += sizeof(length) + sizeof(crc) + length;
+    }
+    in.close();
+
+    // Abgerissenen Rest abschneiden, sonst landen neue Datensätze hinter dem Müll
+    std::error_code ec;
+    if (std::filesystem::file_size(m_path, ec) > validEnd && !ec) {
+        std::filesystem::resize_file(m_path, validEnd, ec);
+    }
+    return true;
+}
+
+bool HistoryJournal::Append(const HistoryEntry& entry) {
+    std::vector<char> record = EncodeRecord(entry);
+    if (!IsStorable(record)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.insert(m_pending.end(), record.begin(), record.end());
+    ++m_pendingRecords;
+    return true;
+}
+
+bool HistoryJournal::Flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_pending.empty()) {
+        return true;
+    }
+    if (!m_out.is_open() && !OpenForAppendLocked()) {
+        return false;
+    }
+    m_out.write(m_pending.data(), m_pending.size());
+    m_out.flush();
+    if (!m_out) {
+        // Im Puffer lassen; der nächste Versuch öffnet die Datei neu
+        m_out.close();
+        return false;
+    }
+    m_fileRecords += m_pendingRecords;
+    m_pending.clear();
+    m_pendingRecords = 0;
+    return true;
+}
+
+void HistoryJournal::DiscardPending() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+    m_pendingRecords = 0;
+}
+
+size_t HistoryJournal::RecordCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fileRecords + m_pendingRecords;
+}
+
+bool HistoryJournal::Rewrite(const std::vector<HistoryEntry>& entries) {
+    // Schreiben ohne Lock, damit Appends vom UI-Thread nicht warten
+    std::filesystem::path tempPath = m_path;
+    tempPath += L".tmp";
+    bool written = WriteSnapshot(tempPath, entries);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::error_code ec;
+    if (!written) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    // Unter Windows lässt sich eine geöffnete Datei nicht ersetzen
+    m_out.close();
+    std::filesystem::rename(tempPath, m_path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    m_fileRecords = entries.size();
+    return true;
+}
+
+bool HistoryJournal::WriteSnapshot(const std::filesystem::path& path, const std::vector<HistoryEntry>& entries) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    WriteHeader(out);
+    for (const auto& entry : entries) {
+        std::vector<char> record = EncodeRecord(entry);
+        if (IsStorable(record)) {
+            out.write(record.data(), record.size());
+        }
+    }
+    out.close();
+    // Der Snapshot ersetzt das ganze Journal und muss vor dem Umbenennen auf der Platte sein
+    return !out.fail() && PlatformServices::Instance().FileSystem().SyncFile(path);
+}
+
+bool HistoryJournal::OpenForAppendLocked() {
+    std::error_code ec;
+    bool fresh = !std::filesystem::exists(m_path, ec) || std::filesystem::file_size(m_path, ec) < kHeaderSize;
+
+    m_out.open(m_path, fresh ? (std::ios::binary | std::ios::trunc) : (std::ios::binary | std::ios::app));
+    if (!m_out.is_open()) {
+        return false;
+    }
+    if (fresh) {
+        WriteHeader(m_out);
+        m_out.flush();
+    }
+    return static_cast<bool>(m_out);
+}
+
+std::vector<char> HistoryJournal::EncodeRecord(const HistoryEntry& entry) {
+    // Platz für Länge und CRC vorne freihalten und am Ende füllen
+    std::vector<char> record(2 * sizeof(uint32_t));
+    AppendValue(record, static_cast<int64_t>(duration_cast<milliseconds>(entry.executionTime.time_since_epoch()).count()));
+    AppendValue(record, static_cast<int32_t>(entry.category));
+    AppendString(record, entry.commandName);
+    AppendString(record, entry.commandDescription);
+
+    uint32_t length = static_cast<uint32_t>(record.size() - 2 * sizeof(uint32_t));
+    uint32_t crc = Crc32(record.data() + 2 * sizeof(uint32_t), length);
+    std::memcpy(record.data(), &length, sizeof(length));
+    std::memcpy(record.data() + sizeof(length), &crc, sizeof(crc));
+    return record;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+struct HistoryEntry;
+
+// Append-only Binärjournal für den Ausführungsverlauf.
+// Nach einem Header folgen Datensätze [Länge][CRC-32][Nutzdaten]; eine Ausführung ist
+// ein kleiner Append statt eines Neuschreibens der ganzen Datei.
+// Append puffert nur im Speicher; geschrieben wird mit Flush bzw. Rewrite, die der
+// Besitzer über den PersistenceService auf dessen Hintergrund-Thread ausführt.
+// Rewrite synchronisiert den Snapshot vor dem Umbenennen; angehängte Datensätze werden
+// nicht einzeln synchronisiert, ein abgerissenes Ende fängt die CRC beim Laden ab.
+// Beim Laden gilt alles bis zum ersten unvollständigen oder beschädigten Datensatz
+// (z.B. nach einem Absturz mitten im Schreiben), der Rest wird abgeschnitten.
+class HistoryJournal {
+public:
+    explicit HistoryJournal(std::filesystem::path path);
+
+    HistoryJournal(const HistoryJournal&) = delete;
+    HistoryJournal& operator=(const HistoryJournal&) = delete;
+
+    const std::filesystem::path& GetPath() const { return m_path; }
+
+    // Liest alle gültigen Einträge (älteste zuerst); false, wenn es kein Journal gibt
+    bool Replay(std::vector<HistoryEntry>& entries);
+
+    // Puffert einen Datensatz, ohne Datei-I/O; false bei zu großen Einträgen
+    bool Append(const HistoryEntry& entry);
+
+    // Hängt die gepufferten Datensätze an die Datei an
+    bool Flush();
+
+    // Verwirft die gepufferten Datensätze, weil ein Snapshot für Rewrite sie bereits enthält
+    void DiscardPending();
+
+    // Datensätze im Journal samt gepufferten seit dem Laden bzw. dem letzten Rewrite
+    size_t RecordCount() const;
+
+    // Ersetzt das Journal durch entries (älteste zuerst) über eine temporäre Datei.
+    // Danach gepufferte Datensätze bleiben gepuffert und landen im neuen Journal.
+    bool Rewrite(const std::vector<HistoryEntry>& entries);
+
+private:
+    std::filesystem::path m_path;
+
+    mutable std::mutex m_mutex;
+    std::ofstream m_out;
+    size_t m_fileRecords = 0;
+    std::vector<char> m_pending;
+    size_t m_pendingRecords = 0;
+
+    bool WriteSnapshot(const std::filesystem::path& path, const std::vector<HistoryEntry>& entries) const;
+    bool OpenForAppendLocked();
+
+    static std::vector<char> EncodeRecord(const HistoryEntry& entry);
+};
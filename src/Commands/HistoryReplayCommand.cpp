@@ -0,0 +1,51 @@
+#include "HistoryReplayCommand.h"
+
+#include "../Platform/PlatformServices.h"
+
+namespace {
+
+const std::wstring_view kPowerShellPrefix = L"PowerShell: ";
+const std::wstring_view kLaunchPrefix = L"Launch ";
+
+bool StartsWith(std::wstring_view text, std::wstring_view prefix) {
+    return text.size() > prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+HistoryReplayCommand::HistoryReplayCommand(const std::wstring& name, const std::wstring& description,
+                                           CommandCategory category, uint32_t executionCount)
+    : m_name(name), m_description(description), m_category(category), m_executionCount(executionCount) {
+}
+
+bool HistoryReplayCommand::IsReplayable(std::wstring_view name) {
+    return StartsWith(name, kPowerShellPrefix) || StartsWith(name, kLaunchPrefix);
+}
+
+std::wstring HistoryReplayCommand::GetName() const {
+    return m_name;
+}
+
+std::wstring HistoryReplayCommand::GetDescription() const {
+    if (m_executionCount > 1) {
+        return m_description + L" (" + std::to_wstring(m_executionCount) + L"x ausgeführt)";
+    }
+    return m_description;
+}
+
+CommandCategory HistoryReplayCommand::GetCategory() const {
+    return m_category;
+}
+
+void HistoryReplayCommand::Execute() {
+    ILauncher& launcher = PlatformServices::Instance().Launcher();
+    std::wstring_view name = m_name;
+
+    if (StartsWith(name, kPowerShellPrefix)) {
+        // Wie der PowerShell-Fallback im Eingabefeld
+        launcher.Open(L"powershell.exe", std::wstring(name.substr(kPowerShellPrefix.size())));
+    } else if (StartsWith(name, kLaunchPrefix)) {
+        // Wie ExecuteLaunchCommand: direkt über die Shell starten
+        launcher.Open(std::wstring(name.substr(kLaunchPrefix.size())));
+    }
+}
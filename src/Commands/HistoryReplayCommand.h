@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ICommand.h"
+#include <cstdint>
+#include <string_view>
+
+// Treffer der Verlaufssuche ohne registrierten Command: führt eine frühere
+// PowerShell-Eingabe ("PowerShell: …") oder einen Direktstart ("Launch …") erneut aus.
+// Den Verlaufseintrag schreibt wie bei jedem Treffer CommandManager::ExecuteCommand.
+class HistoryReplayCommand : public ICommand {
+public:
+    HistoryReplayCommand(const std::wstring& name, const std::wstring& description,
+                         CommandCategory category, uint32_t executionCount);
+
+    // Nur Einträge mit diesen Präfixen lassen sich ohne Rückfrage wiederholen
+    static bool IsReplayable(std::wstring_view name);
+
+    std::wstring GetName() const override;
+    std::wstring GetDescription() const override;
+    CommandCategory GetCategory() const override;
+    void Execute() override;
+
+private:
+    std::wstring m_name;
+    std::wstring m_description;
+    CommandCategory m_category;
+    uint32_t m_executionCount;
+};
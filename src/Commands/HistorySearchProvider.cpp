@@ -0,0 +1,28 @@
+#include "HistorySearchProvider.h"
+#include "HistoryReplayCommand.h"
+#include "../Search/TextFolding.h"
+
+HistorySearchProvider::HistorySearchProvider(CommandManager& commandManager)
+    : m_commandManager(commandManager) {
+}
+
+void HistorySearchProvider::Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) {
+    size_t start = query.find_first_not_of(L' ');
+    if (start == std::wstring::npos) return;
+    size_t end = query.find_last_not_of(L' ');
+    FoldInto(std::wstring_view(query).substr(start, end - start + 1), m_foldedQuery);
+
+    // Sucht unter dem Lock der History, der Index beantwortet das ohne Scan
+    m_commandManager.GetExecutionHistory().Search(m_foldedQuery, MAX_HISTORY_RESULTS, m_matches);
+    if (token.IsCancelled()) return;
+
+    for (const auto& match : m_matches) {
+        if (ICommand* command = m_commandManager.FindCommandByName(match.commandName)) {
+            hits.push_back({ std::shared_ptr<ICommand>(std::shared_ptr<ICommand>(), command), match.score });
+        } else if (HistoryReplayCommand::IsReplayable(match.commandName)) {
+            hits.push_back({ std::make_shared<HistoryReplayCommand>(match.commandName, match.commandDescription,
+                                                                    match.category, match.executionCount),
+                             match.score });
+        }
+    }
+}
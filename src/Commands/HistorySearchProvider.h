@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../Search/SearchScheduler.h"
+#include "CommandManager.h"
+
+// Durchsucht den gesamten Ausführungsverlauf über dessen HistoryIndex (Wortanfänge und
+// Trigramme, gleiche Einträge mit Zähler zusammengefasst). Steht hinter einem Eintrag ein
+// registrierter Command, wird dieser geliefert; frühere PowerShell-Eingaben und
+// Direktstarts kommen als HistoryReplayCommand. Beim Zusammenführen gewinnt der
+// höhere Score aus Command- und History-Suche.
+class HistorySearchProvider : public ISearchProvider {
+public:
+    explicit HistorySearchProvider(CommandManager& commandManager);
+
+    void Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) override;
+
+private:
+    static constexpr size_t MAX_HISTORY_RESULTS = 6;
+
+    CommandManager& m_commandManager;
+    std::wstring m_foldedQuery;
+    std::vector<HistorySearchMatch> m_matches;
+};
@@ -0,0 +1,228 @@
+#include "SelectionModel.h"
+
+#include "../Platform/PlatformServices.h"
+#include "../Search/TextFolding.h"
+#include "../Storage/PersistenceService.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+
+double SelectionModel::Choices::Affinity(CommandId id) const {
+    for (uint32_t i = 0; i < size; ++i) {
+        if (items[i].id == id) {
+            double share = static_cast<double>(items[i].count) / total;
+            double confidence = static_cast<double>(items[i].count) / (items[i].count + 1.0);
+            return share * confidence;
+        }
+    }
+    return 0.0;
+}
+
+SelectionModel::SelectionModel() : m_filePath(GetFilePath()), m_persistence(PersistenceService::Instance()) {
+    m_nodes.emplace_back();
+    Load();
+}
+
+SelectionModel::~SelectionModel() {
+    m_persistence.Flush(m_filePath);
+}
+
+void SelectionModel::RecordSelection(std::wstring_view query, CommandId id) {
+    std::wstring folded = FoldText(Trim(query));
+    if (folded.empty()) return;
+    if (folded.size() > MAX_PREFIX_LENGTH) folded.resize(MAX_PREFIX_LENGTH);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_tick;
+
+    // Jedes Präfix der Query lernt die Auswahl mit, damit sie schon nach dem ersten Zeichen greift
+    uint32_t node = 0;
+    m_nodes[0].lastUse = m_tick;
+    for (wchar_t ch : folded) {
+        uint32_t child = FindChild(node, ch);
+        if (child == NO_NODE) child = AddChild(node, ch);
+        node = child;
+        m_nodes[node].lastUse = m_tick;
+        CountChoice(m_nodes[node].choices, id);
+    }
+
+    if (m_nodes.size() > MAX_NODES) {
+        PruneLocked();
+    }
+    ScheduleSave();
+}
+
+bool SelectionModel::Lookup(std::wstring_view foldedQuery, Choices& out) const {
+    std::wstring_view query = Trim(foldedQuery);
+    if (query.empty()) return false;
+    if (query.size() > MAX_PREFIX_LENGTH) query = query.substr(0, MAX_PREFIX_LENGTH);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t node = 0;
+    for (wchar_t ch : query) {
+        node = FindChild(node, ch);
+        if (node == NO_NODE) return false;
+    }
+    out = m_nodes[node].choices;
+    return !out.Empty();
+}
+
+void SelectionModel::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_nodes.clear();
+    m_nodes.emplace_back();
+    m_tick = 0;
+    ScheduleSave();
+}
+
+uint32_t SelectionModel::FindChild(uint32_t node, wchar_t ch) const {
+    for (uint32_t child = m_nodes[node].firstChild; child != NO_NODE; child = m_nodes[child].nextSibling) {
+        if (m_nodes[child].ch == ch) return child;
+    }
+    return NO_NODE;
+}
+
+uint32_t SelectionModel::AddChild(uint32_t node, wchar_t ch) {
+    uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    Node child;
+    child.ch = ch;
+    child.parent = node;
+    child.nextSibling = m_nodes[node].firstChild;
+    m_nodes.push_back(child);
+    m_nodes[node].firstChild = index;
+    return index;
+}
+
+void SelectionModel::CountChoice(Choices& choices, CommandId id) {
+    Choice* slot = nullptr;
+    for (uint32_t i = 0; i < choices.size; ++i) {
+        if (choices.items[i].id == id) slot = &choices.items[i];
+    }
+    if (slot == nullptr) {
+        if (choices.size < MAX_CHOICES) {
+            slot = &choices.items[choices.size++];
+        } else {
+            // Voll: der seltenste Command macht Platz
+            slot = std::min_element(choices.items, choices.items + MAX_CHOICES,
+                                    [](const Choice& a, const Choice& b) { return a.count < b.count; });
+            choices.total -= slot->count;
+        }
+        slot->id = id;
+        slot->count = 0;
+    }
+    ++slot->count;
+    ++choices.total;
+
+    // Zähler halbieren, damit neue Gewohnheiten alte irgendwann überholen
+    if (choices.total > MAX_COUNT_TOTAL) {
+        uint32_t kept = 0;
+        choices.total = 0;
+        for (uint32_t i = 0; i < choices.size; ++i) {
+            Choice halved = { choices.items[i].id, choices.items[i].count / 2 };
+            if (halved.count > 0) {
+                choices.items[kept++] = halved;
+                choices.total += halved.count;
+            }
+        }
+        choices.size = kept;
+    }
+}
+
+void SelectionModel::PruneLocked() {
+    // Auf drei Viertel kürzen. Ein Elternknoten ist nie älter als seine Kinder,
+    // daher fallen immer ganze Zweige weg und der Rest bleibt zusammenhängend.
+    std::vector<uint64_t> ages;
+    ages.reserve(m_nodes.size());
+    for (size_t i = 1; i < m_nodes.size(); ++i) ages.push_back(m_nodes[i].lastUse);
+    size_t keep = MAX_NODES * 3 / 4;
+    std::nth_element(ages.begin(), ages.begin() + keep, ages.end(), std::greater<uint64_t>());
+    uint64_t cutoff = ages[keep];
+
+    std::vector<uint32_t> remap(m_nodes.size(), NO_NODE);
+    std::vector<Node> kept;
+    kept.reserve(keep + 1);
+    remap[0] = 0;
+    kept.push_back(m_nodes[0]);
+    for (size_t i = 1; i < m_nodes.size(); ++i) {
+        const Node& node = m_nodes[i];
+        if (node.lastUse <= cutoff || remap[node.parent] == NO_NODE) continue;
+        remap[i] = static_cast<uint32_t>(kept.size());
+        kept.push_back(node);
+        kept.back().parent = remap[node.parent];
+    }
+
+    // Geschwisterlisten neu verketten
+    for (auto& node : kept) {
+        node.firstChild = NO_NODE;
+        node.nextSibling = NO_NODE;
+    }
+    for (uint32_t i = 1; i < kept.size(); ++i) {
+        kept[i].nextSibling = kept[kept[i].parent].firstChild;
+        kept[kept[i].parent].firstChild = i;
+    }
+    m_nodes = std::move(kept);
+}
+
+// --- Persistence helpers ---
+
+void SelectionModel::ScheduleSave() {
+    m_persistence.ScheduleWrite(m_filePath, [this]() { return Serialize(); });
+}
+
+std::string SelectionModel::Serialize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Eine Zeile pro Knoten (ohne Wurzel): parent ch lastUse n {id count}
+    std::ostringstream file;
+    for (size_t i = 1; i < m_nodes.size(); ++i) {
+        const Node& node = m_nodes[i];
+        file << node.parent << ' ' << static_cast<uint32_t>(node.ch) << ' ' << node.lastUse << ' ' << node.choices.size;
+        for (uint32_t c = 0; c < node.choices.size; ++c) {
+            file << ' ' << node.choices.items[c].id << ' ' << node.choices.items[c].count;
+        }
+        file << '\n';
+    }
+    return file.str();
+}
+
+void SelectionModel::Load() {
+    std::ifstream file(m_filePath);
+    if (!file.is_open()) return;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        uint32_t parent, ch, size;
+        uint64_t lastUse;
+        // Eltern müssen bereits geladen sein; ab einer beschädigten Zeile stimmen die Indizes nicht mehr
+        if (!(fields >> parent >> ch >> lastUse >> size)) break;
+        if (parent >= m_nodes.size() || size > MAX_CHOICES || m_nodes.size() >= MAX_NODES) break;
+
+        Choices choices;
+        bool valid = true;
+        for (uint32_t c = 0; c < size && valid; ++c) {
+            valid = static_cast<bool>(fields >> choices.items[c].id >> choices.items[c].count);
+            choices.total += choices.items[c].count;
+        }
+        if (!valid) break;
+        choices.size = size;
+
+        uint32_t index = AddChild(parent, static_cast<wchar_t>(ch));
+        m_nodes[index].lastUse = lastUse;
+        m_nodes[index].choices = choices;
+        m_tick = std::max(m_tick, lastUse);
+    }
+}
+
+std::filesystem::path SelectionModel::GetFilePath() const {
+    return PlatformServices::Instance().FileSystem().GetDataDirectory() / "selections.txt";
+}
+
+std::wstring_view SelectionModel::Trim(std::wstring_view text) {
+    size_t start = text.find_first_not_of(L' ');
+    if (start == std::wstring_view::npos) return std::wstring_view();
+    size_t end = text.find_last_not_of(L' ');
+    return text.substr(start, end - start + 1);
+}
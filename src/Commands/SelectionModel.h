@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class PersistenceService;
+
+// Lernt, welchen Treffer der Nutzer bei einer Eingabe gewählt hat ("nt" -> Notepad).
+// Jede Auswahl zählt für alle Präfixe der gefalteten Query; pro Trie-Knoten werden
+// die häufigsten Commands (Schlüssel wie FrecencyStore::MakeId) mit Zählern gehalten.
+// Der Trie ist auf MAX_NODES begrenzt, zuletzt ungenutzte Zweige fallen zuerst weg.
+// Gespeichert in selections.txt, gebündelt über den PersistenceService.
+class SelectionModel {
+public:
+    using CommandId = uint64_t;
+
+    static constexpr size_t MAX_CHOICES = 4;
+    static constexpr size_t MAX_PREFIX_LENGTH = 24;
+    static constexpr size_t MAX_NODES = 4096;
+
+    // Obergrenze des Bonus, den ein Ranking für die gewohnte Wahl addiert
+    static constexpr double BOOST_WEIGHT = 60.0;
+
+    struct Choice {
+        CommandId id = 0;
+        uint32_t count = 0;
+    };
+
+    // Auswahl-Statistik eines Präfixes; feste Größe, damit Lookups nichts allokieren
+    struct Choices {
+        Choice items[MAX_CHOICES];
+        uint32_t size = 0;
+        uint32_t total = 0;
+
+        bool Empty() const { return size == 0; }
+
+        // 0..1: Anteil dieses Commands an den Auswahlen, gedämpft bei wenigen Beobachtungen
+        // (eine Auswahl 0.5, zwei 0.67, ...)
+        double Affinity(CommandId id) const;
+    };
+
+    SelectionModel();
+    ~SelectionModel();
+
+    SelectionModel(const SelectionModel&) = delete;
+    SelectionModel& operator=(const SelectionModel&) = delete;
+
+    // Vermerkt, dass bei dieser (ungefalteten) Query der Command gewählt wurde; gespeichert wird verzögert
+    void RecordSelection(std::wstring_view query, CommandId id);
+
+    // Statistik für eine bereits gefaltete Query; false, wenn nichts gelernt wurde. Thread-sicher.
+    bool Lookup(std::wstring_view foldedQuery, Choices& out) const;
+
+    void Clear();
+
+private:
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+    static constexpr uint32_t MAX_COUNT_TOTAL = 1024;
+
+    // Knoten liegen in einem Vektor; Eltern stehen immer vor ihren Kindern
+    struct Node {
+        wchar_t ch = 0;
+        uint32_t parent = NO_NODE;
+        uint32_t firstChild = NO_NODE;
+        uint32_t nextSibling = NO_NODE;
+        uint64_t lastUse = 0; // Zähler m_tick der letzten Auswahl durch diesen Knoten
+        Choices choices;
+    };
+
+    // Schreibzugriffe vom UI-Thread, Lookups von den Such-Workern
+    mutable std::mutex m_mutex;
+    std::vector<Node> m_nodes; // [0] ist die Wurzel
+    uint64_t m_tick = 0;
+    std::filesystem::path m_filePath;
+    PersistenceService& m_persistence;
+
+    uint32_t FindChild(uint32_t node, wchar_t ch) const;
+    uint32_t AddChild(uint32_t node, wchar_t ch);
+    static void CountChoice(Choices& choices, CommandId id);
+    void PruneLocked();
+    void ScheduleSave();
+    std::string Serialize() const;
+    void Load();
+    std::filesystem::path GetFilePath() const;
+
+    static std::wstring_view Trim(std::wstring_view text);
+};
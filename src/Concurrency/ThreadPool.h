@@ -0,0 +1,32 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Einfacher Thread-Pool mit gemeinsamer FIFO-Warteschlange.
+// Der Destruktor lässt laufende Aufgaben zu Ende laufen und verwirft noch
+// nicht gestartete; Aufgaben müssen also selbst auf Abbruch achten.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Enqueue(std::function<void()> task);
+    size_t ThreadCount() const { return m_threads.size(); }
+
+private:
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+
+    void WorkerLoop();
+};
@@ -0,0 +1,111 @@
+#include "WorkStealingPool.h"
+
+namespace {
+
+// Zu welchem Pool und welcher Schlange der aktuelle Thread gehört
+thread_local const WorkStealingPool* t_pool = nullptr;
+thread_local size_t t_queue = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    m_queues.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkStealingPool::Submit(std::function<void()> task) {
+    size_t index = t_pool == this ? t_queue : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+    // Zähler vor dem Einstellen erhöhen, damit ein schneller Worker sie nie unterläuft;
+    // m_queued unter dem Schlaf-Lock, sonst kann ein Worker das Wecken verpassen
+    m_unfinished.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queued.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+void WorkStealingPool::Wait() {
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_idle.wait(lock, [this]() { return m_unfinished.load() == 0; });
+}
+
+bool WorkStealingPool::TryTake(size_t index, std::function<void()>& task) {
+    // Eigene Schlange von hinten: zuletzt erzeugte Aufgabe, Daten noch warm
+    {
+        WorkerQueue& own = *m_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Fremde Schlangen von vorne: die ältesten Aufgaben
+    for (size_t offset = 1; offset < m_queues.size(); ++offset) {
+        WorkerQueue& victim = *m_queues[(index + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::WorkerLoop(size_t index) {
+    t_pool = this;
+    t_queue = index;
+
+    for (;;) {
+        std::function<void()> task;
+        if (TryTake(index, task)) {
+            m_queued.fetch_sub(1);
+            try {
+                task();
+            } catch (...) {
+                // Eine fehlerhafte Aufgabe darf den Worker nicht beenden
+            }
+            task = nullptr;
+
+            if (m_unfinished.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return m_stopping || m_queued.load() > 0; });
+        if (m_stopping) return;
+    }
+}
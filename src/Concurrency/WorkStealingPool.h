@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread-Pool mit einer Warteschlange pro Worker für Aufgaben, die weitere Aufgaben erzeugen
+// (z. B. ein Verzeichnis-Durchlauf, der pro Unterverzeichnis eine Aufgabe einstellt).
+// Submit von einem Worker aus legt in dessen eigene Schlange, die er von hinten (LIFO)
+// abarbeitet; ein Worker ohne Arbeit stiehlt vom Anfang fremder Schlangen, also die ältesten
+// und meist größten Teilbäume. Submit von außen verteilt reihum.
+// Wait blockiert, bis alle eingestellten Aufgaben samt ihrer Nachfolger fertig sind.
+// Der Destruktor lässt laufende Aufgaben zu Ende laufen und verwirft noch nicht gestartete.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t threadCount);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void Submit(std::function<void()> task);
+    void Wait();
+    size_t ThreadCount() const { return m_threads.size(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    // Eingestellt, aber noch nicht beendet (für Wait) bzw. noch nicht entnommen (für Schlafen)
+    std::atomic<size_t> m_unfinished{ 0 };
+    std::atomic<size_t> m_queued{ 0 };
+    std::atomic<size_t> m_nextQueue{ 0 };
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    bool m_stopping = false;
+
+    void WorkerLoop(size_t index);
+    bool TryTake(size_t index, std::function<void()>& task);
+};
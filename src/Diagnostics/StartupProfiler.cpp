@@ -0,0 +1,66 @@
+#include "StartupProfiler.h"
+
+#include <cwchar>
+
+using namespace std::chrono;
+
+StartupProfiler::Phase::Phase(std::wstring name)
+    : m_name(std::move(name)) {
+    // Profiler zuerst anlegen, damit sein Nullpunkt nicht nach dieser Phase liegt
+    StartupProfiler::Instance();
+    m_start = steady_clock::now();
+}
+
+StartupProfiler::Phase::~Phase() {
+    End();
+}
+
+void StartupProfiler::Phase::End() {
+    if (m_ended) return;
+    m_ended = true;
+    StartupProfiler::Instance().Finish(std::move(m_name), m_start, steady_clock::now());
+}
+
+StartupProfiler& StartupProfiler::Instance() {
+    static StartupProfiler instance;
+    return instance;
+}
+
+StartupProfiler::StartupProfiler()
+    : m_origin(steady_clock::now()) {
+}
+
+void StartupProfiler::SetOutput(Output output) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_output = std::move(output);
+    if (!m_output) return;
+    for (const Record& record : m_records) {
+        m_output(Format(record));
+    }
+}
+
+std::vector<StartupProfiler::Record> StartupProfiler::GetRecords() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_records;
+}
+
+void StartupProfiler::Finish(std::wstring name, steady_clock::time_point start, steady_clock::time_point end) {
+    Record record;
+    record.name = std::move(name);
+    record.startMs = duration<double, std::milli>(start - m_origin).count();
+    record.durationMs = duration<double, std::milli>(end - start).count();
+
+    // Unter dem Lock ausgeben, damit die Zeilen in Abschlussreihenfolge erscheinen
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.push_back(record);
+    if (m_output) {
+        m_output(Format(record));
+    }
+}
+
+std::wstring StartupProfiler::Format(const Record& record) {
+    wchar_t line[160];
+    std::swprintf(line, sizeof(line) / sizeof(line[0]), L"[startup] %-24ls %9.1f ms  (at %9.1f ms)\n",
+                  record.name.c_str(), record.durationMs, record.startMs);
+    return line;
+}
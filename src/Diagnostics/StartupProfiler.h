@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Misst die Phasen des Starts (Plugins, Katalog aus dem Cache, Nachprüfen im Hintergrund …).
+// Jede beendete Phase wird mit Beginn relativ zum Start des Profilers und Dauer als Zeile
+// an die Ausgabe gemeldet, die die Anwendung setzt (Win32: Debug-Ausgabe). Was vor dem
+// Setzen der Ausgabe endet, wird gepuffert und dann nachgereicht. Thread-sicher.
+class StartupProfiler {
+public:
+    using Output = std::function<void(const std::wstring& line)>;
+
+    struct Record {
+        std::wstring name;
+        double startMs;
+        double durationMs;
+    };
+
+    // Misst vom Konstruktor bis End() bzw. zum Destruktor
+    class Phase {
+    public:
+        explicit Phase(std::wstring name);
+        ~Phase();
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+        void End();
+
+    private:
+        std::wstring m_name;
+        std::chrono::steady_clock::time_point m_start;
+        bool m_ended = false;
+    };
+
+    static StartupProfiler& Instance();
+
+    void SetOutput(Output output);
+    std::vector<Record> GetRecords() const;
+
+private:
+    StartupProfiler();
+
+    mutable std::mutex m_mutex;
+    std::chrono::steady_clock::time_point m_origin;
+    std::vector<Record> m_records;
+    Output m_output;
+
+    void Finish(std::wstring name, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end);
+    static std::wstring Format(const Record& record);
+};
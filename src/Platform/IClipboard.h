@@ -0,0 +1,10 @@
+#pragma once
+
+// Zwischenablage des Systems
+class IClipboard {
+public:
+    virtual ~IClipboard() = default;
+
+    // false, wenn die Zwischenablage nicht geöffnet werden konnte
+    virtual bool Clear() = 0;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <chrono>
+
+// Zeitquelle für Verlauf und Zeitmessungen; Tests können sie durch eine feste Uhr ersetzen
+class IClock {
+public:
+    virtual ~IClock() = default;
+
+    // Wanduhr, z.B. für Zeitstempel im Verlauf
+    virtual std::chrono::system_clock::time_point Now() const = 0;
+
+    // Monotone Uhr für Dauern und Timeouts
+    virtual std::chrono::steady_clock::time_point Monotonic() const = 0;
+};
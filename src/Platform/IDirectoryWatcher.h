@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+// Eine gemeldete Änderung unterhalb einer beobachteten Wurzel
+struct DirectoryChange {
+    enum class Action {
+        Added,
+        Removed,
+        Modified,
+        RenamedFrom,
+        RenamedTo,
+        // Ereignisse gingen verloren (Puffer übergelaufen); path ist dann die Wurzel,
+        // und alles darunter kann sich geändert haben
+        Overflow,
+        // Wie Overflow, aber die Beobachtung ist dauerhaft beendet (Wurzel verschwunden oder
+        // nicht mehr lesbar); danach kommt für sie keine Meldung mehr
+        Stopped
+    };
+
+    Action action = Action::Modified;
+    std::filesystem::path path;  // vollständiger Pfad des Eintrags
+};
+
+// Beobachtet Verzeichnisse auf angelegte, gelöschte, umbenannte und geschriebene Einträge
+// (ReadDirectoryChangesW unter Windows, inotify unter Linux). Die Rückrufe kommen roh und
+// ungebündelt auf einem Thread der Implementierung; Zusammenfassen ist Sache des Aufrufers.
+class IDirectoryWatcher {
+public:
+    using WatchId = uint64_t;
+    using Callback = std::function<void(const std::vector<DirectoryChange>& changes)>;
+
+    virtual ~IDirectoryWatcher() = default;
+
+    // 0, wenn root nicht beobachtet werden kann (fehlt, nicht unterstützt)
+    virtual WatchId Watch(const std::filesystem::path& root, bool recursive, Callback callback) = 0;
+
+    // Nach der Rückkehr läuft kein Rückruf dieser Beobachtung mehr, außer Unwatch
+    // wird aus dem Rückruf selbst aufgerufen
+    virtual void Unwatch(WatchId id) = 0;
+};
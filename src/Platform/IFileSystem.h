@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+// Schreibgeschützt eingeblendete Datei; Data() bleibt bis zur Zerstörung gültig
+class IMappedFile {
+public:
+    virtual ~IMappedFile() = default;
+
+    virtual const char* Data() const = 0;
+    virtual size_t Size() const = 0;
+};
+
+// Ablageorte von WinPal. Beide Verzeichnisse werden bei Bedarf angelegt.
+class IFileSystem {
+public:
+    virtual ~IFileSystem() = default;
+
+    // Verlauf und Einstellungen (unter Windows %APPDATA%\WinPal)
+    virtual std::filesystem::path GetDataDirectory() = 0;
+
+    // Neu erzeugbare Daten wie der Anwendungs-Cache (unter Windows %LOCALAPPDATA%\WinPal)
+    virtual std::filesystem::path GetCacheDirectory() = 0;
+
+    // Blendet eine Datei schreibgeschützt ein; nullptr, wenn sie fehlt oder leer ist.
+    // Die Vorgabe liest die Datei komplett in den Speicher, Plattformen nutzen echtes Mapping.
+    virtual std::unique_ptr<IMappedFile> MapReadOnly(const std::filesystem::path& path);
+
+    // Bringt den Inhalt einer geschriebenen und geschlossenen Datei auf den Datenträger,
+    // bevor sie per Umbenennen eine andere ersetzt; false, wenn das nicht gelingt.
+    // Die Vorgabe hat keinen Zugriff darauf und meldet Erfolg.
+    virtual bool SyncFile(const std::filesystem::path& path);
+};
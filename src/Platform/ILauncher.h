@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// Startet Programme, Dateien und URIs (ms-settings:, shell:Downloads, ...) wie ein Doppelklick
+class ILauncher {
+public:
+    virtual ~ILauncher() = default;
+
+    // false, wenn das System das Ziel nicht öffnen konnte
+    virtual bool Open(const std::wstring& target, const std::wstring& arguments = L"") = 0;
+};
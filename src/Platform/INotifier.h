@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// Rückmeldungen an den Benutzer (MessageBox unter Windows, stderr unter Linux)
+class INotifier {
+public:
+    virtual ~INotifier() = default;
+
+    virtual void ShowInfo(const std::wstring& title, const std::wstring& message) = 0;
+    virtual void ShowError(const std::wstring& title, const std::wstring& message) = 0;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ProcessEntry {
+    uint32_t processId;
+    std::wstring exeName;
+    uint32_t parentProcessId = 0;
+    // Startzeitpunkt in einer plattformabhängigen Einheit, nur zum Vergleichen (0 = unbekannt).
+    // Zusammen mit der Prozess-ID eindeutig, auch wenn eine ID wiederverwendet wird.
+    uint64_t startTime = 0;
+};
+
+// Zugriff auf die laufenden Prozesse (Toolhelp unter Windows, /proc unter Linux)
+class IProcessEnumerator {
+public:
+    virtual ~IProcessEnumerator() = default;
+
+    // Ersetzt den Inhalt von processes; false, wenn keine Momentaufnahme möglich war
+    virtual bool Enumerate(std::vector<ProcessEntry>& processes) = 0;
+
+    // false, wenn der Prozess nicht (mehr) existiert oder der Zugriff verweigert wurde
+    virtual bool Terminate(uint32_t processId) = 0;
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "../PlatformServices.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Header-only Attrappen für Headless-Harnesses und Benchmarks.
+// Installation z.B. über PlatformServices::Instance().SetLauncher(std::make_unique<MockLauncher>()).
+
+// Merkt sich alle Aufrufe statt etwas zu starten
+class MockLauncher : public ILauncher {
+public:
+    bool Open(const std::wstring& target, const std::wstring& arguments = L"") override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_opened.emplace_back(target, arguments);
+        return m_succeed;
+    }
+
+    void SetSucceed(bool succeed) { m_succeed = succeed; }
+
+    std::vector<std::pair<std::wstring, std::wstring>> Opened() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_opened;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::pair<std::wstring, std::wstring>> m_opened;
+    bool m_succeed = true;
+};
+
+// Feste Prozessliste; Terminate entfernt den Eintrag
+class MockProcessEnumerator : public IProcessEnumerator {
+public:
+    void AddProcess(uint32_t processId, const std::wstring& exeName, uint32_t parentProcessId = 0, uint64_t startTime = 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_processes.push_back({ processId, exeName, parentProcessId, startTime });
+    }
+
+    bool Enumerate(std::vector<ProcessEntry>& processes) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        processes = m_processes;
+        return true;
+    }
+
+    bool Terminate(uint32_t processId) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_processes.begin(), m_processes.end(),
+                               [processId](const ProcessEntry& entry) { return entry.processId == processId; });
+        if (it == m_processes.end()) return false;
+        m_processes.erase(it);
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<ProcessEntry> m_processes;
+};
+
+// Alle Daten unter einem frei wählbaren (z.B. temporären) Verzeichnis
+class MockFileSystem : public IFileSystem {
+public:
+    explicit MockFileSystem(std::filesystem::path root) : m_root(std::move(root)) {}
+
+    std::filesystem::path GetDataDirectory() override { return Ensure(m_root / "data"); }
+    std::filesystem::path GetCacheDirectory() override { return Ensure(m_root / "cache"); }
+
+    // Merkt sich die Dateien; mit SetSyncSucceed(false) scheitert das Schreiben wie bei voller Platte
+    bool SyncFile(const std::filesystem::path& path) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_synced.push_back(path);
+        return m_syncSucceed;
+    }
+
+    void SetSyncSucceed(bool succeed) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_syncSucceed = succeed;
+    }
+
+    std::vector<std::filesystem::path> Synced() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_synced;
+    }
+
+private:
+    std::filesystem::path m_root;
+    mutable std::mutex m_mutex;
+    std::vector<std::filesystem::path> m_synced;
+    bool m_syncSucceed = true;
+
+    static std::filesystem::path Ensure(const std::filesystem::path& path) {
+        std::error_code ec;
+        std::filesystem::create_directories(path, ec);
+        return path;
+    }
+};
+
+// Uhr, die nur auf Anweisung weiterläuft
+class ManualClock : public IClock {
+public:
+    std::chrono::system_clock::time_point Now() const override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_now;
+    }
+
+    std::chrono::steady_clock::time_point Monotonic() const override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_monotonic;
+    }
+
+    void Advance(std::chrono::nanoseconds duration) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_now += std::chrono::duration_cast<std::chrono::system_clock::duration>(duration);
+        m_monotonic += std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration);
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::chrono::system_clock::time_point m_now{ std::chrono::hours(24 * 365 * 50) };
+    std::chrono::steady_clock::time_point m_monotonic{};
+};
+
+// Sammelt Meldungen statt sie anzuzeigen
+class MockNotifier : public INotifier {
+public:
+    void ShowInfo(const std::wstring& title, const std::wstring& message) override { Record(title, message); }
+    void ShowError(const std::wstring& title, const std::wstring& message) override { Record(title, message); }
+
+    std::vector<std::pair<std::wstring, std::wstring>> Messages() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_messages;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::pair<std::wstring, std::wstring>> m_messages;
+
+    void Record(const std::wstring& title, const std::wstring& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_messages.emplace_back(title, message);
+    }
+};
+
+// Zählt Clear; mit SetSucceed(false) ist die Zwischenablage belegt
+class MockClipboard : public IClipboard {
+public:
+    bool Clear() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_clears;
+        return m_succeed;
+    }
+
+    void SetSucceed(bool succeed) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_succeed = succeed;
+    }
+
+    size_t Clears() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_clears;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    size_t m_clears = 0;
+    bool m_succeed = true;
+};
+
+// Meldet Änderungen nur auf Anweisung über Emit, synchron auf dem aufrufenden Thread
+class MockDirectoryWatcher : public IDirectoryWatcher {
+public:
+    WatchId Watch(const std::filesystem::path& root, bool, Callback callback) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        WatchId id = m_nextId++;
+        m_watches[id] = { root, std::move(callback) };
+        return id;
+    }
+
+    void Unwatch(WatchId id) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_watches.erase(id);
+    }
+
+    // Stellt changes allen Beobachtungen zu, deren Wurzel den ersten Pfad enthält
+    void Emit(const std::vector<DirectoryChange>& changes) {
+        if (changes.empty()) return;
+        std::vector<Callback> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& [id, watch] : m_watches) {
+                std::filesystem::path relative = changes.front().path.lexically_relative(watch.first);
+                if (!relative.empty() && *relative.begin() != "..") {
+                    callbacks.push_back(watch.second);
+                }
+            }
+        }
+        for (const Callback& callback : callbacks) {
+            callback(changes);
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::map<WatchId, std::pair<std::filesystem::path, Callback>> m_watches;
+    WatchId m_nextId = 1;
+};
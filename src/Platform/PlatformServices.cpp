@@ -0,0 +1,45 @@
+#include "PlatformServices.h"
+#include "PortableServices.h"
+
+PlatformServices& PlatformServices::Instance() {
+    static PlatformServices instance;
+    return instance;
+}
+
+PlatformServices::PlatformServices()
+    : m_launcher(std::make_unique<NullLauncher>()),
+      m_processes(std::make_unique<NullProcessEnumerator>()),
+      m_fileSystem(std::make_unique<EnvironmentFileSystem>()),
+      m_clock(std::make_unique<SystemClock>()),
+      m_notifier(std::make_unique<NullNotifier>()),
+      m_directoryWatcher(std::make_unique<NullDirectoryWatcher>()),
+      m_clipboard(std::make_unique<NullClipboard>()) {
+}
+
+void PlatformServices::SetLauncher(std::unique_ptr<ILauncher> launcher) {
+    if (launcher) m_launcher = std::move(launcher);
+}
+
+void PlatformServices::SetProcessEnumerator(std::unique_ptr<IProcessEnumerator> processes) {
+    if (processes) m_processes = std::move(processes);
+}
+
+void PlatformServices::SetFileSystem(std::unique_ptr<IFileSystem> fileSystem) {
+    if (fileSystem) m_fileSystem = std::move(fileSystem);
+}
+
+void PlatformServices::SetClock(std::unique_ptr<IClock> clock) {
+    if (clock) m_clock = std::move(clock);
+}
+
+void PlatformServices::SetNotifier(std::unique_ptr<INotifier> notifier) {
+    if (notifier) m_notifier = std::move(notifier);
+}
+
+void PlatformServices::SetDirectoryWatcher(std::unique_ptr<IDirectoryWatcher> directoryWatcher) {
+    if (directoryWatcher) m_directoryWatcher = std::move(directoryWatcher);
+}
+
+void PlatformServices::SetClipboard(std::unique_ptr<IClipboard> clipboard) {
+    if (clipboard) m_clipboard = std::move(clipboard);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "IClipboard.h"
+#include "IClock.h"
+#include "IDirectoryWatcher.h"
+#include "IFileSystem.h"
+#include "ILauncher.h"
+#include "INotifier.h"
+#include "IProcessEnumerator.h"
+#include <memory>
+
+// Zentrale Stelle für alle Betriebssystem-Dienste des Kerns.
+// Ohne Installation gelten portable Vorgaben: Systemuhr, Verzeichnisse aus den
+// Umgebungsvariablen, Launcher/Prozesse/Meldungen/Zwischenablage ohne Wirkung, keine Verzeichnis-Beobachtung.
+// Die Plattform-Targets ersetzen sie beim Start (InstallWin32PlatformServices,
+// InstallPosixPlatformServices), Tests mit den Klassen aus Platform/Mock.
+class PlatformServices {
+public:
+    static PlatformServices& Instance();
+
+    ILauncher& Launcher() { return *m_launcher; }
+    IProcessEnumerator& Processes() { return *m_processes; }
+    IFileSystem& FileSystem() { return *m_fileSystem; }
+    IClock& Clock() { return *m_clock; }
+    INotifier& Notifier() { return *m_notifier; }
+    IDirectoryWatcher& DirectoryWatcher() { return *m_directoryWatcher; }
+    IClipboard& Clipboard() { return *m_clipboard; }
+
+    // Nur beim Start aufrufen, bevor Worker-Threads laufen; nullptr wird ignoriert
+    void SetLauncher(std::unique_ptr<ILauncher> launcher);
+    void SetProcessEnumerator(std::unique_ptr<IProcessEnumerator> processes);
+    void SetFileSystem(std::unique_ptr<IFileSystem> fileSystem);
+    void SetClock(std::unique_ptr<IClock> clock);
+    void SetNotifier(std::unique_ptr<INotifier> notifier);
+    void SetDirectoryWatcher(std::unique_ptr<IDirectoryWatcher> directoryWatcher);
+    void SetClipboard(std::unique_ptr<IClipboard> clipboard);
+
+private:
+    PlatformServices();
+
+    std::unique_ptr<ILauncher> m_launcher;
+    std::unique_ptr<IProcessEnumerator> m_processes;
+    std::unique_ptr<IFileSystem> m_fileSystem;
+    std::unique_ptr<IClock> m_clock;
+    std::unique_ptr<INotifier> m_notifier;
+    std::unique_ptr<IDirectoryWatcher> m_directoryWatcher;
+    std::unique_ptr<IClipboard> m_clipboard;
+};
@@ -0,0 +1,65 @@
+#include "PortableServices.h"
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+namespace {
+
+// Fallback ohne Mapping: der ganze Inhalt liegt in einem eigenen Puffer
+class BufferedFile : public IMappedFile {
+public:
+    explicit BufferedFile(std::string contents) : m_contents(std::move(contents)) {}
+
+    const char* Data() const override { return m_contents.data(); }
+    size_t Size() const override { return m_contents.size(); }
+
+private:
+    std::string m_contents;
+};
+
+// Erstes gesetztes Verzeichnis aus der Liste (Variable + Unterpfad), sonst das Arbeitsverzeichnis
+std::filesystem::path ResolveDirectory(std::initializer_list<std::pair<const char*, const char*>> candidates) {
+    std::filesystem::path base;
+    for (const auto& candidate : candidates) {
+        const char* value = std::getenv(candidate.first);
+        if (value != nullptr && *value != '\0') {
+            base = std::filesystem::path(value) / candidate.second;
+            break;
+        }
+    }
+    if (base.empty()) {
+        base = std::filesystem::current_path();
+    }
+    base /= "WinPal";
+
+    std::error_code ec;
+    std::filesystem::create_directories(base, ec);
+    return base;
+}
+
+} // namespace
+
+std::unique_ptr<IMappedFile> IFileSystem::MapReadOnly(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return nullptr;
+    }
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (contents.empty()) {
+        return nullptr;
+    }
+    return std::make_unique<BufferedFile>(std::move(contents));
+}
+
+bool IFileSystem::SyncFile(const std::filesystem::path&) {
+    return true;
+}
+
+std::filesystem::path EnvironmentFileSystem::GetDataDirectory() {
+    return ResolveDirectory({ { "APPDATA", "" }, { "XDG_DATA_HOME", "" }, { "HOME", ".local/share" } });
+}
+
+std::filesystem::path EnvironmentFileSystem::GetCacheDirectory() {
+    return ResolveDirectory({ { "LOCALAPPDATA", "" }, { "XDG_CACHE_HOME", "" }, { "HOME", ".cache" } });
+}
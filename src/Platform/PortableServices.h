@@ -0,0 +1,47 @@
+#pragma once
+
+#include "PlatformServices.h"
+
+// Portable Vorgaben, die ohne Plattform-Target funktionieren
+
+class SystemClock : public IClock {
+public:
+    std::chrono::system_clock::time_point Now() const override { return std::chrono::system_clock::now(); }
+    std::chrono::steady_clock::time_point Monotonic() const override { return std::chrono::steady_clock::now(); }
+};
+
+// Verzeichnisse aus den Umgebungsvariablen: APPDATA/LOCALAPPDATA, sonst XDG bzw. ~/.local/share und ~/.cache
+class EnvironmentFileSystem : public IFileSystem {
+public:
+    std::filesystem::path GetDataDirectory() override;
+    std::filesystem::path GetCacheDirectory() override;
+};
+
+class NullLauncher : public ILauncher {
+public:
+    bool Open(const std::wstring&, const std::wstring&) override { return false; }
+};
+
+class NullProcessEnumerator : public IProcessEnumerator {
+public:
+    bool Enumerate(std::vector<ProcessEntry>& processes) override { processes.clear(); return false; }
+    bool Terminate(uint32_t) override { return false; }
+};
+
+class NullNotifier : public INotifier {
+public:
+    void ShowInfo(const std::wstring&, const std::wstring&) override {}
+    void ShowError(const std::wstring&, const std::wstring&) override {}
+};
+
+class NullDirectoryWatcher : public IDirectoryWatcher {
+public:
+    WatchId Watch(const std::filesystem::path&, bool, Callback) override { return 0; }
+    void Unwatch(WatchId) override {}
+};
+
+// Auch unter Linux: eine Zwischenablage gibt es nur mit Display-Server, die Harnesses laufen ohne
+class NullClipboard : public IClipboard {
+public:
+    bool Clear() override { return false; }
+};
@@ -0,0 +1,268 @@
+#include "PosixDirectoryWatcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t kWatchMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE |
+                            IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+// path liegt in directory oder ist es selbst
+bool IsWithin(const std::filesystem::path& path, const std::filesystem::path& directory) {
+    auto [end, unused] = std::mismatch(directory.begin(), directory.end(), path.begin(), path.end());
+    return end == directory.end();
+}
+
+} // namespace
+
+PosixDirectoryWatcher::~PosixDirectoryWatcher() {
+    if (m_reader.joinable()) {
+        char stop = 0;
+        while (write(m_stopPipe[1], &stop, 1) < 0 && errno == EINTR) {
+        }
+        m_reader.join();
+    }
+    // Schließen beendet auch alle inotify-Beobachtungen
+    for (int fd : { m_inotify, m_stopPipe[0], m_stopPipe[1] }) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+IDirectoryWatcher::WatchId PosixDirectoryWatcher::Watch(const std::filesystem::path& root, bool recursive, Callback callback) {
+    std::error_code ec;
+    if (!callback || !std::filesystem::is_directory(root, ec)) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!EnsureStarted()) {
+        return 0;
+    }
+
+    WatchId id = m_nextId++;
+    m_watches[id] = { root, recursive, std::move(callback) };
+    if (!AddDirectory(id, root)) {
+        m_watches.erase(id);
+        return 0;
+    }
+    if (recursive) {
+        AddTree(id, root, nullptr);
+    }
+    return id;
+}
+
+void PosixDirectoryWatcher::Unwatch(WatchId id) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_watches.erase(id) == 0) {
+            return;
+        }
+        std::vector<int> owned;
+        for (const auto& [descriptor, entry] : m_descriptors) {
+            if (std::find(entry.owners.begin(), entry.owners.end(), id) != entry.owners.end()) {
+                owned.push_back(descriptor);
+            }
+        }
+        for (int descriptor : owned) {
+            RemoveOwner(descriptor, id);
+        }
+    }
+
+    // Einen laufenden Rückruf abwarten; aus dem Rückruf selbst nicht (er hält die Sperre)
+    if (m_reader.get_id() != std::this_thread::get_id()) {
+        std::lock_guard<std::mutex> delivery(m_deliveryMutex);
+    }
+}
+
+bool PosixDirectoryWatcher::EnsureStarted() {
+    if (m_inotify >= 0) {
+        return true;
+    }
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify < 0) {
+        return false;
+    }
+    if (pipe2(m_stopPipe, O_CLOEXEC) != 0) {
+        close(m_inotify);
+        m_inotify = -1;
+        return false;
+    }
+    m_reader = std::thread(&PosixDirectoryWatcher::ReaderLoop, this);
+    return true;
+}
+
+bool PosixDirectoryWatcher::AddDirectory(WatchId id, const std::filesystem::path& directory) {
+    int descriptor = inotify_add_watch(m_inotify, directory.c_str(), kWatchMask);
+    if (descriptor < 0) {
+        return false;
+    }
+    Descriptor& entry = m_descriptors[descriptor];
+    if (entry.owners.empty()) {
+        entry.directory = directory;
+    }
+    if (std::find(entry.owners.begin(), entry.owners.end(), id) == entry.owners.end()) {
+        entry.owners.push_back(id);
+    }
+    return true;
+}
+
+void PosixDirectoryWatcher::AddTree(WatchId id, const std::filesystem::path& directory, std::vector<DirectoryChange>* added) {
+    // Erst beobachten, dann auflisten: was dazwischen entsteht, meldet inotify
+    std::vector<std::filesystem::path> pending{ directory };
+    while (!pending.empty()) {
+        std::filesystem::path current = std::move(pending.back());
+        pending.pop_back();
+
+        std::error_code ec;
+        std::filesystem::directory_iterator it(current, std::filesystem::directory_options::skip_permission_denied, ec);
+        for (std::filesystem::directory_iterator end; !ec && it != end; it.increment(ec)) {
+            const std::filesystem::directory_entry& entry = *it;
+            if (added) {
+                added->push_back({ DirectoryChange::Action::Added, entry.path() });
+            }
+            std::error_code typeError;
+            if (entry.is_directory(typeError) && !entry.is_symlink(typeError) && AddDirectory(id, entry.path())) {
+                pending.push_back(entry.path());
+            }
+        }
+    }
+}
+
+void PosixDirectoryWatcher::RemoveOwner(int descriptor, WatchId id) {
+    auto it = m_descriptors.find(descriptor);
+    if (it == m_descriptors.end()) {
+        return;
+    }
+    std::vector<WatchId>& owners = it->second.owners;
+    owners.erase(std::remove(owners.begin(), owners.end(), id), owners.end());
+    if (owners.empty()) {
+        inotify_rm_watch(m_inotify, descriptor);
+        m_descriptors.erase(it);
+    }
+}
+
+void PosixDirectoryWatcher::RemoveTree(const std::filesystem::path& directory) {
+    for (auto it = m_descriptors.begin(); it != m_descriptors.end();) {
+        if (IsWithin(it->second.directory, directory)) {
+            inotify_rm_watch(m_inotify, it->first);
+            it = m_descriptors.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PosixDirectoryWatcher::ReaderLoop() {
+    alignas(inotify_event) char buffer[64 * 1024];
+    for (;;) {
+        pollfd fds[2] = { { m_inotify, POLLIN, 0 }, { m_stopPipe[0], POLLIN, 0 } };
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        if ((fds[0].revents & POLLIN) == 0) {
+            continue;
+        }
+
+        ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+        if (length <= 0) {
+            if (length < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+            return;
+        }
+
+        std::lock_guard<std::mutex> delivery(m_deliveryMutex);
+        std::vector<std::pair<Callback, std::vector<DirectoryChange>>> deliveries;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Batches batches;
+            for (ssize_t offset = 0; offset < length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                HandleEvent(event->wd, event->mask, event->len > 0 ? event->name : "", batches);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+            for (auto& [id, changes] : batches) {
+                auto watch = m_watches.find(id);
+                if (watch != m_watches.end()) {
+                    deliveries.emplace_back(watch->second.callback, std::move(changes));
+                }
+            }
+        }
+
+        for (auto& [callback, changes] : deliveries) {
+            try {
+                callback(changes);
+            } catch (...) {
+                // Ein fehlerhafter Empfänger darf den Lese-Thread nicht beenden
+            }
+        }
+    }
+}
+
+void PosixDirectoryWatcher::HandleEvent(int descriptor, uint32_t mask, const char* name, Batches& batches) {
+    using Action = DirectoryChange::Action;
+
+    if (mask & IN_Q_OVERFLOW) {
+        for (const auto& [id, watch] : m_watches) {
+            batches[id].push_back({ Action::Overflow, watch.root });
+        }
+        return;
+    }
+
+    auto it = m_descriptors.find(descriptor);
+    if (it == m_descriptors.end()) {
+        return;
+    }
+    // Kopie, da das Nachtragen von Verzeichnissen m_descriptors verändert
+    Descriptor entry = it->second;
+
+    if (mask & IN_IGNORED) {
+        m_descriptors.erase(it);
+        return;
+    }
+    if (mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+        // Für Unterverzeichnisse meldet das Elternverzeichnis die Änderung; verschwindet
+        // eine Wurzel, ist ihre Beobachtung beendet
+        for (WatchId id : entry.owners) {
+            auto watch = m_watches.find(id);
+            if (watch != m_watches.end() && watch->second.root == entry.directory) {
+                batches[id].push_back({ Action::Stopped, entry.directory });
+            }
+        }
+        if (mask & IN_MOVE_SELF) {
+            RemoveTree(entry.directory);
+        }
+        return;
+    }
+
+    Action action;
+    if (mask & IN_CREATE) action = Action::Added;
+    else if (mask & IN_DELETE) action = Action::Removed;
+    else if (mask & IN_MOVED_FROM) action = Action::RenamedFrom;
+    else if (mask & IN_MOVED_TO) action = Action::RenamedTo;
+    else if (mask & IN_CLOSE_WRITE) action = Action::Modified;
+    else return;
+
+    std::filesystem::path path = entry.directory / name;
+    bool isDirectory = (mask & IN_ISDIR) != 0;
+    if (isDirectory && action == Action::RenamedFrom) {
+        RemoveTree(path);
+    }
+
+    for (WatchId id : entry.owners) {
+        std::vector<DirectoryChange>& changes = batches[id];
+        changes.push_back({ action, path });
+
+        auto watch = m_watches.find(id);
+        if (isDirectory && (action == Action::Added || action == Action::RenamedTo) &&
+            watch != m_watches.end() && watch->second.recursive && AddDirectory(id, path)) {
+            AddTree(id, path, &changes);
+        }
+    }
+}
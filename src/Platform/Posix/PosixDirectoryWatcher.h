@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../IDirectoryWatcher.h"
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// inotify: eine Beobachtung pro Verzeichnis, rekursive Wurzeln bekommen alle Unterverzeichnisse
+// einzeln. Neu angelegte oder hineinverschobene Verzeichnisse werden nachgetragen und ihr
+// Inhalt als Added gemeldet, da er vor der neuen Beobachtung entstanden sein kann.
+// Ein Lese-Thread für alle Beobachtungen, gestartet mit der ersten.
+class PosixDirectoryWatcher : public IDirectoryWatcher {
+public:
+    PosixDirectoryWatcher() = default;
+    ~PosixDirectoryWatcher() override;
+
+    PosixDirectoryWatcher(const PosixDirectoryWatcher&) = delete;
+    PosixDirectoryWatcher& operator=(const PosixDirectoryWatcher&) = delete;
+
+    WatchId Watch(const std::filesystem::path& root, bool recursive, Callback callback) override;
+    void Unwatch(WatchId id) override;
+
+private:
+    struct WatchEntry {
+        std::filesystem::path root;
+        bool recursive = false;
+        Callback callback;
+    };
+
+    // Ein inotify-Deskriptor je Verzeichnis; überlappende Wurzeln teilen ihn sich
+    struct Descriptor {
+        std::filesystem::path directory;
+        std::vector<WatchId> owners;
+    };
+
+    using Batches = std::map<WatchId, std::vector<DirectoryChange>>;
+
+    std::mutex m_mutex;
+    std::map<WatchId, WatchEntry> m_watches;
+    std::unordered_map<int, Descriptor> m_descriptors;
+    WatchId m_nextId = 1;
+    int m_inotify = -1;
+    int m_stopPipe[2] = { -1, -1 };
+
+    // Wird während der Zustellung gehalten, damit Unwatch einen laufenden Rückruf abwartet
+    std::mutex m_deliveryMutex;
+    std::thread m_reader;
+
+    bool EnsureStarted();
+    bool AddDirectory(WatchId id, const std::filesystem::path& directory);
+    void AddTree(WatchId id, const std::filesystem::path& directory, std::vector<DirectoryChange>* added);
+    void RemoveOwner(int descriptor, WatchId id);
+    void RemoveTree(const std::filesystem::path& directory);
+    void ReaderLoop();
+    void HandleEvent(int descriptor, uint32_t mask, const char* name, Batches& batches);
+};
@@ -0,0 +1,56 @@
+#include "PosixFileSystem.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+class PosixMappedFile : public IMappedFile {
+public:
+    PosixMappedFile(void* data, size_t size) : m_data(data), m_size(size) {}
+
+    ~PosixMappedFile() override {
+        munmap(m_data, m_size);
+    }
+
+    const char* Data() const override { return static_cast<const char*>(m_data); }
+    size_t Size() const override { return m_size; }
+
+private:
+    void* m_data;
+    size_t m_size;
+};
+
+} // namespace
+
+std::unique_ptr<IMappedFile> PosixFileSystem::MapReadOnly(const std::filesystem::path& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    // Das Mapping bleibt auch nach close() bestehen
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    return std::make_unique<PosixMappedFile>(data, size);
+}
+
+bool PosixFileSystem::SyncFile(const std::filesystem::path& path) {
+    int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = fsync(fd) == 0;
+    return close(fd) == 0 && synced;
+}
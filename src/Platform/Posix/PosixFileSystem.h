@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../PortableServices.h"
+
+// Verzeichnisse wie EnvironmentFileSystem, Dateien werden per mmap eingeblendet und per fsync geschrieben
+class PosixFileSystem : public EnvironmentFileSystem {
+public:
+    std::unique_ptr<IMappedFile> MapReadOnly(const std::filesystem::path& path) override;
+    bool SyncFile(const std::filesystem::path& path) override;
+};
@@ -0,0 +1,46 @@
+#include "PosixLauncher.h"
+#include <filesystem>
+#include <spawn.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+
+extern char** environ;
+
+namespace {
+
+std::string ToUtf8(const std::wstring& text) {
+    return std::filesystem::path(text).u8string();
+}
+
+} // namespace
+
+bool PosixLauncher::Open(const std::wstring& target, const std::wstring& arguments) {
+    if (target.empty()) {
+        return false;
+    }
+
+    // Mit Argumenten ist das Ziel ein Programm; ohne öffnet xdg-open Dateien, Ordner und URIs
+    std::vector<std::string> argv;
+    if (arguments.empty()) {
+        argv = { "xdg-open", ToUtf8(target) };
+    } else {
+        argv = { ToUtf8(target), ToUtf8(arguments) };
+    }
+
+    std::vector<char*> rawArgv;
+    for (auto& argument : argv) {
+        rawArgv.push_back(argument.data());
+    }
+    rawArgv.push_back(nullptr);
+
+    pid_t pid = 0;
+    if (posix_spawnp(&pid, rawArgv[0], nullptr, nullptr, rawArgv.data(), environ) != 0) {
+        return false;
+    }
+
+    // Sofort zurückkehren wie ShellExecute; der Kindprozess wird im Hintergrund eingesammelt
+    std::thread([pid]() { waitpid(pid, nullptr, 0); }).detach();
+    return true;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../ILauncher.h"
+
+// Öffnet Ziele über xdg-open, ausführbare Dateien mit Argumenten direkt
+class PosixLauncher : public ILauncher {
+public:
+    bool Open(const std::wstring& target, const std::wstring& arguments = L"") override;
+};
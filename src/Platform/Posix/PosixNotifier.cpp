@@ -0,0 +1,21 @@
+#include "PosixNotifier.h"
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+
+void Print(const char* level, const std::wstring& title, const std::wstring& message) {
+    std::fprintf(stderr, "[%s] %s: %s\n", level,
+                 std::filesystem::path(title).u8string().c_str(),
+                 std::filesystem::path(message).u8string().c_str());
+}
+
+} // namespace
+
+void PosixNotifier::ShowInfo(const std::wstring& title, const std::wstring& message) {
+    Print("info", title, message);
+}
+
+void PosixNotifier::ShowError(const std::wstring& title, const std::wstring& message) {
+    Print("error", title, message);
+}
@@ -0,0 +1,16 @@
+#include "PosixPlatform.h"
+#include "PosixDirectoryWatcher.h"
+#include "PosixFileSystem.h"
+#include "PosixLauncher.h"
+#include "PosixNotifier.h"
+#include "PosixProcessEnumerator.h"
+#include "../PlatformServices.h"
+
+void InstallPosixPlatformServices() {
+    PlatformServices& services = PlatformServices::Instance();
+    services.SetLauncher(std::make_unique<PosixLauncher>());
+    services.SetProcessEnumerator(std::make_unique<PosixProcessEnumerator>());
+    services.SetFileSystem(std::make_unique<PosixFileSystem>());
+    services.SetNotifier(std::make_unique<PosixNotifier>());
+    services.SetDirectoryWatcher(std::make_unique<PosixDirectoryWatcher>());
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Ersetzt die portablen Vorgaben in PlatformServices durch die POSIX-Dienste
+// (Linux-Harness, Benchmarks); Verzeichnisse kommen weiter aus XDG/HOME, Dateien per mmap.
+void InstallPosixPlatformServices();
@@ -0,0 +1,74 @@
+#include "PosixProcessEnumerator.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <signal.h>
+#include <sstream>
+#include <system_error>
+
+namespace {
+
+// "pid (comm) state ppid … starttime …"; comm kann Leerzeichen und Klammern enthalten,
+// daher ab der letzten schließenden Klammer weiterlesen
+bool ParseStat(const std::string& stat, std::string& name, uint32_t& parentProcessId, uint64_t& startTime) {
+    size_t open = stat.find('(');
+    size_t close = stat.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) {
+        return false;
+    }
+    name = stat.substr(open + 1, close - open - 1);
+
+    // Nach comm: Feld 3 (state) bis Feld 22 (starttime)
+    std::istringstream fields(stat.substr(close + 1));
+    std::string state;
+    unsigned long long parent = 0;
+    fields >> state >> parent;
+    std::string skipped;
+    for (int field = 5; field < 22 && fields >> skipped; ++field) {
+    }
+    unsigned long long start = 0;
+    if (!(fields >> start)) {
+        return false;
+    }
+    parentProcessId = static_cast<uint32_t>(parent);
+    startTime = start;
+    return true;
+}
+
+} // namespace
+
+bool PosixProcessEnumerator::Enumerate(std::vector<ProcessEntry>& processes) {
+    processes.clear();
+
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/proc", ec);
+    if (ec) {
+        return false;
+    }
+
+    for (const auto& entry : it) {
+        std::string name = entry.path().filename().string();
+        if (name.empty() || !std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            continue;
+        }
+
+        // Prozesse können zwischen Auflisten und Lesen verschwinden
+        std::ifstream statFile(entry.path() / "stat");
+        std::string stat;
+        std::string exeName;
+        ProcessEntry process{ static_cast<uint32_t>(std::stoul(name)), std::wstring() };
+        if (!std::getline(statFile, stat) || !ParseStat(stat, exeName, process.parentProcessId, process.startTime) ||
+            exeName.empty()) {
+            continue;
+        }
+
+        process.exeName = std::filesystem::path(exeName).wstring();
+        processes.push_back(std::move(process));
+    }
+    return true;
+}
+
+bool PosixProcessEnumerator::Terminate(uint32_t processId) {
+    return processId != 0 && kill(static_cast<pid_t>(processId), SIGTERM) == 0;
+}
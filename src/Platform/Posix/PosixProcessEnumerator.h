@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../IProcessEnumerator.h"
+
+// Prozessliste aus /proc/<pid>/stat (Name, Elternprozess, Startzeit in Ticks seit dem Booten),
+// Beenden über SIGTERM
+class PosixProcessEnumerator : public IProcessEnumerator {
+public:
+    bool Enumerate(std::vector<ProcessEntry>& processes) override;
+    bool Terminate(uint32_t processId) override;
+};
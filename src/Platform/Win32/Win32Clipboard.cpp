@@ -0,0 +1,11 @@
+#include "Win32Clipboard.h"
+#include <windows.h>
+
+bool Win32Clipboard::Clear() {
+    if (!OpenClipboard(NULL)) {
+        return false;
+    }
+    bool cleared = EmptyClipboard() != FALSE;
+    CloseClipboard();
+    return cleared;
+}
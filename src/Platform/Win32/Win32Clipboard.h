@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../IClipboard.h"
+
+// Zwischenablage über OpenClipboard/EmptyClipboard
+class Win32Clipboard : public IClipboard {
+public:
+    bool Clear() override;
+};
@@ -0,0 +1,206 @@
+#include "Win32DirectoryWatcher.h"
+#include <windows.h>
+#include <vector>
+
+namespace {
+
+const DWORD kNotifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+const size_t kBufferBytes = 64 * 1024;  // Obergrenze für Netzlaufwerke
+
+} // namespace
+
+struct Win32DirectoryWatcher::WatchEntry {
+    std::filesystem::path root;
+    bool recursive = false;
+    Callback callback;
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    OVERLAPPED overlapped{};
+    std::vector<DWORD> buffer = std::vector<DWORD>(kBufferBytes / sizeof(DWORD));
+    bool armed = false;
+
+    bool Arm() {
+        armed = ReadDirectoryChangesW(directory, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)),
+                                      recursive ? TRUE : FALSE, kNotifyFilter, NULL, &overlapped, NULL) != FALSE;
+        return armed;
+    }
+};
+
+Win32DirectoryWatcher::Win32DirectoryWatcher() = default;
+
+Win32DirectoryWatcher::~Win32DirectoryWatcher() {
+    if (m_reader.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        SetEvent(m_wake);
+        m_reader.join();
+    }
+    for (auto& [id, entry] : m_watches) {
+        Close(*entry);
+    }
+    for (auto& entry : m_retired) {
+        Close(*entry);
+    }
+    if (m_wake) {
+        CloseHandle(m_wake);
+    }
+}
+
+IDirectoryWatcher::WatchId Win32DirectoryWatcher::Watch(const std::filesystem::path& root, bool recursive, Callback callback) {
+    if (!callback) {
+        return 0;
+    }
+
+    auto entry = std::make_unique<WatchEntry>();
+    entry->root = root;
+    entry->recursive = recursive;
+    entry->callback = std::move(callback);
+    entry->directory = CreateFileW(root.c_str(), FILE_LIST_DIRECTORY,
+                                   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                                   FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    if (entry->directory == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    entry->overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+    if (!entry->overlapped.hEvent || !entry->Arm()) {
+        Close(*entry);
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_watches.size() >= MAXIMUM_WAIT_OBJECTS - 1 || !EnsureStarted()) {
+        Close(*entry);
+        return 0;
+    }
+    WatchId id = m_nextId++;
+    m_watches[id] = std::move(entry);
+    SetEvent(m_wake);
+    return id;
+}
+
+void Win32DirectoryWatcher::Unwatch(WatchId id) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_watches.find(id);
+        if (it == m_watches.end()) {
+            return;
+        }
+        m_retired.push_back(std::move(it->second));
+        m_watches.erase(it);
+    }
+    SetEvent(m_wake);
+
+    // Einen laufenden Rückruf abwarten; aus dem Rückruf selbst nicht (er hält die Sperre)
+    if (m_reader.get_id() != std::this_thread::get_id()) {
+        std::lock_guard<std::mutex> delivery(m_deliveryMutex);
+    }
+}
+
+bool Win32DirectoryWatcher::EnsureStarted() {
+    if (m_reader.joinable()) {
+        return true;
+    }
+    m_wake = CreateEventW(NULL, FALSE, FALSE, NULL);
+    if (!m_wake) {
+        return false;
+    }
+    m_reader = std::thread(&Win32DirectoryWatcher::ReaderLoop, this);
+    return true;
+}
+
+void Win32DirectoryWatcher::Close(WatchEntry& entry) {
+    if (entry.directory != INVALID_HANDLE_VALUE) {
+        // Der Puffer darf erst nach dem Ende der abgebrochenen Leseoperation frei werden
+        if (entry.armed && CancelIoEx(entry.directory, &entry.overlapped)) {
+            DWORD bytes = 0;
+            GetOverlappedResult(entry.directory, &entry.overlapped, &bytes, TRUE);
+        }
+        CloseHandle(entry.directory);
+        entry.directory = INVALID_HANDLE_VALUE;
+    }
+    if (entry.overlapped.hEvent) {
+        CloseHandle(entry.overlapped.hEvent);
+        entry.overlapped.hEvent = NULL;
+    }
+    entry.armed = false;
+}
+
+void Win32DirectoryWatcher::ReaderLoop() {
+    using Action = DirectoryChange::Action;
+
+    for (;;) {
+        std::vector<HANDLE> handles{ m_wake };
+        std::vector<WatchId> ids{ 0 };
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping) return;
+            for (auto& entry : m_retired) {
+                Close(*entry);
+            }
+            m_retired.clear();
+            for (const auto& [id, entry] : m_watches) {
+                if (entry->armed) {
+                    handles.push_back(entry->overlapped.hEvent);
+                    ids.push_back(id);
+                }
+            }
+        }
+
+        DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+        if (result < WAIT_OBJECT_0 + 1 || result >= WAIT_OBJECT_0 + handles.size()) {
+            // m_wake: Beobachtungen haben sich geändert oder Beenden
+            continue;
+        }
+
+        std::lock_guard<std::mutex> delivery(m_deliveryMutex);
+        Callback callback;
+        std::vector<DirectoryChange> changes;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_watches.find(ids[result - WAIT_OBJECT_0]);
+            if (it == m_watches.end()) {
+                continue;
+            }
+            WatchEntry& entry = *it->second;
+
+            DWORD bytes = 0;
+            entry.armed = false;
+            if (!GetOverlappedResult(entry.directory, &entry.overlapped, &bytes, FALSE) || bytes == 0) {
+                // Puffer übergelaufen (0 Bytes, ERROR_NOTIFY_ENUM_DIR) oder Verzeichnis weg
+                changes.push_back({ Action::Overflow, entry.root });
+            } else {
+                const BYTE* data = reinterpret_cast<const BYTE*>(entry.buffer.data());
+                for (DWORD offset = 0;;) {
+                    const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data + offset);
+                    Action action = Action::Modified;
+                    switch (info->Action) {
+                    case FILE_ACTION_ADDED: action = Action::Added; break;
+                    case FILE_ACTION_REMOVED: action = Action::Removed; break;
+                    case FILE_ACTION_RENAMED_OLD_NAME: action = Action::RenamedFrom; break;
+                    case FILE_ACTION_RENAMED_NEW_NAME: action = Action::RenamedTo; break;
+                    default: break;
+                    }
+                    std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+                    changes.push_back({ action, entry.root / name });
+                    if (info->NextEntryOffset == 0) break;
+                    offset += info->NextEntryOffset;
+                }
+            }
+
+            // Sofort wieder lesen; scheitert das, ist die Wurzel nicht mehr erreichbar und
+            // die Beobachtung endet (sie bleibt bis zum Unwatch, wird aber nicht mehr abgewartet)
+            ResetEvent(entry.overlapped.hEvent);
+            if (!entry.Arm()) {
+                changes.push_back({ Action::Stopped, entry.root });
+            }
+            callback = entry.callback;
+        }
+
+        try {
+            callback(changes);
+        } catch (...) {
+            // Ein fehlerhafter Empfänger darf den Lese-Thread nicht beenden
+        }
+    }
+}
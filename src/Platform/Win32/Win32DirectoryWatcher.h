@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../IDirectoryWatcher.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// ReadDirectoryChangesW mit überlappter E/A, bei rekursiven Wurzeln über den ganzen Teilbaum.
+// Ein Lese-Thread wartet auf alle Beobachtungen (höchstens MAXIMUM_WAIT_OBJECTS - 1).
+class Win32DirectoryWatcher : public IDirectoryWatcher {
+public:
+    Win32DirectoryWatcher();
+    ~Win32DirectoryWatcher() override;
+
+    Win32DirectoryWatcher(const Win32DirectoryWatcher&) = delete;
+    Win32DirectoryWatcher& operator=(const Win32DirectoryWatcher&) = delete;
+
+    WatchId Watch(const std::filesystem::path& root, bool recursive, Callback callback) override;
+    void Unwatch(WatchId id) override;
+
+private:
+    struct WatchEntry;
+
+    std::mutex m_mutex;
+    std::map<WatchId, std::unique_ptr<WatchEntry>> m_watches;
+    // Beendete Beobachtungen; nur der Lese-Thread schließt sie, da er auf ihre Ereignisse wartet
+    std::vector<std::unique_ptr<WatchEntry>> m_retired;
+    WatchId m_nextId = 1;
+    void* m_wake = nullptr;
+    bool m_stopping = false;
+
+    // Wird während der Zustellung gehalten, damit Unwatch einen laufenden Rückruf abwartet
+    std::mutex m_deliveryMutex;
+    std::thread m_reader;
+
+    bool EnsureStarted();
+    void ReaderLoop();
+    static void Close(WatchEntry& entry);
+};
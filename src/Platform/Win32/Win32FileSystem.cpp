@@ -0,0 +1,88 @@
+#include "Win32FileSystem.h"
+#include <windows.h>
+#include <shlobj.h>
+#include <system_error>
+
+namespace {
+
+class Win32MappedFile : public IMappedFile {
+public:
+    Win32MappedFile(HANDLE mapping, const void* view, size_t size) : m_mapping(mapping), m_view(view), m_size(size) {}
+
+    ~Win32MappedFile() override {
+        UnmapViewOfFile(m_view);
+        CloseHandle(m_mapping);
+    }
+
+    const char* Data() const override { return static_cast<const char*>(m_view); }
+    size_t Size() const override { return m_size; }
+
+private:
+    HANDLE m_mapping;
+    const void* m_view;
+    size_t m_size;
+};
+
+std::filesystem::path KnownFolder(int csidl) {
+    wchar_t path[MAX_PATH];
+    std::filesystem::path base;
+    if (SUCCEEDED(SHGetFolderPathW(NULL, csidl, NULL, 0, path))) {
+        base = path;
+    } else {
+        base = std::filesystem::current_path();
+    }
+    base /= L"WinPal";
+
+    std::error_code ec;
+    std::filesystem::create_directories(base, ec);
+    return base;
+}
+
+} // namespace
+
+std::filesystem::path Win32FileSystem::GetDataDirectory() {
+    return KnownFolder(CSIDL_APPDATA);
+}
+
+std::filesystem::path Win32FileSystem::GetCacheDirectory() {
+    return KnownFolder(CSIDL_LOCAL_APPDATA);
+}
+
+std::unique_ptr<IMappedFile> Win32FileSystem::MapReadOnly(const std::filesystem::path& path) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    // Das Mapping hält die Datei selbst offen, das Datei-Handle wird nicht mehr gebraucht
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return nullptr;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    return std::make_unique<Win32MappedFile>(mapping, view, static_cast<size_t>(size.QuadPart));
+}
+
+bool Win32FileSystem::SyncFile(const std::filesystem::path& path) {
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool synced = FlushFileBuffers(file) != FALSE;
+    CloseHandle(file);
+    return synced;
+}
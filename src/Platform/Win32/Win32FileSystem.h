@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../IFileSystem.h"
+
+// Bekannte Ordner über die Shell-API (CSIDL_APPDATA bzw. CSIDL_LOCAL_APPDATA)
+class Win32FileSystem : public IFileSystem {
+public:
+    std::filesystem::path GetDataDirectory() override;
+    std::filesystem::path GetCacheDirectory() override;
+
+    // CreateFileMapping/MapViewOfFile; die Datei bleibt zum Lesen und Löschen freigegeben
+    std::unique_ptr<IMappedFile> MapReadOnly(const std::filesystem::path& path) override;
+
+    // FlushFileBuffers über ein eigenes Handle; schreibt den Cache der ganzen Datei zurück
+    bool SyncFile(const std::filesystem::path& path) override;
+};
@@ -0,0 +1,11 @@
+#include "Win32Launcher.h"
+#include <windows.h>
+#include <shellapi.h>
+
+bool Win32Launcher::Open(const std::wstring& target, const std::wstring& arguments) {
+    HINSTANCE result = ShellExecuteW(NULL, L"open", target.c_str(),
+                                     arguments.empty() ? NULL : arguments.c_str(), NULL, SW_SHOWNORMAL);
+
+    // ShellExecute gibt einen Wert > 32 zurück bei Erfolg
+    return (reinterpret_cast<INT_PTR>(result) > 32);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../ILauncher.h"
+
+// ShellExecuteW mit dem Verb "open"
+class Win32Launcher : public ILauncher {
+public:
+    bool Open(const std::wstring& target, const std::wstring& arguments = L"") override;
+};
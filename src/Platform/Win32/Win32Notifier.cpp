@@ -0,0 +1,10 @@
+#include "Win32Notifier.h"
+#include <windows.h>
+
+void Win32Notifier::ShowInfo(const std::wstring& title, const std::wstring& message) {
+    MessageBoxW(NULL, message.c_str(), title.c_str(), MB_ICONINFORMATION | MB_OK);
+}
+
+void Win32Notifier::ShowError(const std::wstring& title, const std::wstring& message) {
+    MessageBoxW(NULL, message.c_str(), title.c_str(), MB_ICONERROR | MB_OK);
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../INotifier.h"
+
+// Meldungen als MessageBox
+class Win32Notifier : public INotifier {
+public:
+    void ShowInfo(const std::wstring& title, const std::wstring& message) override;
+    void ShowError(const std::wstring& title, const std::wstring& message) override;
+};
@@ -0,0 +1,18 @@
+#include "Win32Platform.h"
+#include "Win32Clipboard.h"
+#include "Win32DirectoryWatcher.h"
+#include "Win32FileSystem.h"
+#include "Win32Launcher.h"
+#include "Win32Notifier.h"
+#include "Win32ProcessEnumerator.h"
+#include "../PlatformServices.h"
+
+void InstallWin32PlatformServices() {
+    PlatformServices& services = PlatformServices::Instance();
+    services.SetLauncher(std::make_unique<Win32Launcher>());
+    services.SetProcessEnumerator(std::make_unique<Win32ProcessEnumerator>());
+    services.SetFileSystem(std::make_unique<Win32FileSystem>());
+    services.SetNotifier(std::make_unique<Win32Notifier>());
+    services.SetDirectoryWatcher(std::make_unique<Win32DirectoryWatcher>());
+    services.SetClipboard(std::make_unique<Win32Clipboard>());
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Ersetzt die portablen Vorgaben in PlatformServices durch die Win32-Dienste.
+// Als erstes in wWinMain aufrufen, bevor Plugins registriert werden.
+void InstallWin32PlatformServices();
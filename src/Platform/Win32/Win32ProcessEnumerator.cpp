@@ -0,0 +1,65 @@
+#include "Win32ProcessEnumerator.h"
+#include <windows.h>
+#include <tlhelp32.h>
+
+bool Win32ProcessEnumerator::Enumerate(std::vector<ProcessEntry>& processes) {
+    processes.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (hSnapshot == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    PROCESSENTRY32W pe32;
+    pe32.dwSize = sizeof(PROCESSENTRY32W);
+    if (Process32FirstW(hSnapshot, &pe32)) {
+        do {
+            ProcessEntry process{ static_cast<uint32_t>(pe32.th32ProcessID), pe32.szExeFile,
+                                  static_cast<uint32_t>(pe32.th32ParentProcessID) };
+            auto known = m_known.find(process.processId);
+            if (known != m_known.end() && known->second.exeName == process.exeName &&
+                known->second.parentProcessId == process.parentProcessId) {
+                process.startTime = known->second.startTime;
+            } else {
+                process.startTime = QueryStartTime(process.processId);
+            }
+            processes.push_back(std::move(process));
+        } while (Process32NextW(hSnapshot, &pe32));
+    }
+
+    CloseHandle(hSnapshot);
+
+    m_known.clear();
+    for (const ProcessEntry& process : processes) {
+        m_known.emplace(process.processId, process);
+    }
+    return true;
+}
+
+uint64_t Win32ProcessEnumerator::QueryStartTime(uint32_t processId) {
+    // Geschützte Prozesse verweigern auch die eingeschränkte Abfrage; dann bleibt es bei 0
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(processId));
+    if (hProcess == NULL) {
+        return 0;
+    }
+
+    FILETIME creation, exit, kernel, user;
+    uint64_t startTime = 0;
+    if (GetProcessTimes(hProcess, &creation, &exit, &kernel, &user)) {
+        startTime = (static_cast<uint64_t>(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
+    }
+    CloseHandle(hProcess);
+    return startTime;
+}
+
+bool Win32ProcessEnumerator::Terminate(uint32_t processId) {
+    HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(processId));
+    if (hProcess == NULL) {
+        return false;
+    }
+
+    bool terminated = TerminateProcess(hProcess, 1) != FALSE;
+    CloseHandle(hProcess);
+    return terminated;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../IProcessEnumerator.h"
+#include <mutex>
+#include <unordered_map>
+
+// Prozessliste über einen Toolhelp-Snapshot, Beenden über TerminateProcess.
+// Die Startzeit (GetProcessTimes, FILETIME) liefert Toolhelp nicht; sie wird nur für Prozesse
+// abgefragt, die im vorigen Snapshot fehlten oder deren Name bzw. Elternprozess sich geändert hat.
+class Win32ProcessEnumerator : public IProcessEnumerator {
+public:
+    bool Enumerate(std::vector<ProcessEntry>& processes) override;
+    bool Terminate(uint32_t processId) override;
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<uint32_t, ProcessEntry> m_known;
+
+    static uint64_t QueryStartTime(uint32_t processId);
+};
@@ -0,0 +1,155 @@
+#include "ApplicationCache.h"
+
+#include "../../Platform/PlatformServices.h"
+#include "../../Search/TrigramIndex.h"
+#include <cstring>
+
+namespace {
+
+const uint32_t kCacheMagic = 0x43415057; // "WPAC"
+const uint32_t kCacheVersion = 2;
+
+uint64_t Align8(uint64_t value) {
+    return (value + 7) & ~uint64_t(7);
+}
+
+bool SpanFits(FoldedTextPool::Span span, uint32_t characters) {
+    return span.offset <= characters && span.length <= characters - span.offset;
+}
+
+template <typename T>
+void PutArray(std::string& out, uint64_t offset, const T* values, size_t count) {
+    if (count > 0) {
+        std::memcpy(&out[offset], values, count * sizeof(T));
+    }
+}
+
+} // namespace
+
+ApplicationCache::Layout ApplicationCache::ComputeLayout(const Header& header) {
+    Layout layout;
+    layout.records = Align8(sizeof(Header));
+    layout.searchDisplay = layout.records + uint64_t(header.recordCount) * sizeof(Record);
+    layout.searchFolded = layout.searchDisplay + Align8(uint64_t(header.searchChars) * sizeof(wchar_t));
+    layout.detail = layout.searchFolded + Align8(uint64_t(header.searchChars) * sizeof(wchar_t));
+    layout.trigramKeys = layout.detail + Align8(uint64_t(header.detailChars) * sizeof(wchar_t));
+    layout.trigramOffsets = layout.trigramKeys + uint64_t(header.trigramKeys) * sizeof(uint64_t);
+    layout.trigramPostings = layout.trigramOffsets + (uint64_t(header.trigramKeys) + 1) * sizeof(uint32_t);
+    layout.fingerprints = layout.trigramPostings + Align8(uint64_t(header.trigramPostings) * sizeof(uint32_t));
+    layout.end = layout.fingerprints + header.fingerprintBytes;
+    return layout;
+}
+
+std::unique_ptr<ApplicationCache> ApplicationCache::Open(const std::filesystem::path& path) {
+    std::unique_ptr<IMappedFile> file = PlatformServices::Instance().FileSystem().MapReadOnly(path);
+    if (!file || file->Size() < sizeof(Header)) {
+        return nullptr;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(file->Data());
+    if (header->magic != kCacheMagic || header->version != kCacheVersion || header->charSize != sizeof(wchar_t)) {
+        return nullptr;
+    }
+
+    // Dateigröße muss exakt zu den Zählern passen, sonst läge ein Abschnitt außerhalb
+    Layout layout = ComputeLayout(*header);
+    if (header->fingerprintBytes > file->Size() || layout.end != file->Size()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<ApplicationCache> cache(new ApplicationCache());
+    const char* base = file->Data();
+    cache->m_header = header;
+    cache->m_records = reinterpret_cast<const Record*>(base + layout.records);
+    cache->m_searchDisplay = reinterpret_cast<const wchar_t*>(base + layout.searchDisplay);
+    cache->m_searchFolded = reinterpret_cast<const wchar_t*>(base + layout.searchFolded);
+    cache->m_detail = reinterpret_cast<const wchar_t*>(base + layout.detail);
+    cache->m_trigramKeys = reinterpret_cast<const uint64_t*>(base + layout.trigramKeys);
+    cache->m_trigramOffsets = reinterpret_cast<const uint32_t*>(base + layout.trigramOffsets);
+    cache->m_trigramPostings = reinterpret_cast<const uint32_t*>(base + layout.trigramPostings);
+    cache->m_fingerprints = base + layout.fingerprints;
+    cache->m_file = std::move(file);
+
+    // Nur die Record-Tabelle prüfen; die Texte selbst werden erst beim Zugriff eingelesen
+    for (uint32_t i = 0; i < header->recordCount; ++i) {
+        const Record& record = cache->m_records[i];
+        if (!SpanFits(record.name, header->searchChars) || !SpanFits(record.description, header->searchChars) ||
+            !SpanFits(record.path, header->detailChars) || !SpanFits(record.publisher, header->detailChars) ||
+            !SpanFits(record.version, header->detailChars) || !SpanFits(record.iconPath, header->detailChars)) {
+            return nullptr;
+        }
+    }
+    return cache;
+}
+
+ApplicationCache::Fields ApplicationCache::Get(uint32_t index) const {
+    const Record& record = m_records[index];
+    Fields fields;
+    fields.name = std::wstring_view(m_searchDisplay + record.name.offset, record.name.length);
+    fields.description = std::wstring_view(m_searchDisplay + record.description.offset, record.description.length);
+    fields.path = Detail(record.path);
+    fields.publisher = Detail(record.publisher);
+    fields.version = Detail(record.version);
+    fields.iconPath = Detail(record.iconPath);
+    fields.isUWP = (record.flags & FLAG_UWP) != 0;
+    return fields;
+}
+
+std::string ApplicationCache::Serialize(int64_t timestamp, const std::vector<Fields>& applications,
+                                        std::string_view fingerprints) {
+    // Texte einsammeln: Name und Beschreibung gefaltet in den Pool, der Rest in den Detailblock
+    FoldedTextPool search;
+    std::wstring detail;
+    std::vector<Record> records(applications.size());
+    auto appendDetail = [&detail](std::wstring_view text) {
+        FoldedTextPool::Span span{ static_cast<uint32_t>(detail.size()), static_cast<uint32_t>(text.size()) };
+        detail.append(text.data(), text.size());
+        return span;
+    };
+
+    TrigramIndex trigrams;
+    for (size_t i = 0; i < applications.size(); ++i) {
+        const Fields& app = applications[i];
+        Record& record = records[i];
+        record.name = search.Append(app.name);
+        record.description = search.Append(app.description);
+        record.path = appendDetail(app.path);
+        record.publisher = appendDetail(app.publisher);
+        record.version = appendDetail(app.version);
+        record.iconPath = appendDetail(app.iconPath);
+        record.flags = app.isUWP ? FLAG_UWP : 0;
+        record.reserved = 0;
+
+        // Name und Beschreibung getrennt, wie in ApplicationIndex::BuildTrigrams
+        uint32_t document = static_cast<uint32_t>(i);
+        trigrams.Add(document, search.Folded(record.name));
+        trigrams.Add(document, search.Folded(record.description));
+    }
+    trigrams.Finalize(static_cast<uint32_t>(applications.size()));
+
+    Header header{};
+    header.magic = kCacheMagic;
+    header.version = kCacheVersion;
+    header.charSize = static_cast<uint32_t>(sizeof(wchar_t));
+    header.recordCount = static_cast<uint32_t>(records.size());
+    header.timestamp = timestamp;
+    header.searchChars = static_cast<uint32_t>(search.Size());
+    header.detailChars = static_cast<uint32_t>(detail.size());
+    header.trigramKeys = static_cast<uint32_t>(trigrams.KeyCount());
+    header.trigramPostings = static_cast<uint32_t>(trigrams.PostingCount());
+    header.fingerprintBytes = fingerprints.size();
+
+    // Füllbytes zwischen den Abschnitten bleiben 0
+    Layout layout = ComputeLayout(header);
+    std::string out(static_cast<size_t>(layout.end), '\0');
+    PutArray(out, 0, &header, 1);
+    PutArray(out, layout.records, records.data(), records.size());
+    PutArray(out, layout.searchDisplay, search.DisplayBuffer().data(), search.Size());
+    PutArray(out, layout.searchFolded, search.FoldedBuffer().data(), search.Size());
+    PutArray(out, layout.detail, detail.data(), detail.size());
+    PutArray(out, layout.trigramKeys, trigrams.Keys(), trigrams.KeyCount());
+    PutArray(out, layout.trigramOffsets, trigrams.Offsets(), trigrams.KeyCount() + 1);
+    PutArray(out, layout.trigramPostings, trigrams.Postings(), trigrams.PostingCount());
+    PutArray(out, layout.fingerprints, fingerprints.data(), fingerprints.size());
+    return out;
+}
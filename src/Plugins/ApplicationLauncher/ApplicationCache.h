@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../../Platform/IFileSystem.h"
+#include "../../Search/FoldedTextPool.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Binärer Anwendungs-Cache (applications.bin), der eingeblendet statt geparst wird.
+// Aufbau, jeder Abschnitt auf 8 Byte ausgerichtet, Zeichen als wchar_t (unter Windows UTF-16):
+//   Header | Record[recordCount] | Suchtexte | Suchtexte gefaltet | Detailtexte |
+//   Trigramm-Schlüssel | Trigramm-Offsets | Trigramm-Postings | Fingerabdrücke
+// Name und Beschreibung liegen in den beiden parallelen Suchtext-Blöcken (Layout wie
+// FoldedTextPool), Pfad, Herausgeber, Version und Icon-Pfad im Detailblock. Die
+// Fingerabdrücke sind der serialisierte DirectoryFingerprints-Stand des Laufs, für das
+// inkrementelle Nachprüfen beim nächsten Start.
+// Open prüft nur Header, Größe und die Record-Tabelle; Texte werden erst beim Zugriff
+// gelesen, ein Kaltstart kostet also das Einblenden statt eines Parsens des Katalogs.
+class ApplicationCache {
+public:
+    struct Fields {
+        std::wstring_view name;
+        std::wstring_view path;
+        std::wstring_view description;
+        std::wstring_view publisher;
+        std::wstring_view version;
+        std::wstring_view iconPath;
+        bool isUWP = false;
+    };
+
+    // nullptr, wenn die Datei fehlt, eine andere Version hat oder nicht zu ihren Zählern passt
+    static std::unique_ptr<ApplicationCache> Open(const std::filesystem::path& path);
+
+    // Dateiinhalt für die Einträge; der Trigramm-Index wird dabei über alle Einträge aufgebaut
+    static std::string Serialize(int64_t timestamp, const std::vector<Fields>& applications,
+                                 std::string_view fingerprints);
+
+    int64_t GetTimestamp() const { return m_header->timestamp; }
+    uint32_t Size() const { return m_header->recordCount; }
+
+    // Views in die eingeblendete Datei, gültig solange der Cache lebt
+    Fields Get(uint32_t index) const;
+
+    // Für ApplicationIndex::Attach: Suchtext-Blöcke, Spans je Eintrag und Trigramm-Arrays
+    std::wstring_view SearchDisplay() const { return { m_searchDisplay, m_header->searchChars }; }
+    std::wstring_view SearchFolded() const { return { m_searchFolded, m_header->searchChars }; }
+    FoldedTextPool::Span NameSpan(uint32_t index) const { return m_records[index].name; }
+    FoldedTextPool::Span DescriptionSpan(uint32_t index) const { return m_records[index].description; }
+
+    const uint64_t* TrigramKeys() const { return m_trigramKeys; }
+    const uint32_t* TrigramOffsets() const { return m_trigramOffsets; }
+    const uint32_t* TrigramPostings() const { return m_trigramPostings; }
+    uint32_t TrigramKeyCount() const { return m_header->trigramKeys; }
+    uint32_t TrigramPostingCount() const { return m_header->trigramPostings; }
+
+    std::string_view Fingerprints() const { return { m_fingerprints, static_cast<size_t>(m_header->fingerprintBytes) }; }
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t charSize;
+        uint32_t recordCount;
+        int64_t timestamp;
+        uint32_t searchChars;
+        uint32_t detailChars;
+        uint32_t trigramKeys;
+        uint32_t trigramPostings;
+        uint64_t fingerprintBytes;
+    };
+
+    struct Record {
+        FoldedTextPool::Span name;        // Suchtexte
+        FoldedTextPool::Span description; // Suchtexte
+        FoldedTextPool::Span path;        // ab hier Detailtexte
+        FoldedTextPool::Span publisher;
+        FoldedTextPool::Span version;
+        FoldedTextPool::Span iconPath;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    // Byte-Offsets der Abschnitte, aus den Zählern im Header berechnet
+    struct Layout {
+        uint64_t records;
+        uint64_t searchDisplay;
+        uint64_t searchFolded;
+        uint64_t detail;
+        uint64_t trigramKeys;
+        uint64_t trigramOffsets;
+        uint64_t trigramPostings;
+        uint64_t fingerprints;
+        uint64_t end;
+    };
+
+    static constexpr uint32_t FLAG_UWP = 1;
+
+    std::unique_ptr<IMappedFile> m_file;
+    const Header* m_header = nullptr;
+    const Record* m_records = nullptr;
+    const wchar_t* m_searchDisplay = nullptr;
+    const wchar_t* m_searchFolded = nullptr;
+    const wchar_t* m_detail = nullptr;
+    const uint64_t* m_trigramKeys = nullptr;
+    const uint32_t* m_trigramOffsets = nullptr;
+    const uint32_t* m_trigramPostings = nullptr;
+    const char* m_fingerprints = nullptr;
+
+    static Layout ComputeLayout(const Header& header);
+    std::wstring_view Detail(FoldedTextPool::Span span) const { return { m_detail + span.offset, span.length }; }
+};
@@ -0,0 +1,82 @@
+#include "ApplicationCatalog.h"
+
+ApplicationCatalog::ApplicationCatalog(uint64_t version, int64_t timestamp)
+    : m_version(version), m_timestamp(timestamp) {
+}
+
+ApplicationCatalog::Ptr ApplicationCatalog::Build(uint64_t version, int64_t timestamp,
+                                                  std::vector<ApplicationInfo> applications, std::string fingerprints) {
+    std::shared_ptr<ApplicationCatalog> catalog(new ApplicationCatalog(version, timestamp));
+    catalog->m_applications = std::move(applications);
+    catalog->m_fingerprints = std::move(fingerprints);
+
+    size_t characters = 0;
+    for (const auto& app : catalog->m_applications) {
+        characters += app.name.size() + app.description.size();
+    }
+    catalog->m_index.Reserve(catalog->m_applications.size(), characters);
+    for (const auto& app : catalog->m_applications) {
+        catalog->m_index.Add(app.name, app.description);
+    }
+    catalog->m_index.BuildTrigrams();
+    return catalog;
+}
+
+ApplicationCatalog::Ptr ApplicationCatalog::FromCache(uint64_t version, std::unique_ptr<ApplicationCache> cache) {
+    if (!cache) {
+        return nullptr;
+    }
+    std::shared_ptr<ApplicationCatalog> catalog(new ApplicationCatalog(version, cache->GetTimestamp()));
+    catalog->m_cache = std::move(cache);
+    if (!catalog->m_index.Attach(*catalog->m_cache)) {
+        return nullptr;
+    }
+    return catalog;
+}
+
+ApplicationInfo ApplicationCatalog::Get(uint32_t index) const {
+    if (!m_cache) {
+        return m_applications[index];
+    }
+
+    ApplicationCache::Fields fields = m_cache->Get(index);
+    ApplicationInfo app(std::wstring(fields.name), std::wstring(fields.path), std::wstring(fields.description),
+                        std::wstring(fields.publisher), std::wstring(fields.version), fields.isUWP);
+    app.iconPath = fields.iconPath;
+    return app;
+}
+
+std::string_view ApplicationCatalog::Fingerprints() const {
+    return m_cache ? m_cache->Fingerprints() : std::string_view(m_fingerprints);
+}
+
+bool ApplicationCatalog::Equals(const std::vector<ApplicationInfo>& applications) const {
+    if (applications.size() != Size()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < applications.size(); ++i) {
+        const ApplicationInfo& app = applications[i];
+        ApplicationInfo current = Get(i);
+        if (app.name != current.name || app.path != current.path || app.description != current.description ||
+            app.publisher != current.publisher || app.version != current.version || app.isUWP != current.isUWP ||
+            app.iconPath != current.iconPath) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string ApplicationCatalog::Serialize() const {
+    std::vector<ApplicationCache::Fields> fields;
+    fields.reserve(Size());
+    if (m_cache) {
+        for (uint32_t i = 0; i < m_cache->Size(); ++i) {
+            fields.push_back(m_cache->Get(i));
+        }
+    } else {
+        for (const auto& app : m_applications) {
+            fields.push_back({ app.name, app.path, app.description, app.publisher, app.version, app.iconPath, app.isUWP });
+        }
+    }
+    return ApplicationCache::Serialize(m_timestamp, fields, Fingerprints());
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ApplicationCache.h"
+#include "ApplicationIndex.h"
+#include "ApplicationInfo.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Unveränderlicher, versionierter Stand des Anwendungskatalogs samt Suchindex.
+// Ein Katalog wird einmal aufgebaut und danach nur noch gelesen. Änderungen (Nachprüfen,
+// Aktualisieren) erzeugen einen neuen Katalog, den ApplicationFinder atomar veröffentlicht;
+// eine Suche hält per shared_ptr den Stand, den sie beim Start gegriffen hat, und braucht
+// kein Lock. Ein alter Stand wird mit seinem letzten Leser freigegeben.
+// Die Einträge liegen entweder als ApplicationInfo im Speicher oder in der eingeblendeten
+// Cache-Datei; dann entsteht ApplicationInfo erst für zurückgegebene Treffer.
+// Dazu gehört der serialisierte Fingerabdruck-Baum des Laufs, der den Katalog erzeugt hat.
+class ApplicationCatalog {
+public:
+    using Ptr = std::shared_ptr<const ApplicationCatalog>;
+
+    // Aus entdeckten Anwendungen; der Trigramm-Index umfasst alle Einträge
+    static Ptr Build(uint64_t version, int64_t timestamp, std::vector<ApplicationInfo> applications,
+                     std::string fingerprints);
+
+    // Über der eingeblendeten Cache-Datei; nullptr bei ungültigem Trigramm-Index
+    static Ptr FromCache(uint64_t version, std::unique_ptr<ApplicationCache> cache);
+
+    uint64_t Version() const { return m_version; }
+    int64_t Timestamp() const { return m_timestamp; }
+    bool IsMapped() const { return m_cache != nullptr; }
+    size_t Size() const { return m_index.Size(); }
+
+    ApplicationInfo Get(uint32_t index) const;
+    std::string_view Fingerprints() const;
+
+    // true, wenn applications genau diesem Katalog entspricht (gleiche Einträge, gleiche Reihenfolge)
+    bool Equals(const std::vector<ApplicationInfo>& applications) const;
+
+    // Thread-sicher, solange jeder Thread eigene Puffer mitgibt
+    void Rank(std::wstring_view foldedQuery, size_t limit, ApplicationIndex::RankScratch& scratch,
+              std::vector<uint32_t>& out) const {
+        m_index.Rank(foldedQuery, limit, scratch, out);
+    }
+
+    // Dateiinhalt für den Anwendungs-Cache
+    std::string Serialize() const;
+
+private:
+    ApplicationCatalog(uint64_t version, int64_t timestamp);
+
+    uint64_t m_version;
+    int64_t m_timestamp;
+    std::vector<ApplicationInfo> m_applications;
+    std::string m_fingerprints;
+    // Vor dem Index deklariert: der Index zeigt in die eingeblendete Datei
+    std::unique_ptr<ApplicationCache> m_cache;
+    ApplicationIndex m_index;
+};
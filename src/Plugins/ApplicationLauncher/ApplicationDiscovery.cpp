@@ -0,0 +1,231 @@
+#include "ApplicationDiscovery.h"
+#include "DirectoryFingerprints.h"
+
+#include "../../Concurrency/WorkStealingPool.h"
+#include "../../Search/TextFolding.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+
+using Candidate = ApplicationDiscovery::Candidate;
+using Directory = DirectoryFingerprints::Directory;
+
+struct SourceResult {
+    std::mutex mutex;
+    std::vector<Candidate> candidates;
+};
+
+// Gemeinsamer Zustand aller Verzeichnis-Aufgaben eines Laufs
+struct WalkContext {
+    WalkContext(WorkStealingPool& pool, const DirectoryFingerprints* previous, DirectoryFingerprints* next,
+                const ApplicationDiscovery::Changes* changes)
+        : pool(pool), previous(previous), next(next), changes(changes) {}
+
+    WorkStealingPool& pool;
+    const DirectoryFingerprints* previous;
+    DirectoryFingerprints* next;
+    const ApplicationDiscovery::Changes* changes;
+    std::mutex nextMutex;
+    std::atomic<size_t> read{ 0 };
+    std::atomic<size_t> reused{ 0 };
+    // Eine Quelle oder ein Verzeichnis ist gescheitert: Ergebnis und next sind unvollständig
+    std::atomic<bool> failed{ false };
+};
+
+template <typename Fn>
+void RunGuarded(WalkContext& context, Fn&& fn) {
+    try {
+        fn();
+    } catch (...) {
+        context.failed.store(true);
+    }
+}
+
+void WalkDirectory(WalkContext& context, const std::filesystem::path& directory, bool recursive,
+                   const ApplicationDiscovery::FileHandler& handler, SourceResult& result) {
+    std::wstring key = directory.wstring();
+    const Directory* known = context.previous ? context.previous->Find(key) : nullptr;
+    bool reported = context.changes && context.changes->directories.count(key) > 0;
+
+    std::error_code ec;
+    Directory current;
+    if (known && !reported && context.changes && !context.changes->overflow) {
+        // Der Watcher hat hier nichts gemeldet: ohne Abfrage unverändert übernehmen
+        current.modified = known->modified;
+    } else {
+        std::filesystem::file_time_type modified = std::filesystem::last_write_time(directory, ec);
+        if (ec) {
+            return;
+        }
+        current.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+    }
+
+    auto submit = [&context, &handler, &result](std::filesystem::path path) {
+        context.pool.Submit([&context, path = std::move(path), &handler, &result]() {
+            RunGuarded(context, [&]() { WalkDirectory(context, path, true, handler, result); });
+        });
+    };
+
+    if (known && !reported && known->modified == current.modified) {
+        // Keine Einträge hinzugekommen oder verschwunden: nicht lesen, nur die
+        // bekannten Unterverzeichnisse prüfen, da sich darin etwas geändert haben kann
+        current.entryCount = known->entryCount;
+        current.children = known->children;
+        current.candidates = known->candidates;
+        if (recursive) {
+            for (const std::wstring& child : current.children) {
+                submit(directory / child);
+            }
+        }
+        context.reused.fetch_add(1);
+    } else {
+        std::filesystem::directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec);
+        for (std::filesystem::directory_iterator end; !ec && it != end; it.increment(ec)) {
+            const std::filesystem::directory_entry& entry = *it;
+            std::error_code typeError;
+            ++current.entryCount;
+
+            // Unterverzeichnisse als eigene Aufgabe; Verzeichnis-Links nicht verfolgen (wie recursive_directory_iterator)
+            if (entry.is_directory(typeError) && !entry.is_symlink(typeError)) {
+                current.children.push_back(entry.path().filename().wstring());
+                if (recursive) {
+                    submit(entry.path());
+                }
+                continue;
+            }
+            if (!entry.is_regular_file(typeError)) {
+                continue;
+            }
+
+            Candidate candidate;
+            try {
+                if (handler(entry.path(), candidate)) {
+                    current.candidates.push_back(std::move(candidate));
+                }
+            } catch (...) {
+                // Eine unlesbare Datei überspringen
+            }
+        }
+        if (ec == std::errc::no_such_file_or_directory) {
+            // Inzwischen gelöscht, wie ein fehlendes Verzeichnis behandeln
+            return;
+        }
+        if (ec) {
+            // Abgebrochen: die Einträge sind unvollständig und dürfen nicht als Stand gelten
+            context.failed.store(true);
+            return;
+        }
+        context.read.fetch_add(1);
+    }
+
+    // Ein Lock pro Verzeichnis statt pro Datei
+    if (!current.candidates.empty()) {
+        std::lock_guard<std::mutex> lock(result.mutex);
+        result.candidates.insert(result.candidates.end(), current.candidates.begin(), current.candidates.end());
+    }
+    if (context.next) {
+        std::lock_guard<std::mutex> lock(context.nextMutex);
+        context.next->Set(key, std::move(current));
+    }
+}
+
+} // namespace
+
+ApplicationDiscovery::ApplicationDiscovery(size_t threadCount)
+    : m_threadCount(threadCount) {
+}
+
+void ApplicationDiscovery::AddProducer(Producer producer) {
+    Source source;
+    source.producer = std::move(producer);
+    m_sources.push_back(std::move(source));
+}
+
+void ApplicationDiscovery::AddDirectory(const std::filesystem::path& root, bool recursive, FileHandler handler) {
+    Source source;
+    source.root = root;
+    source.recursive = recursive;
+    source.handler = std::move(handler);
+    m_sources.push_back(std::move(source));
+}
+
+std::vector<ApplicationDiscovery::DirectorySource> ApplicationDiscovery::Directories() const {
+    std::vector<DirectorySource> directories;
+    for (const Source& source : m_sources) {
+        if (!source.producer) {
+            directories.push_back({ source.root, source.recursive });
+        }
+    }
+    return directories;
+}
+
+void ApplicationDiscovery::Changes::Merge(const Changes& other) {
+    directories.insert(other.directories.begin(), other.directories.end());
+    overflow = overflow || other.overflow;
+}
+
+size_t ApplicationDiscovery::DefaultThreadCount() {
+    size_t cores = std::thread::hardware_concurrency();
+    return std::clamp<size_t>(cores, 2, 8);
+}
+
+bool ApplicationDiscovery::Run(std::vector<Candidate>& catalogue, const DirectoryFingerprints* previous,
+                               DirectoryFingerprints* next, const Changes* changes) {
+    catalogue.clear();
+    std::vector<SourceResult> results(m_sources.size());
+    {
+        WorkStealingPool pool(m_threadCount);
+        WalkContext context(pool, previous, next, previous ? changes : nullptr);
+        for (size_t i = 0; i < m_sources.size(); ++i) {
+            const Source& source = m_sources[i];
+            SourceResult& result = results[i];
+            if (source.producer) {
+                // Nur diese Aufgabe schreibt in result, kein Lock nötig
+                pool.Submit([&context, &source, &result]() {
+                    RunGuarded(context, [&]() { source.producer(result.candidates); });
+                });
+            } else {
+                pool.Submit([&context, &source, &result]() {
+                    RunGuarded(context, [&]() { WalkDirectory(context, source.root, source.recursive, source.handler, result); });
+                });
+            }
+        }
+        pool.Wait();
+        m_directoriesRead = context.read.load();
+        m_directoriesReused = context.reused.load();
+        if (context.failed.load()) {
+            return false;
+        }
+    }
+
+    if (next) {
+        std::vector<std::wstring> roots;
+        for (const Source& source : m_sources) {
+            if (!source.producer) {
+                roots.push_back(source.root.wstring());
+            }
+        }
+        next->ComputeHashes(roots);
+    }
+
+    // Zusammenführen in Quellenreihenfolge; Verzeichnisquellen vorher nach Pfad ordnen,
+    // da ihre Reihenfolge von der Verteilung auf die Worker abhängt
+    std::unordered_set<std::wstring> seenPaths;
+    for (size_t i = 0; i < m_sources.size(); ++i) {
+        std::vector<Candidate>& candidates = results[i].candidates;
+        if (!m_sources[i].producer) {
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const Candidate& a, const Candidate& b) { return a.path < b.path; });
+        }
+        for (Candidate& candidate : candidates) {
+            if (seenPaths.insert(FoldText(candidate.path)).second) {
+                catalogue.push_back(std::move(candidate));
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class DirectoryFingerprints;
+
+// Sammelt Anwendungen aus mehreren Quellen parallel auf einem WorkStealingPool.
+// Jede Quelle ist eine Erzeuger-Aufgabe; Verzeichnisquellen stellen pro Unterverzeichnis eine
+// weitere Aufgabe ein, damit sich große Bäume (Startmenü) über alle Worker verteilen.
+// Das Ergebnis hängt nicht von der Thread-Verteilung ab: Verzeichnisquellen werden nach Pfad
+// sortiert, die Quellen in ihrer Registrierungsreihenfolge zusammengeführt, und bei gleichem
+// Pfad (ohne Groß/Kleinschreibung) gewinnt der erste Eintrag.
+// Mit dem Fingerabdruck-Baum eines früheren Laufs werden nur Verzeichnisse neu gelesen,
+// deren Änderungszeit abweicht; die übrigen liefern ihre gespeicherten Kandidaten.
+// Meldet zusätzlich ein Verzeichnis-Watcher lückenlos, was sich seitdem geändert hat, werden
+// die nicht gemeldeten Verzeichnisse nicht einmal mehr abgefragt.
+// Plattformneutral; was eine Datei zur Anwendung macht, entscheidet der FileHandler.
+class ApplicationDiscovery {
+public:
+    struct Candidate {
+        std::wstring name;
+        std::wstring path;
+        std::wstring description;
+        std::wstring publisher;
+        std::wstring version;
+        bool isUWP = false;
+    };
+
+    // Eine Quelle, die ihre Einträge selbst erzeugt (feste Listen, Registry)
+    using Producer = std::function<void(std::vector<Candidate>& out)>;
+
+    // Füllt candidate für eine Datei; false, wenn die Datei keine Anwendung ist.
+    // Läuft parallel auf mehreren Workern.
+    using FileHandler = std::function<bool(const std::filesystem::path& file, Candidate& candidate)>;
+
+    struct DirectorySource {
+        std::filesystem::path root;
+        bool recursive = false;
+    };
+
+    // Vom Verzeichnis-Watcher gemeldete Änderungen seit dem Stand von previous
+    struct Changes {
+        // Schlüssel wie im Fingerabdruck-Baum; werden neu gelesen, auch bei gleicher Änderungszeit
+        std::unordered_set<std::wstring> directories;
+        // Meldungen gingen verloren: alle bekannten Verzeichnisse wieder abfragen
+        bool overflow = false;
+
+        bool Empty() const { return directories.empty() && !overflow; }
+        void Merge(const Changes& other);
+    };
+
+    explicit ApplicationDiscovery(size_t threadCount);
+
+    void AddProducer(Producer producer);
+    void AddDirectory(const std::filesystem::path& root, bool recursive, FileHandler handler);
+
+    // Die registrierten Verzeichnisquellen, z.B. um sie zu beobachten
+    std::vector<DirectorySource> Directories() const;
+
+    // Führt alle Quellen aus und liefert in catalogue den zusammengeführten Katalog.
+    // previous: Stand eines früheren Laufs (optional); next erhält den Stand dieses Laufs.
+    // changes: alles, was sich seit previous geändert hat (optional, nur zusammen mit previous).
+    // false, wenn eine Quelle gescheitert ist; catalogue und next sind dann unbrauchbar.
+    bool Run(std::vector<Candidate>& catalogue, const DirectoryFingerprints* previous = nullptr,
+             DirectoryFingerprints* next = nullptr, const Changes* changes = nullptr);
+
+    // Verzeichnisse des letzten Laufs, die gelesen bzw. unverändert übernommen wurden
+    size_t DirectoriesRead() const { return m_directoriesRead; }
+    size_t DirectoriesReused() const { return m_directoriesReused; }
+
+    // Worker für die Suche: mindestens zwei, da die meiste Zeit auf Datei-I/O gewartet wird
+    static size_t DefaultThreadCount();
+
+private:
+    struct Source {
+        Producer producer;
+        std::filesystem::path root;
+        bool recursive = false;
+        FileHandler handler;
+    };
+
+    size_t m_threadCount;
+    std::vector<Source> m_sources;
+    size_t m_directoriesRead = 0;
+    size_t m_directoriesReused = 0;
+};
@@ -1,9 +1,16 @@
-#include "ApplicationFinder.h"
+#include "ApplicationFinder.h"
+#include "ApplicationDiscovery.h"
+#include "DirectoryFingerprints.h"
+#include "../../Search/TextFolding.h"
+#include "../../Search/StringSearch.h"
+#include "../../Platform/PlatformServices.h"
+#include "../../Storage/AtomicFile.h"
+#include "../../Storage/PersistenceService.h"
+#include "../../Diagnostics/StartupProfiler.h"
 #include <windows.h>
 #include <filesystem>
 #include <algorithm>
 #include <shlobj.h>
-#include <set>
 #include <cwctype>
 #include <shellapi.h>
 #include <comdef.h>
@@ -15,7 +22,6 @@
 #include <objidl.h>
 #include <shlguid.h>
 #include <fstream>
-#include <codecvt>
 #include <chrono>
 
 #pragma comment(lib, "wbemuuid.lib")
@@ -30,311 +36,304 @@ ApplicationFinder& ApplicationFinder::Instance() {
 }
 
 ApplicationFinder::ApplicationFinder()
-    : m_isInitialized(false), m_cacheTimestamp(0) {
+    : m_nextVersion(1), m_revalidationRequested(true), m_forceRevalidation(false), m_stopping(false),
+      m_watching(false), m_watchedScan(false) {
+    // Vor dem Finder anlegen, damit der Dienst beim Beenden erst nach ihm abgebaut wird
+    PersistenceService::Instance();
     m_cacheFilePath = GetCacheFilePath();
-    InitializeApplications();
-}
-
-std::vector<ApplicationInfo> ApplicationFinder::FindApplications(const std::wstring& searchTerm) {
-    if (!m_isInitialized) {
-        InitializeApplications();
-    }
-    
-    std::vector<ApplicationInfo> results;
-    
-    if (searchTerm.empty()) {
-        return results;
-    }
-    
-    std::wstring lowerSearchTerm = searchTerm;
-    std::transform(lowerSearchTerm.begin(), lowerSearchTerm.end(), lowerSearchTerm.begin(), ::towlower);
-    
-    // Simple fast search without complex caching
-    for (const auto& app : m_applications) {
-        std::wstring lowerName = app.name;
-        std::wstring lowerDesc = app.description;
-        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
-        std::transform(lowerDesc.begin(), lowerDesc.end(), lowerDesc.begin(), ::towlower);
-        
-        // Quick relevance check
-        bool matches = false;
-        if (lowerName.find(lowerSearchTerm) != std::wstring::npos ||
-            lowerDesc.find(lowerSearchTerm) != std::wstring::npos) {
-            matches = true;
-        }
-        
-        if (matches) {
-            results.push_back(app);
-            // Limit results for performance
-            if (results.size() >= 15) {
-                break;
-            }
-        }
-    }
-    
-    // Simple sorting by name length (shorter names are often more relevant)
-    std::sort(results.begin(), results.end(), [&lowerSearchTerm](const ApplicationInfo& a, const ApplicationInfo& b) {
-        std::wstring lowerA = a.name;
-        std::wstring lowerB = b.name;
-        std::transform(lowerA.begin(), lowerA.end(), lowerA.begin(), ::towlower);
-        std::transform(lowerB.begin(), lowerB.end(), lowerB.begin(), ::towlower);
-        
-        // Exact matches first
-        bool aExact = (lowerA == lowerSearchTerm);
-        bool bExact = (lowerB == lowerSearchTerm);
-        if (aExact && !bExact) return true;
-        if (!aExact && bExact) return false;
-        
-        // Starts-with matches next
-        bool aStarts = (lowerA.find(lowerSearchTerm) == 0);
-        bool bStarts = (lowerB.find(lowerSearchTerm) == 0);
-        if (aStarts && !bStarts) return true;
-        if (!aStarts && bStarts) return false;
-        
-        // Then by name length
-        if (a.name.length() != b.name.length()) {
-            return a.name.length() < b.name.length();
-        }
-        
-        return a.name < b.name;
-    });
-    
-    return results;
-}
-
-void ApplicationFinder::RefreshApplications() {
-    m_applications.clear();
-    m_isInitialized = false;
-    m_cacheTimestamp = 0;
-    std::error_code ec;
-    std::filesystem::remove(m_cacheFilePath, ec);
-    InitializeApplications();
+
+    // Sofort mit dem letzten Cache starten, auch wenn er veraltet ist; ob er noch
+    // aktuell ist, prüft erst der Hintergrund-Thread. Ohne Cache zunächst leer.
+    {
+        StartupProfiler::Phase phase(L"catalog: cache");
+        ApplicationCatalog::Ptr catalog = ApplicationCatalog::FromCache(m_nextVersion++, ApplicationCache::Open(m_cacheFilePath));
+        if (!catalog) {
+            catalog = ApplicationCatalog::Build(m_nextVersion++, 0, {}, std::string());
+        }
+        std::atomic_store(&m_catalog, std::move(catalog));
+    }
+
+    m_worker = std::thread(&ApplicationFinder::RevalidationLoop, this);
 }
 
-void ApplicationFinder::InitializeApplications() {
-    if (m_isInitialized) return;
+ApplicationFinder::~ApplicationFinder() {
+    // Zuerst, da die Beobachtung in m_pendingChanges schreibt und den Thread weckt
+    m_watcher.Stop();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+    PersistenceService::Instance().Flush(m_cacheFilePath);
+}
 
-    m_applications.clear();
+std::vector<ApplicationInfo> ApplicationFinder::FindApplications(const std::wstring& searchTerm) {
+    std::vector<ApplicationInfo> results;
+    
+    if (searchTerm.empty()) {
+        return results;
+    }
+    
+    // Der gegriffene Stand bleibt bis zum Ende der Suche gültig, auch wenn
+    // währenddessen ein neuer veröffentlicht wird
+    ApplicationCatalog::Ptr catalog = std::atomic_load(&m_catalog);
+    
+    // Suchpuffer pro Thread; der Katalog selbst wird nur gelesen
+    thread_local std::wstring foldedQuery;
+    thread_local ApplicationIndex::RankScratch scratch;
+    thread_local std::vector<uint32_t> rankedIndices;
+    
+    // Ganzen Katalog bewerten, nur die besten Treffer werden kopiert
+    FoldInto(searchTerm, foldedQuery);
+    catalog->Rank(foldedQuery, MAX_APPLICATION_RESULTS, scratch, rankedIndices);
+    
+    results.reserve(rankedIndices.size());
+    for (uint32_t index : rankedIndices) {
+        results.push_back(catalog->Get(index));
+    }
+    
+    return results;
+}
 
-    std::time_t currentTime = GetLatestSystemChangeTime();
+size_t ApplicationFinder::GetApplicationCount() const {
+    return std::atomic_load(&m_catalog)->Size();
+}
 
-    if (LoadCache() && m_cacheTimestamp >= currentTime) {
-        m_isInitialized = true;
-        return;
+void ApplicationFinder::RefreshApplications() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_revalidationRequested = true;
+        m_forceRevalidation = true;
     }
+    m_wake.notify_one();
+}
 
-    try {
-        // Reihenfolge ist wichtig für Performance
-        SearchInCommonApplications();
-        AddSystemTools();
-        SearchInStartMenu();
-        SearchInRegistry();
-        SearchWebBrowsers();
-        SearchInProgramFiles();
+void ApplicationFinder::SetCatalogChangedCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_catalogChanged = std::move(callback);
+}
 
-        // UWP Apps in separatem Thread für bessere Performance
-        std::thread uwpThread([this]() {
-            try {
-                SearchUWPApplications();
-            } catch (...) {
-                // Fehler bei UWP-Suche ignorieren
+void ApplicationFinder::RevalidationLoop() {
+    // Vor dem ersten Lauf beobachten, damit ihm keine Änderung entgeht
+    StartWatching();
+
+    for (;;) {
+        bool force;
+        bool trusted;
+        ApplicationDiscovery::Changes changes;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stopping || m_revalidationRequested; });
+            if (m_stopping) return;
+            force = m_forceRevalidation;
+            // Ist eine Beobachtung dauerhaft ausgefallen, wieder alle Änderungszeiten abfragen
+            if (m_watching && !m_watcher.Complete()) {
+                m_watching = false;
+                m_watchedScan = false;
             }
-        });
-        uwpThread.detach();
+            trusted = m_watching && m_watchedScan;
+            changes = std::move(m_pendingChanges);
+            m_pendingChanges = {};
+            m_revalidationRequested = false;
+            m_forceRevalidation = false;
+        }
 
-        m_cacheTimestamp = currentTime;
-        SaveCache();
-        m_isInitialized = true;
-    }
-    catch (...) {
-        // Bei Fehlern trotzdem als initialisiert markieren
-        m_isInitialized = true;
+        bool revalidated = false;
+        try {
+            revalidated = Revalidate(force, trusted ? &changes : nullptr);
+        } catch (...) {
+            // Der bisherige Katalog bleibt stehen
+        }
+        if (revalidated) {
+            m_watchedScan = true;
+        } else {
+            // Die Meldungen sind nicht übernommen und gelten für den nächsten Lauf weiter
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pendingChanges.Merge(changes);
+        }
     }
 }
 
-std::wstring ApplicationFinder::GetCacheFilePath() const {
-    wchar_t path[MAX_PATH];
-    if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_LOCAL_APPDATA, NULL, 0, path))) {
-        std::filesystem::path cacheDir = std::filesystem::path(path) / L"WinPal";
-        std::error_code ec;
-        std::filesystem::create_directories(cacheDir, ec);
-        return (cacheDir / L"applications.cache").wstring();
-    }
-    return L"applications.cache";
-}
+void ApplicationFinder::StartWatching() {
+    StartupProfiler::Phase phase(L"catalog: watch");
+    ApplicationDiscovery discovery(1);
+    SearchInStartMenu(discovery);
+    SearchInProgramFiles(discovery);
 
-bool ApplicationFinder::LoadCache() {
-    std::ifstream in(m_cacheFilePath, std::ios::binary);
-    if (!in.is_open()) {
-        return false;
-    }
+    bool watching = m_watcher.Start(discovery.Directories(), [this](const ApplicationDiscovery::Changes& changes) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pendingChanges.Merge(changes);
+            m_revalidationRequested = true;
+        }
+        m_wake.notify_one();
+    });
 
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-    std::string line;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_watching = watching;
+}
 
-    if (!std::getline(in, line)) return false;
-    try {
-        m_cacheTimestamp = std::stoll(line);
-    } catch (...) {
-        return false;
+bool ApplicationFinder::Revalidate(bool force, const ApplicationDiscovery::Changes* changes) {
+    // Fingerabdrücke des angezeigten Katalogs; ohne sie (oder beim Aktualisieren) alles neu lesen
+    ApplicationCatalog::Ptr served = std::atomic_load(&m_catalog);
+    DirectoryFingerprints previous;
+    if (!force) {
+        DirectoryFingerprints::Parse(served->Fingerprints(), previous);
     }
 
-    if (!std::getline(in, line)) return false;
-    size_t count = 0;
-    try {
-        count = static_cast<size_t>(std::stoull(line));
-    } catch (...) {
-        return false;
+    DirectoryFingerprints next;
+    std::vector<ApplicationInfo> applications;
+    {
+        StartupProfiler::Phase phase(previous.Empty() ? L"catalog: full scan" : changes ? L"catalog: apply changes" : L"catalog: rescan");
+        // Ein unvollständiger Lauf würde fehlende Anwendungen veröffentlichen und zwischenspeichern
+        if (!DiscoverApplications(previous.Empty() ? nullptr : &previous, next, changes, applications)) {
+            return false;
+        }
     }
 
-    m_applications.clear();
-    for (size_t i = 0; i < count; ++i) {
-        std::string s;
-        if (!std::getline(in, s)) return false; std::wstring name = converter.from_bytes(s);
-        if (!std::getline(in, s)) return false; std::wstring path = converter.from_bytes(s);
-        ApplicationInfo app(name, path);
-        if (!std::getline(in, s)) return false; app.description = converter.from_bytes(s);
-        if (!std::getline(in, s)) return false; app.publisher = converter.from_bytes(s);
-        if (!std::getline(in, s)) return false; app.version = converter.from_bytes(s);
-        if (!std::getline(in, s)) return false; app.iconPath = converter.from_bytes(s);
-        if (!std::getline(in, s)) return false; app.isUWP = (s == "1");
-        LoadIconForApplication(app);
-        m_applications.push_back(std::move(app));
+    // Nichts geändert: der bisherige Katalog bleibt, auch eingeblendet
+    if (!previous.Empty() && next.Fingerprint() == previous.Fingerprint() && served->Equals(applications)) {
+        return true;
     }
+    served.reset();
 
+    {
+        StartupProfiler::Phase phase(L"catalog: publish");
+        std::time_t now = std::chrono::system_clock::to_time_t(PlatformServices::Instance().Clock().Now());
+        Publish(ApplicationCatalog::Build(m_nextVersion++, static_cast<int64_t>(now), std::move(applications), next.Serialize()));
+    }
+    SaveCache();
     return true;
 }
 
-void ApplicationFinder::SaveCache() const {
-    std::ofstream out(m_cacheFilePath, std::ios::binary | std::ios::trunc);
-    if (!out.is_open()) {
-        return;
-    }
+bool ApplicationFinder::DiscoverApplications(const DirectoryFingerprints* previous, DirectoryFingerprints& next,
+                                             const ApplicationDiscovery::Changes* changes,
+                                             std::vector<ApplicationInfo>& applications) {
+    applications.clear();
+    try {
+        // Alle Quellen laufen parallel; ihre Reihenfolge hier entscheidet nur noch,
+        // welcher Eintrag bei gleichem Pfad im Katalog bleibt
+        ApplicationDiscovery discovery(ApplicationDiscovery::DefaultThreadCount());
+        discovery.AddProducer([this](std::vector<ApplicationDiscovery::Candidate>& out) { SearchInCommonApplications(out); });
+        discovery.AddProducer([this](std::vector<ApplicationDiscovery::Candidate>& out) { AddSystemTools(out); });
+        SearchInStartMenu(discovery);
+        SearchInRegistry(discovery);
+        discovery.AddProducer([this](std::vector<ApplicationDiscovery::Candidate>& out) { SearchWebBrowsers(out); });
+        SearchInProgramFiles(discovery);
+        discovery.AddProducer([this](std::vector<ApplicationDiscovery::Candidate>& out) { SearchUWPApplications(out); });
 
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-    out << static_cast<long long>(m_cacheTimestamp) << "\n";
-    out << m_applications.size() << "\n";
-    for (const auto& app : m_applications) {
-        out << converter.to_bytes(app.name) << "\n";
-        out << converter.to_bytes(app.path) << "\n";
-        out << converter.to_bytes(app.description) << "\n";
-        out << converter.to_bytes(app.publisher) << "\n";
-        out << converter.to_bytes(app.version) << "\n";
-        out << converter.to_bytes(app.iconPath) << "\n";
-        out << (app.isUWP ? 1 : 0) << "\n";
+        // Mit Meldungen des Watchers werden nur die gemeldeten Verzeichnisse neu gelesen
+        std::vector<ApplicationDiscovery::Candidate> discovered;
+        if (!discovery.Run(discovered, previous, &next, changes)) {
+            return false;
+        }
+        applications.reserve(discovered.size());
+        for (const auto& candidate : discovered) {
+            applications.emplace_back(candidate.name, candidate.path, candidate.description,
+                                      candidate.publisher, candidate.version, candidate.isUWP);
+        }
+    }
+    catch (...) {
+        return false;
     }
+    return true;
 }
 
-std::time_t ApplicationFinder::GetLatestSystemChangeTime() const {
-    auto getTime = [](const std::wstring& p) -> std::time_t {
-        try {
-            auto ft = std::filesystem::last_write_time(p);
-            return decltype(ft)::clock::to_time_t(ft);
-        } catch (...) {
-            return 0;
-        }
-    };
-
-    std::time_t latest = 0;
-    wchar_t dir[MAX_PATH];
+void ApplicationFinder::Publish(ApplicationCatalog::Ptr catalog) {
+    std::atomic_store(&m_catalog, std::move(catalog));
 
-    if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_STARTMENU, NULL, 0, dir))) {
-        latest = std::max(latest, getTime(std::wstring(dir)));
-        latest = std::max(latest, getTime(std::wstring(dir) + L"\\Programs"));
+    std::function<void()> callback;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        callback = m_catalogChanged;
     }
-    if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_COMMON_STARTMENU, NULL, 0, dir))) {
-        latest = std::max(latest, getTime(std::wstring(dir)));
-        latest = std::max(latest, getTime(std::wstring(dir) + L"\\Programs"));
-    }
-    if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_PROGRAM_FILES, NULL, 0, dir))) {
-        latest = std::max(latest, getTime(std::wstring(dir)));
-    }
-    if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_PROGRAM_FILESX86, NULL, 0, dir))) {
-        latest = std::max(latest, getTime(std::wstring(dir)));
+    if (callback) {
+        callback();
     }
+}
 
-    return latest;
+std::wstring ApplicationFinder::GetCacheFilePath() const {
+    return (PlatformServices::Instance().FileSystem().GetCacheDirectory() / L"applications.bin").wstring();
 }
-
-void ApplicationFinder::SearchInDirectory(const std::wstring& directory, bool recursive) {
-    try {
-        if (!std::filesystem::exists(directory)) {
-            return;
-        }
-        
-        std::set<std::wstring> processedFiles; // Duplikate vermeiden
-        
-        auto processFile = [&](const std::filesystem::directory_entry& entry) {
-            if (entry.is_regular_file()) {
-                std::wstring filePath = entry.path().wstring();
-                
-                // Duplikate vermeiden
-                if (processedFiles.find(filePath) != processedFiles.end()) {
-                    return;
-                }
-                processedFiles.insert(filePath);
-                
-                if (IsExecutableFile(filePath) && IsValidExecutablePath(filePath)) {
-                    std::wstring name = ExtractApplicationName(filePath);
-                    std::wstring description = GetFileDescription(filePath);
-                    std::wstring publisher = GetFilePublisher(filePath);
-                    std::wstring version = GetFileVersion(filePath);
-                    
-                    if (!name.empty()) {
-                        ApplicationInfo app(name, filePath, description, publisher, version, false);
-                        LoadIconForApplication(app);
-                        m_applications.push_back(std::move(app));
-                    }
-                }
-            }
-        };
-        
-        if (recursive) {
-            std::filesystem::recursive_directory_iterator iterator(directory, std::filesystem::directory_options::skip_permission_denied);
-            for (const auto& entry : iterator) {
-                processFile(entry);
-            }
-        } else {
-            std::filesystem::directory_iterator iterator(directory, std::filesystem::directory_options::skip_permission_denied);
-            for (const auto& entry : iterator) {
-                processFile(entry);
-            }
-        }
+
+void ApplicationFinder::SaveCache() {
+    // Läuft auf dem Persistenz-Thread ohne Lock: der Katalog ist unveränderlich,
+    // geschrieben wird der dann neueste Stand
+    PersistenceService::Instance().Schedule(m_cacheFilePath, [this]() {
+        ApplicationCatalog::Ptr catalog = std::atomic_load(&m_catalog);
+        // Inzwischen aus dem Cache geladen: nichts Neues, und die Datei ist eingeblendet
+        if (!catalog || catalog->IsMapped()) return true;
+        if (!WriteFileAtomically(m_cacheFilePath, catalog->Serialize())) {
+            return false;
+        }
+        // Textformat und Trigramm-Datei früherer Versionen aufräumen
+        std::filesystem::path directory = std::filesystem::path(m_cacheFilePath).parent_path();
+        std::error_code ec;
+        std::filesystem::remove(directory / L"applications.cache", ec);
+        std::filesystem::remove(directory / L"applications.trigrams", ec);
+        return true;
+    });
+}
+
+bool ApplicationFinder::DescribeFile(const std::filesystem::path& file, ApplicationDiscovery::Candidate& candidate) {
+    // Läuft parallel auf den Discovery-Workern; nur zustandslose Hilfsmethoden verwenden
+    std::wstring filePath = file.wstring();
+    if (!IsExecutableFile(filePath) || !IsValidExecutablePath(filePath)) {
+        return false;
     }
-    catch (...) {
-        // Fehler bei der Verzeichnissuche ignorieren
+
+    candidate.name = ExtractApplicationName(filePath);
+    if (candidate.name.empty()) {
+        return false;
     }
+
+    // Eine Versionsressource pro Datei statt je einer für Beschreibung, Herausgeber und Version
+    VersionDetails details = ReadVersionInfo(filePath);
+    candidate.path = std::move(filePath);
+    candidate.description = std::move(details.description);
+    candidate.publisher = std::move(details.publisher);
+    candidate.version = std::move(details.version);
+    return true;
 }
 
-void ApplicationFinder::SearchInStartMenu() {
+void ApplicationFinder::SearchInStartMenu(ApplicationDiscovery& discovery) {
     wchar_t startMenuPath[MAX_PATH];
+    auto handler = [this](const std::filesystem::path& file, ApplicationDiscovery::Candidate& candidate) {
+        return DescribeFile(file, candidate);
+    };
     
     // Benutzer-Startmenü
     if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_STARTMENU, NULL, 0, startMenuPath))) {
-        SearchInDirectory(std::wstring(startMenuPath) + L"\\Programs", true);
+        discovery.AddDirectory(std::wstring(startMenuPath) + L"\\Programs", true, handler);
     }
     
     // Gemeinsames Startmenü
     if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_COMMON_STARTMENU, NULL, 0, startMenuPath))) {
-        SearchInDirectory(std::wstring(startMenuPath) + L"\\Programs", true);
+        discovery.AddDirectory(std::wstring(startMenuPath) + L"\\Programs", true, handler);
     }
 }
 
-void ApplicationFinder::SearchInProgramFiles() {
+void ApplicationFinder::SearchInProgramFiles(ApplicationDiscovery& discovery) {
     wchar_t programFilesPath[MAX_PATH];
+    auto handler = [this](const std::filesystem::path& file, ApplicationDiscovery::Candidate& candidate) {
+        return DescribeFile(file, candidate);
+    };
     
     // Program Files
     if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_PROGRAM_FILES, NULL, 0, programFilesPath))) {
-        SearchInDirectory(programFilesPath, false); // Nur oberste Ebene für Performance
+        discovery.AddDirectory(programFilesPath, false, handler); // Nur oberste Ebene für Performance
     }
     
     // Program Files (x86)
     if (SUCCEEDED(SHGetFolderPathW(NULL, CSIDL_PROGRAM_FILESX86, NULL, 0, programFilesPath))) {
-        SearchInDirectory(programFilesPath, false); // Nur oberste Ebene für Performance
+        discovery.AddDirectory(programFilesPath, false, handler); // Nur oberste Ebene für Performance
     }
 }
 
-void ApplicationFinder::SearchInCommonApplications() {
+void ApplicationFinder::SearchInCommonApplications(std::vector<ApplicationDiscovery::Candidate>& out) {
     // Häufig verwendete System-Anwendungen mit besseren Beschreibungen
     std::vector<std::tuple<std::wstring, std::wstring, std::wstring>> commonApps = {
         {L"Calculator", L"calc.exe", L"Windows Calculator"},
@@ -360,29 +359,36 @@ void ApplicationFinder::SearchInCommonApplications() {
     };
     
     for (const auto& app : commonApps) {
-        ApplicationInfo appInfo(std::get<0>(app), std::get<1>(app), std::get<2>(app), L"Microsoft", L"", false);
-        LoadIconForApplication(appInfo);
-        m_applications.push_back(std::move(appInfo));
+        out.push_back({ std::get<0>(app), std::get<1>(app), std::get<2>(app), L"Microsoft", L"", false });
     }
 }
 
-void ApplicationFinder::SearchInRegistry() {
-    try {
+void ApplicationFinder::SearchInRegistry(ApplicationDiscovery& discovery) {
+    // Jeder Schlüssel ist eine eigene Quelle; das Durchsuchen der Install-Verzeichnisse dauert
+    const std::vector<std::pair<HKEY, std::wstring>> registryPaths = {
         // Uninstall-Register durchsuchen für installierte Programme
-        SearchRegistryPath(HKEY_LOCAL_MACHINE, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall");
-        SearchRegistryPath(HKEY_LOCAL_MACHINE, L"SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall");
-        SearchRegistryPath(HKEY_CURRENT_USER, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall");
-        
+        { HKEY_LOCAL_MACHINE, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall" },
+        { HKEY_LOCAL_MACHINE, L"SOFTWARE\\WOW6432Node\\Microsoft\\Windows\\CurrentVersion\\Uninstall" },
+        { HKEY_CURRENT_USER, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall" },
+
         // App Paths durchsuchen
-        SearchRegistryPath(HKEY_LOCAL_MACHINE, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\App Paths");
-        SearchRegistryPath(HKEY_CURRENT_USER, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\App Paths");
-    }
-    catch (...) {
-        // Registry-Fehler ignorieren
+        { HKEY_LOCAL_MACHINE, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\App Paths" },
+        { HKEY_CURRENT_USER, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\App Paths" }
+    };
+
+    for (const auto& [hKey, subKey] : registryPaths) {
+        discovery.AddProducer([this, hKey = hKey, subKey = subKey](std::vector<ApplicationDiscovery::Candidate>& out) {
+            try {
+                SearchRegistryPath(hKey, subKey, out);
+            }
+            catch (...) {
+                // Registry-Fehler ignorieren
+            }
+        });
     }
 }
 
-void ApplicationFinder::SearchRegistryPath(HKEY hKey, const std::wstring& subKey) {
+void ApplicationFinder::SearchRegistryPath(HKEY hKey, const std::wstring& subKey, std::vector<ApplicationDiscovery::Candidate>& out) {
     HKEY hSubKey;
     if (RegOpenKeyExW(hKey, subKey.c_str(), 0, KEY_READ, &hSubKey) != ERROR_SUCCESS) {
         return;
@@ -434,9 +440,7 @@ void ApplicationFinder::SearchRegistryPath(HKEY hKey, const std::wstring& subKey
                     executablePath = displayName; // Fallback
                 }
                 
-                ApplicationInfo appInfo(displayName, executablePath, L"Installed Application", publisher, version, false);
-                LoadIconForApplication(appInfo);
-                m_applications.push_back(std::move(appInfo));
+                out.push_back({ displayName, executablePath, L"Installed Application", publisher, version, false });
             }
             
             RegCloseKey(hAppKey);
@@ -449,7 +453,7 @@ void ApplicationFinder::SearchRegistryPath(HKEY hKey, const std::wstring& subKey
     RegCloseKey(hSubKey);
 }
 
-void ApplicationFinder::SearchUWPApplications() {
+void ApplicationFinder::SearchUWPApplications(std::vector<ApplicationDiscovery::Candidate>& out) {
     // UWP Apps über PowerShell-Command abrufen
     // Dies ist komplexer und würde eine vollständige PowerShell-Integration benötigen
     // Für jetzt eine vereinfachte Implementation
@@ -471,9 +475,7 @@ void ApplicationFinder::SearchUWPApplications() {
         };
         
         for (const auto& app : uwpApps) {
-            ApplicationInfo appInfo(std::get<0>(app), std::get<1>(app), std::get<2>(app), std::get<3>(app), L"", true);
-            LoadIconForApplication(appInfo);
-            m_applications.push_back(std::move(appInfo));
+            out.push_back({ std::get<0>(app), std::get<1>(app), std::get<2>(app), std::get<3>(app), L"", true });
         }
     }
     catch (...) {
@@ -481,7 +483,7 @@ void ApplicationFinder::SearchUWPApplications() {
     }
 }
 
-void ApplicationFinder::SearchWebBrowsers() {
+void ApplicationFinder::SearchWebBrowsers(std::vector<ApplicationDiscovery::Candidate>& out) {
     // Häufig verwendete Browser
     std::vector<std::tuple<std::wstring, std::wstring, std::wstring>> browsers = {
         {L"Google Chrome", L"chrome.exe", L"Web Browser"},
@@ -493,13 +495,11 @@ void ApplicationFinder::SearchWebBrowsers() {
     };
     
     for (const auto& browser : browsers) {
-        ApplicationInfo appInfo(std::get<0>(browser), std::get<1>(browser), std::get<2>(browser), L"", L"", false);
-        LoadIconForApplication(appInfo);
-        m_applications.push_back(std::move(appInfo));
+        out.push_back({ std::get<0>(browser), std::get<1>(browser), std::get<2>(browser), L"", L"", false });
     }
 }
 
-void ApplicationFinder::AddSystemTools() {
+void ApplicationFinder::AddSystemTools(std::vector<ApplicationDiscovery::Candidate>& out) {
     // Erweiterte System-Tools
     std::vector<std::tuple<std::wstring, std::wstring, std::wstring>> tools = {
         {L"Windows Security", L"windowsdefender:", L"Antivirus and Security Settings"},
@@ -520,9 +520,7 @@ void ApplicationFinder::AddSystemTools() {
     };
     
     for (const auto& tool : tools) {
-        ApplicationInfo appInfo(std::get<0>(tool), std::get<1>(tool), std::get<2>(tool), L"Microsoft", L"", false);
-        LoadIconForApplication(appInfo);
-        m_applications.push_back(std::move(appInfo));
+        out.push_back({ std::get<0>(tool), std::get<1>(tool), std::get<2>(tool), L"Microsoft", L"", false });
     }
 }
 
@@ -534,81 +532,49 @@ bool ApplicationFinder::IsExecutableFile(const std::wstring& filePath) {
            extension == L".cpl" || extension == L".scr";
 }
 
-std::wstring ApplicationFinder::GetFileDescription(const std::wstring& filePath) {
+ApplicationFinder::VersionDetails ApplicationFinder::ReadVersionInfo(const std::wstring& filePath) {
+    VersionDetails details;
+    details.description = L"Application";
+
     try {
         DWORD handle = 0;
         DWORD size = GetFileVersionInfoSizeW(filePath.c_str(), &handle);
         if (size == 0) {
-            return L"Application";
+            return details;
         }
         
         std::vector<BYTE> buffer(size);
         if (!GetFileVersionInfoW(filePath.c_str(), handle, size, buffer.data())) {
-            return L"Application";
+            return details;
         }
         
         LPVOID lpBuffer = nullptr;
         UINT uLen = 0;
         
         if (VerQueryValueW(buffer.data(), L"\\StringFileInfo\\040904B0\\FileDescription", &lpBuffer, &uLen) && uLen > 0) {
-            return std::wstring(static_cast<wchar_t*>(lpBuffer));
+            details.description = static_cast<wchar_t*>(lpBuffer);
+        } else if (VerQueryValueW(buffer.data(), L"\\StringFileInfo\\000004B0\\FileDescription", &lpBuffer, &uLen) && uLen > 0) {
+            // Fallback für andere Sprachen
+            details.description = static_cast<wchar_t*>(lpBuffer);
         }
         
-        // Fallback für andere Sprachen
-        if (VerQueryValueW(buffer.data(), L"\\StringFileInfo\\000004B0\\FileDescription", &lpBuffer, &uLen) && uLen > 0) {
-            return std::wstring(static_cast<wchar_t*>(lpBuffer));
+        if (VerQueryValueW(buffer.data(), L"\\StringFileInfo\\040904B0\\CompanyName", &lpBuffer, &uLen) && uLen > 0) {
+            details.publisher = static_cast<wchar_t*>(lpBuffer);
         }
-    }
-    catch (...) {}
-    
-    return L"Application";
-}
-
-std::wstring ApplicationFinder::GetFileVersion(const std::wstring& filePath) {
-    try {
-        DWORD handle = 0;
-        DWORD size = GetFileVersionInfoSizeW(filePath.c_str(), &handle);
-        if (size == 0) return L"";
-        
-        std::vector<BYTE> buffer(size);
-        if (!GetFileVersionInfoW(filePath.c_str(), handle, size, buffer.data())) return L"";
         
         VS_FIXEDFILEINFO* pFileInfo = nullptr;
         UINT len = 0;
         
-        if (VerQueryValueW(buffer.data(), L"\\", reinterpret_cast<LPVOID*>(&pFileInfo), &len)) {
-            if (pFileInfo) {
-                return std::to_wstring(HIWORD(pFileInfo->dwFileVersionMS)) + L"." +
-                       std::to_wstring(LOWORD(pFileInfo->dwFileVersionMS)) + L"." +
-                       std::to_wstring(HIWORD(pFileInfo->dwFileVersionLS)) + L"." +
-                       std::to_wstring(LOWORD(pFileInfo->dwFileVersionLS));
-            }
+        if (VerQueryValueW(buffer.data(), L"\\", reinterpret_cast<LPVOID*>(&pFileInfo), &len) && pFileInfo) {
+            details.version = std::to_wstring(HIWORD(pFileInfo->dwFileVersionMS)) + L"." +
+                              std::to_wstring(LOWORD(pFileInfo->dwFileVersionMS)) + L"." +
+                              std::to_wstring(HIWORD(pFileInfo->dwFileVersionLS)) + L"." +
+                              std::to_wstring(LOWORD(pFileInfo->dwFileVersionLS));
         }
     }
     catch (...) {}
     
-    return L"";
-}
-
-std::wstring ApplicationFinder::GetFilePublisher(const std::wstring& filePath) {
-    try {
-        DWORD handle = 0;
-        DWORD size = GetFileVersionInfoSizeW(filePath.c_str(), &handle);
-        if (size == 0) return L"";
-        
-        std::vector<BYTE> buffer(size);
-        if (!GetFileVersionInfoW(filePath.c_str(), handle, size, buffer.data())) return L"";
-        
-        LPVOID lpBuffer = nullptr;
-        UINT uLen = 0;
-        
-        if (VerQueryValueW(buffer.data(), L"\\StringFileInfo\\040904B0\\CompanyName", &lpBuffer, &uLen) && uLen > 0) {
-            return std::wstring(static_cast<wchar_t*>(lpBuffer));
-        }
-    }
-    catch (...) {}
-    
-    return L"";
+    return details;
 }
 
 std::wstring ApplicationFinder::ExtractApplicationName(const std::wstring& filePath) {
@@ -643,13 +609,7 @@ std::wstring ApplicationFinder::ExtractApplicationName(const std::wstring& fileP
 }
 
 bool ApplicationFinder::ContainsIgnoreCase(const std::wstring& text, const std::wstring& searchTerm) {
-    std::wstring lowerText = text;
-    std::wstring lowerSearch = searchTerm;
-    
-    std::transform(lowerText.begin(), lowerText.end(), lowerText.begin(), ::towlower);
-    std::transform(lowerSearch.begin(), lowerSearch.end(), lowerSearch.begin(), ::towlower);
-    
-    return lowerText.find(lowerSearch) != std::wstring::npos;
+    return ContainsFolded(text, FoldText(searchTerm));
 }
 
 std::wstring ApplicationFinder::GetRegistryString(HKEY hKey, const std::wstring& valueName) {
@@ -694,197 +654,3 @@ bool ApplicationFinder::IsValidExecutablePath(const std::wstring& path) {
     
     return true;
 }
-
-// Icon extraction methods implementation
-HICON ApplicationFinder::ExtractIconFromFile(const std::wstring& filePath) {
-    if (filePath.empty() || !std::filesystem::exists(filePath)) {
-        return nullptr;
-    }
-    
-    // Try to extract large icon first (32x32)
-    HICON hIconLarge = nullptr;
-    HICON hIconSmall = nullptr;
-    
-    UINT iconCount = ExtractIconExW(filePath.c_str(), -1, &hIconLarge, &hIconSmall, 1);
-    if (iconCount > 0) {
-        ExtractIconExW(filePath.c_str(), 0, &hIconLarge, &hIconSmall, 1);
-        
-        // Prefer large icon, fallback to small
-        if (hIconLarge) {
-            if (hIconSmall) DestroyIcon(hIconSmall);
-            return hIconLarge;
-        } else if (hIconSmall) {
-            return hIconSmall;
-        }
-    }
-    
-    // Fallback: try using LoadImage
-    HICON hIcon = static_cast<HICON>(LoadImageW(
-        nullptr, 
-        filePath.c_str(), 
-        IMAGE_ICON, 
-        32, 32, 
-        LR_LOADFROMFILE | LR_DEFAULTSIZE
-    ));
-    
-    return hIcon;
-}
-
-HICON ApplicationFinder::ExtractIconFromShortcut(const std::wstring& lnkPath) {
-    if (lnkPath.empty() || !std::filesystem::exists(lnkPath)) {
-        return nullptr;
-    }
-    
-    HRESULT hr = CoInitialize(nullptr);
-    if (FAILED(hr)) return nullptr;
-    
-    IShellLinkW* pShellLink = nullptr;
-    hr = CoCreateInstance(CLSID_ShellLink, nullptr, CLSCTX_INPROC_SERVER, 
-                         IID_IShellLinkW, reinterpret_cast<void**>(&pShellLink));
-    
-    if (FAILED(hr)) {
-        CoUninitialize();
-        return nullptr;
-    }
-    
-    IPersistFile* pPersistFile = nullptr;
-    hr = pShellLink->QueryInterface(IID_IPersistFile, reinterpret_cast<void**>(&pPersistFile));
-    
-    if (FAILED(hr)) {
-        pShellLink->Release();
-        CoUninitialize();
-        return nullptr;
-    }
-    
-    hr = pPersistFile->Load(lnkPath.c_str(), STGM_READ);
-    if (FAILED(hr)) {
-        pPersistFile->Release();
-        pShellLink->Release();
-        CoUninitialize();
-        return nullptr;
-    }
-    
-    wchar_t targetPath[MAX_PATH];
-    wchar_t iconPath[MAX_PATH];
-    int iconIndex = 0;
-    
-    // Get target path
-    hr = pShellLink->GetPath(targetPath, MAX_PATH, nullptr, SLGP_UNCPRIORITY);
-    
-    // Get icon information
-    hr = pShellLink->GetIconLocation(iconPath, MAX_PATH, &iconIndex);
-    
-    pPersistFile->Release();
-    pShellLink->Release();
-    CoUninitialize();
-    
-    HICON hIcon = nullptr;
-    
-    // Try to extract from specified icon path first
-    if (wcslen(iconPath) > 0 && std::filesystem::exists(iconPath)) {
-        HICON hIconLarge = nullptr;
-        HICON hIconSmall = nullptr;
-        UINT count = ExtractIconExW(iconPath, iconIndex, &hIconLarge, &hIconSmall, 1);
-        if (count > 0) {
-            hIcon = hIconLarge ? hIconLarge : hIconSmall;
-            if (hIconLarge && hIconSmall && hIconLarge != hIconSmall) {
-                DestroyIcon(hIconSmall);
-            }
-        }
-    }
-    
-    // Fallback to target executable
-    if (!hIcon && wcslen(targetPath) > 0) {
-        hIcon = ExtractIconFromFile(targetPath);
-    }
-    
-    return hIcon;
-}
-
-HICON ApplicationFinder::GetSystemIcon(const std::wstring& fileName) {
-    SHFILEINFOW sfi = {};
-    DWORD_PTR result = SHGetFileInfoW(
-        fileName.c_str(),
-        FILE_ATTRIBUTE_NORMAL,
-        &sfi,
-        sizeof(sfi),
-        SHGFI_ICON | SHGFI_LARGEICON | SHGFI_USEFILEATTRIBUTES
-    );
-    
-    return result ? sfi.hIcon : nullptr;
-}
-
-HICON ApplicationFinder::GetDefaultApplicationIcon() {
-    // Get default application icon from shell32.dll
-    HICON hIcon = nullptr;
-    ExtractIconExW(L"shell32.dll", 2, &hIcon, nullptr, 1); // Generic application icon
-    return hIcon;
-}
-
-void ApplicationFinder::LoadIconForApplication(ApplicationInfo& app) {
-    HICON hIcon = nullptr;
-    
-    if (app.isUWP) {
-        // For UWP apps, we can't easily extract icons, so use a default UWP icon
-        hIcon = GetSystemIcon(L"shell32.dll");
-        if (!hIcon) {
-            ExtractIconExW(L"shell32.dll", 15, &hIcon, nullptr, 1); // UWP/Store app icon
-        }
-    } else {
-        std::wstring extension = std::filesystem::path(app.path).extension().wstring();
-        std::transform(extension.begin(), extension.end(), extension.begin(), ::towlower);
-        
-        if (extension == L".lnk") {
-            // Handle shortcuts
-            hIcon = ExtractIconFromShortcut(app.path);
-        } else if (extension == L".exe" || extension == L".com" || extension == L".scr") {
-            // Handle executables
-            hIcon = ExtractIconFromFile(app.path);
-        } else if (extension == L".msc" || extension == L".cpl") {
-            // Handle system management tools
-            hIcon = GetSystemIcon(app.path);
-        } else {
-            // Handle other file types or system commands
-            if (app.path.find(L"ms-settings:") != std::wstring::npos) {
-                // Windows Settings
-                ExtractIconExW(L"shell32.dll", 316, &hIcon, nullptr, 1);
-            } else if (app.path.find(L"ms-windows-store:") != std::wstring::npos) {
-                // Microsoft Store
-                ExtractIconExW(L"shell32.dll", 15, &hIcon, nullptr, 1);
-            } else {
-                // Try to find executable in system paths
-                std::wstring fullPath = app.path;
-                if (!std::filesystem::exists(fullPath)) {
-                    // Search in System32
-                    std::wstring system32Path = L"C:\\Windows\\System32\\" + app.path;
-                    if (std::filesystem::exists(system32Path)) {
-                        fullPath = system32Path;
-                    } else {
-                        // Search in Windows directory
-                        std::wstring windowsPath = L"C:\\Windows\\" + app.path;
-                        if (std::filesystem::exists(windowsPath)) {
-                            fullPath = windowsPath;
-                        }
-                    }
-                }
-                
-                if (std::filesystem::exists(fullPath)) {
-                    hIcon = ExtractIconFromFile(fullPath);
-                } else {
-                    // Use system icon for the file type
-                    hIcon = GetSystemIcon(app.path);
-                }
-            }
-        }
-    }
-    
-    // Fallback to default application icon
-    if (!hIcon) {
-        hIcon = GetDefaultApplicationIcon();
-    }
-    
-    app.hIcon = hIcon;
-    if (hIcon) {
-        app.iconPath = app.path; // Store original path for reference
-    }
-} 
\ No newline at end of file
@@ -3,106 +3,91 @@
 #include <vector>
 #include <string>
 #include <memory>
-#include <ctime>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <windows.h>
-
-struct ApplicationInfo {
-    std::wstring name;
-    std::wstring path;
-    std::wstring description;
-    std::wstring publisher;
-    std::wstring version;
-    bool isUWP;
-    HICON hIcon;
-    std::wstring iconPath;
-    
-    ApplicationInfo(const std::wstring& appName, const std::wstring& appPath, 
-                   const std::wstring& appDesc = L"", const std::wstring& appPublisher = L"", 
-                   const std::wstring& appVersion = L"", bool uwp = false)
-        : name(appName), path(appPath), description(appDesc), 
-          publisher(appPublisher), version(appVersion), isUWP(uwp), hIcon(nullptr), iconPath(L"") {}
-          
-    ~ApplicationInfo() {
-        if (hIcon) {
-            DestroyIcon(hIcon);
-        }
-    }
-    
-    // Copy constructor
-    ApplicationInfo(const ApplicationInfo& other) 
-        : name(other.name), path(other.path), description(other.description),
-          publisher(other.publisher), version(other.version), isUWP(other.isUWP),
-          hIcon(nullptr), iconPath(other.iconPath) {
-        if (other.hIcon) {
-            hIcon = CopyIcon(other.hIcon);
-        }
-    }
-    
-    // Assignment operator
-    ApplicationInfo& operator=(const ApplicationInfo& other) {
-        if (this != &other) {
-            if (hIcon) {
-                DestroyIcon(hIcon);
-                hIcon = nullptr;
-            }
-            
-            name = other.name;
-            path = other.path;
-            description = other.description;
-            publisher = other.publisher;
-            version = other.version;
-            isUWP = other.isUWP;
-            iconPath = other.iconPath;
-            
-            if (other.hIcon) {
-                hIcon = CopyIcon(other.hIcon);
-            }
-        }
-        return *this;
-    }
-};
+#include "ApplicationCatalog.h"
+#include "ApplicationDiscovery.h"
+#include "ApplicationInfo.h"
+#include "CatalogWatcher.h"
 
 class ApplicationFinder {
 public:
     static ApplicationFinder& Instance();
 
+    // Thread-sicher und ohne Lock: sucht im zuletzt veröffentlichten Katalog
     std::vector<ApplicationInfo> FindApplications(const std::wstring& searchTerm);
+    // Sucht im Hintergrund neu; bis dahin bleibt der bisherige Katalog sichtbar
     void RefreshApplications();
-    size_t GetApplicationCount() const { return m_applications.size(); }
+    size_t GetApplicationCount() const;
+
+    // Läuft auf dem Hintergrund-Thread, sobald ein neuer Katalog veröffentlicht ist
+    void SetCatalogChangedCallback(std::function<void()> callback);
 
 private:
     ApplicationFinder();
+    ~ApplicationFinder();
 
-    std::vector<ApplicationInfo> m_applications;
-    bool m_isInitialized;
+    static constexpr size_t MAX_APPLICATION_RESULTS = 15;
+
+    // Aktueller Katalog, nur über std::atomic_load/std::atomic_store zugreifen.
+    // Suchen greifen ihn ohne Lock. Nach dem Start aus dem Cache veröffentlicht nur noch
+    // der Hintergrund-Thread neue Stände, die Versionen steigen also monoton.
+    ApplicationCatalog::Ptr m_catalog;
+    std::atomic<uint64_t> m_nextVersion;
     std::wstring m_cacheFilePath;
-    std::time_t m_cacheTimestamp;
 
-    void InitializeApplications();
-    void SearchInDirectory(const std::wstring& directory, bool recursive = false);
-    void SearchInStartMenu();
-    void SearchInProgramFiles();
-    void SearchInCommonApplications();
+    // Hintergrund-Thread, der den Katalog nachprüft bzw. neu aufbaut (stale-while-revalidate)
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_revalidationRequested;
+    bool m_forceRevalidation;
+    bool m_stopping;
+    std::function<void()> m_catalogChanged;
+    std::thread m_worker;
+
+    // Startmenü und Program Files werden beobachtet; gemeldete Änderungen sammeln sich hier,
+    // bis der Hintergrund-Thread sie abholt. Vertrauen kann er ihnen erst, wenn alle Verzeichnisse
+    // beobachtet werden und ein Lauf seit Beginn der Beobachtung den Stand festgestellt hat.
+    // Fällt eine Beobachtung dauerhaft aus, gilt das für den Rest der Sitzung nicht mehr.
+    CatalogWatcher m_watcher;
+    ApplicationDiscovery::Changes m_pendingChanges;
+    bool m_watching;
+    bool m_watchedScan;
+
+    void RevalidationLoop();
+    void StartWatching();
+    // false, wenn die Suche gescheitert ist; der bisherige Katalog bleibt dann stehen
+    bool Revalidate(bool force, const ApplicationDiscovery::Changes* changes);
+    bool DiscoverApplications(const DirectoryFingerprints* previous, DirectoryFingerprints& next,
+                              const ApplicationDiscovery::Changes* changes, std::vector<ApplicationInfo>& applications);
+    void Publish(ApplicationCatalog::Ptr catalog);
+    // Quellen der ApplicationDiscovery; Verzeichnisse und Registry-Schlüssel werden dort
+    // registriert, die Listen-Quellen laufen als Erzeuger auf den Discovery-Workern
+    bool DescribeFile(const std::filesystem::path& file, ApplicationDiscovery::Candidate& candidate);
+    void SearchInStartMenu(ApplicationDiscovery& discovery);
+    void SearchInProgramFiles(ApplicationDiscovery& discovery);
+    void SearchInCommonApplications(std::vector<ApplicationDiscovery::Candidate>& out);
     
     // Neue erweiterte Suchmethoden
-    void SearchInRegistry();
-    void SearchRegistryPath(HKEY hKey, const std::wstring& subKey);
-    void SearchUWPApplications();
-    void SearchWebBrowsers();
-    void AddSystemTools();
-    
-    // Icon extraction methods
-    HICON ExtractIconFromFile(const std::wstring& filePath);
-    HICON ExtractIconFromShortcut(const std::wstring& lnkPath);
-    HICON GetSystemIcon(const std::wstring& fileName);
-    HICON GetDefaultApplicationIcon();
-    void LoadIconForApplication(ApplicationInfo& app);
+    void SearchInRegistry(ApplicationDiscovery& discovery);
+    void SearchRegistryPath(HKEY hKey, const std::wstring& subKey, std::vector<ApplicationDiscovery::Candidate>& out);
+    void SearchUWPApplications(std::vector<ApplicationDiscovery::Candidate>& out);
+    void SearchWebBrowsers(std::vector<ApplicationDiscovery::Candidate>& out);
+    void AddSystemTools(std::vector<ApplicationDiscovery::Candidate>& out);
     
     // Hilfsmethoden
+    struct VersionDetails {
+        std::wstring description;
+        std::wstring publisher;
+        std::wstring version;
+    };
+
     bool IsExecutableFile(const std::wstring& filePath);
-    std::wstring GetFileDescription(const std::wstring& filePath);
-    std::wstring GetFileVersion(const std::wstring& filePath);
-    std::wstring GetFilePublisher(const std::wstring& filePath);
+    VersionDetails ReadVersionInfo(const std::wstring& filePath);
     std::wstring ExtractApplicationName(const std::wstring& filePath);
     bool ContainsIgnoreCase(const std::wstring& text, const std::wstring& searchTerm);
     std::wstring GetRegistryString(HKEY hKey, const std::wstring& valueName);
@@ -110,7 +95,5 @@ private:
 
     // Cache helpers
     std::wstring GetCacheFilePath() const;
-    bool LoadCache();
-    void SaveCache() const;
-    std::time_t GetLatestSystemChangeTime() const;
+    void SaveCache();
 };
\ No newline at end of file
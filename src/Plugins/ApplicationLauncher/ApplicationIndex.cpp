@@ -0,0 +1,130 @@
+#include "ApplicationIndex.h"
+#include "ApplicationCache.h"
+#include "../../Search/TopK.h"
+#include "../../Search/StringSearch.h"
+
+void ApplicationIndex::Add(std::wstring_view name, std::wstring_view description) {
+    Entry entry;
+    entry.name = m_pool.Append(name);
+    entry.description = m_pool.Append(description);
+    m_entries.push_back(entry);
+}
+
+void ApplicationIndex::Reserve(size_t entries, size_t characters) {
+    m_entries.reserve(entries);
+    m_pool.Reserve(characters);
+}
+
+void ApplicationIndex::Clear() {
+    m_entries.clear();
+    m_pool.Clear();
+    m_trigrams.Clear();
+}
+
+void ApplicationIndex::BuildTrigrams() {
+    m_trigrams.Clear();
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        // Name und Beschreibung getrennt, damit keine Trigramme über die Feldgrenze entstehen
+        m_trigrams.Add(i, m_pool.Folded(m_entries[i].name));
+        m_trigrams.Add(i, m_pool.Folded(m_entries[i].description));
+    }
+    m_trigrams.Finalize(static_cast<uint32_t>(m_entries.size()));
+}
+
+bool ApplicationIndex::Attach(const ApplicationCache& cache) {
+    Clear();
+    m_pool.Attach(cache.SearchDisplay(), cache.SearchFolded());
+    m_entries.resize(cache.Size());
+    for (uint32_t i = 0; i < cache.Size(); ++i) {
+        m_entries[i].name = cache.NameSpan(i);
+        m_entries[i].description = cache.DescriptionSpan(i);
+    }
+
+    if (!m_trigrams.Attach(cache.TrigramKeys(), cache.TrigramKeyCount(), cache.TrigramOffsets(),
+                           cache.TrigramPostings(), cache.TrigramPostingCount(), cache.Size())) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void ApplicationIndex::Rank(std::wstring_view foldedQuery, size_t limit, std::vector<uint32_t>& out) {
+    Rank(foldedQuery, limit, m_scratch, out);
+}
+
+void ApplicationIndex::Rank(std::wstring_view foldedQuery, size_t limit, RankScratch& scratch,
+                            std::vector<uint32_t>& out) const {
+    std::vector<RankKey>& keys = scratch.keys;
+    out.clear();
+    keys.clear();
+
+    if (foldedQuery.empty() || limit == 0) {
+        return;
+    }
+
+    // Teilstring-Stufen: Kandidaten aus dem Trigramm-Index plus die nachträglich
+    // angehängten, noch nicht indizierten Einträge; kurze Queries prüfen alles
+    if (m_trigrams.Candidates(foldedQuery, scratch.candidates, scratch.queryRanges)) {
+        for (uint32_t index : scratch.candidates) {
+            RankSubstring(index, foldedQuery, keys);
+        }
+        for (uint32_t index = m_trigrams.DocumentCount(); index < m_entries.size(); ++index) {
+            RankSubstring(index, foldedQuery, keys);
+        }
+    } else {
+        for (uint32_t index = 0; index < m_entries.size(); ++index) {
+            RankSubstring(index, foldedQuery, keys);
+        }
+    }
+
+    // Tippfehler-Stufe liegt immer unter den Teilstring-Stufen: der volle Scan
+    // ist nur nötig, wenn diese die Ergebnisliste nicht schon füllen
+    const uint32_t maxTypos = FuzzyMatcher::TypoBudget(foldedQuery.size());
+    if (maxTypos > 0 && keys.size() < limit) {
+        scratch.fuzzyMatcher.SetPattern(foldedQuery);
+        FuzzyMatcher::Match fuzzyMatch;
+
+        // keys ist hier noch nach Index sortiert
+        const size_t substringMatches = keys.size();
+        size_t next = 0;
+        for (uint32_t index = 0; index < m_entries.size(); ++index) {
+            if (next < substringMatches && keys[next].index == index) {
+                ++next;
+                continue;
+            }
+            if (scratch.fuzzyMatcher.Search(m_pool.Folded(m_entries[index].name), maxTypos, fuzzyMatch)) {
+                // Tippfehler im Namen: je weniger Fehler, desto besser
+                keys.push_back({ static_cast<uint8_t>(4 + fuzzyMatch.distance), m_entries[index].name.length, index });
+            }
+        }
+    }
+
+    KeepTopK(keys, limit, [this](const RankKey& a, const RankKey& b) {
+        if (a.tier != b.tier) return a.tier < b.tier;
+        if (a.nameLength != b.nameLength) return a.nameLength < b.nameLength;
+        return GetName(a.index) < GetName(b.index);
+    });
+
+    out.reserve(keys.size());
+    for (const auto& key : keys) {
+        out.push_back(key.index);
+    }
+}
+
+void ApplicationIndex::RankSubstring(uint32_t index, std::wstring_view foldedQuery, std::vector<RankKey>& keys) const {
+    std::wstring_view name = m_pool.Folded(m_entries[index].name);
+
+    uint8_t tier;
+    size_t pos = FindFolded(name, foldedQuery);
+    if (pos == 0) {
+        tier = (name.size() == foldedQuery.size()) ? 0 : 1;
+    } else if (pos != std::wstring_view::npos) {
+        tier = 2;
+    } else if (ContainsFolded(m_pool.Folded(m_entries[index].description), foldedQuery)) {
+        tier = 3;
+    } else {
+        return;
+    }
+
+    keys.push_back({ tier, m_entries[index].name.length, index });
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../../Search/FoldedTextPool.h"
+#include "../../Search/FuzzyMatcher.h"
+#include "../../Search/TrigramIndex.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class ApplicationCache;
+
+// Plattformunabhängiger Suchindex über den Anwendungskatalog.
+// Die Einträge haben dieselbe Reihenfolge wie der ApplicationCatalog, zu dem der Index
+// gehört; Rank() liefert also direkt dessen Indizes.
+class ApplicationIndex {
+private:
+    // Vorberechneter Sortierschlüssel, damit der Vergleich nichts allokiert
+    struct RankKey {
+        uint8_t tier;
+        uint32_t nameLength;
+        uint32_t index;
+    };
+
+public:
+    struct Entry {
+        FoldedTextPool::Span name;
+        FoldedTextPool::Span description;
+    };
+
+    // Wiederverwendete Puffer einer Suche; jeder suchende Thread braucht seine eigenen
+    struct RankScratch {
+        std::vector<uint32_t> candidates;
+        TrigramIndex::QueryRanges queryRanges;
+        std::vector<RankKey> keys;
+        FuzzyMatcher fuzzyMatcher;
+    };
+
+    void Add(std::wstring_view name, std::wstring_view description);
+    void Reserve(size_t entries, size_t characters);
+    void Clear();
+
+    // Trigramm-Index über alle aktuell enthaltenen Einträge. Später angehängte Einträge
+    // (z.B. aus dem UWP-Thread) werden bis zum nächsten Aufbau linear geprüft.
+    void BuildTrigrams();
+
+    // Übernimmt Texte und Trigramm-Index aus dem eingeblendeten Cache, ohne Texte zu kopieren.
+    // Der Cache muss leben, bis Clear() aufgerufen wird; false bei ungültigem Trigramm-Index.
+    bool Attach(const ApplicationCache& cache);
+
+    size_t Size() const { return m_entries.size(); }
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+    std::wstring_view GetName(uint32_t index) const { return m_pool.Display(m_entries[index].name); }
+    std::wstring_view GetFoldedName(uint32_t index) const { return m_pool.Folded(m_entries[index].name); }
+    std::wstring_view GetFoldedDescription(uint32_t index) const { return m_pool.Folded(m_entries[index].description); }
+
+    // Bewertet den gesamten Katalog gegen die (bereits gefaltete) Query und
+    // schreibt die besten "limit" Indizes sortiert nach out.
+    // Reihenfolge: exakter Name, Name beginnt mit Query, Name enthält Query,
+    // nur Beschreibung enthält Query, Name mit Tippfehlern (nach Fehlerzahl);
+    // innerhalb einer Stufe kürzere Namen zuerst.
+    void Rank(std::wstring_view foldedQuery, size_t limit, std::vector<uint32_t>& out);
+
+    // Wie oben mit Puffern des Aufrufers; ändert den Index nicht und darf daher
+    // von mehreren Threads gleichzeitig auf demselben Index laufen
+    void Rank(std::wstring_view foldedQuery, size_t limit, RankScratch& scratch, std::vector<uint32_t>& out) const;
+
+private:
+    std::vector<Entry> m_entries;
+    FoldedTextPool m_pool;
+    TrigramIndex m_trigrams;
+    RankScratch m_scratch;
+
+    void RankSubstring(uint32_t index, std::wstring_view foldedQuery, std::vector<RankKey>& keys) const;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+struct ApplicationInfo {
+    std::wstring name;
+    std::wstring path;
+    std::wstring description;
+    std::wstring publisher;
+    std::wstring version;
+    bool isUWP;
+    // Abweichende Icon-Datei; leer heißt Icon von path. Das Icon selbst lädt der IconCache
+    // erst beim Zeichnen, ApplicationInfo bleibt damit ein billig kopierbarer Wert.
+    std::wstring iconPath;
+    
+    ApplicationInfo(const std::wstring& appName, const std::wstring& appPath, 
+                   const std::wstring& appDesc = L"", const std::wstring& appPublisher = L"", 
+                   const std::wstring& appVersion = L"", bool uwp = false)
+        : name(appName), path(appPath), description(appDesc), 
+          publisher(appPublisher), version(appVersion), isUWP(uwp), iconPath(L"") {}
+};
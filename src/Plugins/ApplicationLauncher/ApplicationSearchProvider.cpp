@@ -0,0 +1,45 @@
+#include "ApplicationSearchProvider.h"
+#include "LaunchApplicationCommand.h"
+#include "../../Search/TextFolding.h"
+#include "../../Commands/FrecencyStore.h"
+
+ApplicationSearchProvider::ApplicationSearchProvider(const SelectionModel& selections)
+    : m_applicationFinder(ApplicationFinder::Instance()), m_selections(selections) {
+}
+
+void ApplicationSearchProvider::Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) {
+    std::wstring term = query;
+    bool hasLaunchWord = StripLaunchWord(term);
+    if (term.size() < MIN_QUERY_LENGTH) return;
+
+    std::vector<ApplicationInfo> applications = m_applicationFinder.FindApplications(term);
+    if (token.IsCancelled()) return;
+
+    // Gelernte Auswahlen gelten für die vollständige Eingabe, inklusive Launch-Wort
+    SelectionModel::Choices choices;
+    bool hasChoices = m_selections.Lookup(FoldText(query), choices);
+
+    // Rangfolge des Katalogs bleibt erhalten, der Score fällt pro Platz leicht ab
+    double score = hasLaunchWord ? LAUNCH_PREFIX_SCORE : PLAIN_QUERY_SCORE;
+    for (const auto& app : applications) {
+        auto command = std::make_shared<LaunchApplicationCommand>(app);
+        double boost = hasChoices ? SelectionModel::BOOST_WEIGHT * choices.Affinity(FrecencyStore::MakeId(command->GetName())) : 0.0;
+        hits.push_back({ std::move(command), score + boost });
+        score -= 1.0;
+    }
+}
+
+bool ApplicationSearchProvider::StripLaunchWord(std::wstring& query) {
+    static const wchar_t* const launchWords[] = { L"launch ", L"start ", L"run ", L"open " };
+
+    std::wstring folded = FoldText(query);
+    for (const wchar_t* word : launchWords) {
+        std::wstring_view prefix(word);
+        if (folded.compare(0, prefix.size(), prefix) == 0) {
+            size_t start = query.find_first_not_of(L' ', prefix.size());
+            query = (start == std::wstring::npos) ? std::wstring() : query.substr(start);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../../Search/SearchScheduler.h"
+#include "ApplicationFinder.h"
+#include "../../Commands/SelectionModel.h"
+
+// Durchsucht den Anwendungskatalog. Mit vorangestelltem "launch"/"start"/"run"/"open"
+// werden Anwendungen bevorzugt, sonst ordnen sie sich unter passenden Command-Namen ein.
+// Für diese Eingabe gewohnheitsmäßig gewählte Anwendungen bekommen den Bonus aus dem SelectionModel.
+class ApplicationSearchProvider : public ISearchProvider {
+public:
+    explicit ApplicationSearchProvider(const SelectionModel& selections);
+
+    void Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) override;
+
+private:
+    static constexpr size_t MIN_QUERY_LENGTH = 2;
+    static constexpr double LAUNCH_PREFIX_SCORE = 95.0;
+    static constexpr double PLAIN_QUERY_SCORE = 65.0;
+
+    ApplicationFinder& m_applicationFinder;
+    const SelectionModel& m_selections;
+
+    // Entfernt ein führendes Launch-Wort; true, wenn eines gefunden wurde
+    static bool StripLaunchWord(std::wstring& query);
+};
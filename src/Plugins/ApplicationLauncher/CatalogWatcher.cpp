@@ -0,0 +1,116 @@
+#include "CatalogWatcher.h"
+#include "../../Platform/PlatformServices.h"
+#include <algorithm>
+
+using namespace std::chrono;
+
+CatalogWatcher::~CatalogWatcher() {
+    Stop();
+}
+
+bool CatalogWatcher::Start(const std::vector<ApplicationDiscovery::DirectorySource>& directories, BatchCallback onBatch) {
+    Stop();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+        m_pending = {};
+        m_onBatch = std::move(onBatch);
+    }
+    m_dispatcher = std::thread(&CatalogWatcher::DispatchLoop, this);
+
+    // Eine fehlende Wurzel (z.B. Program Files (x86) auf 32-Bit-Systemen) ist nicht beobachtbar;
+    // dann muss der Aufrufer weiterhin jedes Verzeichnis abfragen
+    IDirectoryWatcher& watcher = PlatformServices::Instance().DirectoryWatcher();
+    bool complete = !directories.empty();
+    m_complete = true;
+    for (const ApplicationDiscovery::DirectorySource& directory : directories) {
+        IDirectoryWatcher::WatchId id = watcher.Watch(directory.root, directory.recursive,
+            [this, root = directory.root](const std::vector<DirectoryChange>& changes) { OnChanges(root, changes); });
+        if (id != 0) {
+            m_watches.push_back(id);
+        } else {
+            complete = false;
+        }
+    }
+    if (!complete) {
+        m_complete = false;
+    }
+    return complete;
+}
+
+void CatalogWatcher::Stop() {
+    // Erst die Beobachtungen beenden, danach kommt kein OnChanges mehr
+    IDirectoryWatcher& watcher = PlatformServices::Instance().DirectoryWatcher();
+    for (IDirectoryWatcher::WatchId id : m_watches) {
+        watcher.Unwatch(id);
+    }
+    m_watches.clear();
+    m_complete = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_dispatcher.joinable()) {
+        m_dispatcher.join();
+    }
+}
+
+void CatalogWatcher::OnChanges(const std::filesystem::path& root, const std::vector<DirectoryChange>& changes) {
+    steady_clock::time_point now = steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending.Empty()) {
+            m_firstChange = now;
+        }
+        for (const DirectoryChange& change : changes) {
+            if (change.action == DirectoryChange::Action::Stopped) {
+                m_complete = false;
+                m_pending.overflow = true;
+                continue;
+            }
+            if (change.action == DirectoryChange::Action::Overflow) {
+                m_pending.overflow = true;
+                continue;
+            }
+            // Geändert hat sich das Verzeichnis, das den Eintrag enthält; der Schlüssel
+            // wird wie beim Durchlaufen aus der Wurzel zusammengesetzt
+            std::filesystem::path relative = change.path.parent_path().lexically_relative(root);
+            if (relative.empty()) {
+                m_pending.overflow = true;
+            } else if (relative == ".") {
+                m_pending.directories.insert(root.wstring());
+            } else {
+                m_pending.directories.insert((root / relative).wstring());
+            }
+        }
+        m_due = std::min(now + QUIET, m_firstChange + MAX_LATENCY);
+    }
+    m_wake.notify_one();
+}
+
+void CatalogWatcher::DispatchLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        if (m_pending.Empty()) {
+            m_wake.wait(lock);
+            continue;
+        }
+        if (steady_clock::now() < m_due) {
+            m_wake.wait_until(lock, m_due);
+            continue;
+        }
+
+        ApplicationDiscovery::Changes batch = std::move(m_pending);
+        m_pending = {};
+        BatchCallback onBatch = m_onBatch;
+        lock.unlock();
+        try {
+            if (onBatch) onBatch(batch);
+        } catch (...) {
+            // Ein fehlerhafter Empfänger darf die Beobachtung nicht beenden
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ApplicationDiscovery.h"
+#include "../../Platform/IDirectoryWatcher.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Beobachtet die Verzeichnisquellen einer ApplicationDiscovery über den IDirectoryWatcher der
+// Plattform und fasst die rohen Meldungen zu ApplicationDiscovery::Changes zusammen: pro Eintrag
+// wird sein Verzeichnis als geändert vermerkt. Ein Stapel geht raus, wenn QUIET lang nichts
+// Neues kam, spätestens aber MAX_LATENCY nach der ersten Meldung; ein Installer, der hunderte
+// Dateien anlegt, löst so eine einzige Nachprüfung aus und der Katalog bleibt trotzdem aktuell.
+class CatalogWatcher {
+public:
+    using BatchCallback = std::function<void(const ApplicationDiscovery::Changes& changes)>;
+
+    static constexpr std::chrono::milliseconds QUIET{ 300 };
+    static constexpr std::chrono::milliseconds MAX_LATENCY{ 2000 };
+
+    CatalogWatcher() = default;
+    ~CatalogWatcher();
+
+    CatalogWatcher(const CatalogWatcher&) = delete;
+    CatalogWatcher& operator=(const CatalogWatcher&) = delete;
+
+    // onBatch läuft auf einem eigenen Thread. true, wenn alle Verzeichnisse beobachtet werden;
+    // nur dann entgeht den Stapeln nichts (außer sie melden overflow).
+    bool Start(const std::vector<ApplicationDiscovery::DirectorySource>& directories, BatchCallback onBatch);
+
+    // Beendet die Beobachtung; ein noch nicht zugestellter Stapel verfällt
+    void Stop();
+
+    // false, sobald eine Beobachtung fehlt oder dauerhaft ausgefallen ist (DirectoryChange::Stopped).
+    // Der Stapel mit dem Ausfall meldet overflow; danach entgehen den Stapeln Änderungen.
+    bool Complete() const { return m_complete.load(); }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    ApplicationDiscovery::Changes m_pending;
+    std::chrono::steady_clock::time_point m_firstChange;
+    std::chrono::steady_clock::time_point m_due;
+    bool m_stopping = false;
+    BatchCallback m_onBatch;
+    std::vector<IDirectoryWatcher::WatchId> m_watches;
+    std::atomic<bool> m_complete{ false };
+    std::thread m_dispatcher;
+
+    void OnChanges(const std::filesystem::path& root, const std::vector<DirectoryChange>& changes);
+    void DispatchLoop();
+};
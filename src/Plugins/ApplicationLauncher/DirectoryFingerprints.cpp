@@ -0,0 +1,220 @@
+#include "DirectoryFingerprints.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+const uint32_t kFingerprintMagic = 0x46445057; // "WPDF"
+const uint32_t kFingerprintVersion = 1;
+
+const uint64_t kFnvOffset = 14695981039346656037ull;
+const uint64_t kFnvPrime = 1099511628211ull;
+
+void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+}
+
+template <typename T>
+void HashValue(uint64_t& hash, T value) {
+    HashBytes(hash, &value, sizeof(value));
+}
+
+void HashString(uint64_t& hash, const std::wstring& text) {
+    HashValue(hash, static_cast<uint32_t>(text.size()));
+    HashBytes(hash, text.data(), text.size() * sizeof(wchar_t));
+}
+
+template <typename T>
+void AppendValue(std::string& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendString(std::string& buffer, const std::wstring& text) {
+    AppendValue(buffer, static_cast<uint32_t>(text.size()));
+    buffer.append(reinterpret_cast<const char*>(text.data()), text.size() * sizeof(wchar_t));
+}
+
+// Liest sequenziell aus den serialisierten Daten; false bei zu kurzen Daten
+class Reader {
+public:
+    explicit Reader(std::string_view data) : m_data(data) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (m_data.size() - m_offset < sizeof(T)) return false;
+        std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::wstring& text) {
+        uint32_t length = 0;
+        if (!Read(length) || (m_data.size() - m_offset) / sizeof(wchar_t) < length) return false;
+        text.resize(length);
+        std::memcpy(text.data(), m_data.data() + m_offset, length * sizeof(wchar_t));
+        m_offset += length * sizeof(wchar_t);
+        return true;
+    }
+
+    // Obergrenze für Zähler: jedes Element braucht mindestens minBytes
+    bool Fits(uint32_t count, size_t minBytes) const {
+        return (m_data.size() - m_offset) / minBytes >= count;
+    }
+
+    bool AtEnd() const { return m_offset == m_data.size(); }
+
+private:
+    std::string_view m_data;
+    size_t m_offset = 0;
+};
+
+} // namespace
+
+const DirectoryFingerprints::Directory* DirectoryFingerprints::Find(const std::wstring& path) const {
+    auto it = m_directories.find(path);
+    return it != m_directories.end() ? &it->second : nullptr;
+}
+
+void DirectoryFingerprints::Set(const std::wstring& path, Directory directory) {
+    m_directories[path] = std::move(directory);
+}
+
+void DirectoryFingerprints::ComputeHashes(const std::vector<std::wstring>& roots) {
+    for (auto& [path, directory] : m_directories) {
+        directory.treeHash = 0;
+    }
+
+    m_fingerprint = kFnvOffset;
+    for (const std::wstring& root : roots) {
+        HashString(m_fingerprint, root);
+        HashValue(m_fingerprint, HashTree(root));
+    }
+}
+
+uint64_t DirectoryFingerprints::HashTree(const std::wstring& path) {
+    auto it = m_directories.find(path);
+    if (it == m_directories.end()) {
+        return 0;
+    }
+    Directory& directory = it->second;
+    if (directory.treeHash != 0) {
+        return directory.treeHash;
+    }
+
+    uint64_t hash = kFnvOffset;
+    HashValue(hash, directory.modified);
+    HashValue(hash, directory.entryCount);
+    for (const auto& candidate : directory.candidates) {
+        HashString(hash, candidate.path);
+        HashString(hash, candidate.name);
+    }
+
+    // Unterverzeichnisse nach Namen, damit der Hash nicht von der Auflistung abhängt
+    std::vector<std::wstring> children = directory.children;
+    std::sort(children.begin(), children.end());
+    for (const std::wstring& child : children) {
+        HashString(hash, child);
+        HashValue(hash, HashTree((std::filesystem::path(path) / child).wstring()));
+    }
+
+    // 0 steht für "noch nicht berechnet"
+    if (hash == 0) hash = 1;
+    directory.treeHash = hash;
+    return hash;
+}
+
+std::string DirectoryFingerprints::Serialize() const {
+    // Nach Pfad sortiert, damit gleiche Bäume gleiche Bytes ergeben
+    std::vector<const std::pair<const std::wstring, Directory>*> entries;
+    entries.reserve(m_directories.size());
+    for (const auto& entry : m_directories) {
+        entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    std::string out;
+    AppendValue(out, kFingerprintMagic);
+    AppendValue(out, kFingerprintVersion);
+    AppendValue(out, m_fingerprint);
+    AppendValue(out, static_cast<uint32_t>(entries.size()));
+    for (const auto* entry : entries) {
+        const Directory& directory = entry->second;
+        AppendString(out, entry->first);
+        AppendValue(out, directory.modified);
+        AppendValue(out, directory.entryCount);
+        AppendValue(out, directory.treeHash);
+        AppendValue(out, static_cast<uint32_t>(directory.children.size()));
+        for (const std::wstring& child : directory.children) {
+            AppendString(out, child);
+        }
+        AppendValue(out, static_cast<uint32_t>(directory.candidates.size()));
+        for (const auto& candidate : directory.candidates) {
+            AppendString(out, candidate.name);
+            AppendString(out, candidate.path);
+            AppendString(out, candidate.description);
+            AppendString(out, candidate.publisher);
+            AppendString(out, candidate.version);
+            AppendValue(out, static_cast<uint8_t>(candidate.isUWP ? 1 : 0));
+        }
+    }
+    return out;
+}
+
+bool DirectoryFingerprints::Parse(std::string_view data, DirectoryFingerprints& fingerprints) {
+    fingerprints = DirectoryFingerprints();
+    Reader reader(data);
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t fingerprint = 0;
+    uint32_t directoryCount = 0;
+    if (!reader.Read(magic) || magic != kFingerprintMagic || !reader.Read(version) ||
+        version != kFingerprintVersion || !reader.Read(fingerprint) || !reader.Read(directoryCount) ||
+        !reader.Fits(directoryCount, sizeof(uint32_t))) {
+        return false;
+    }
+
+    DirectoryFingerprints parsed;
+    parsed.m_fingerprint = fingerprint;
+    parsed.m_directories.reserve(directoryCount);
+    for (uint32_t i = 0; i < directoryCount; ++i) {
+        std::wstring path;
+        Directory directory;
+        uint32_t childCount = 0;
+        uint32_t candidateCount = 0;
+        if (!reader.ReadString(path) || !reader.Read(directory.modified) || !reader.Read(directory.entryCount) ||
+            !reader.Read(directory.treeHash) || !reader.Read(childCount) || !reader.Fits(childCount, sizeof(uint32_t))) {
+            return false;
+        }
+        directory.children.resize(childCount);
+        for (std::wstring& child : directory.children) {
+            if (!reader.ReadString(child)) return false;
+        }
+
+        if (!reader.Read(candidateCount) || !reader.Fits(candidateCount, 5 * sizeof(uint32_t) + 1)) {
+            return false;
+        }
+        directory.candidates.resize(candidateCount);
+        for (auto& candidate : directory.candidates) {
+            uint8_t isUWP = 0;
+            if (!reader.ReadString(candidate.name) || !reader.ReadString(candidate.path) ||
+                !reader.ReadString(candidate.description) || !reader.ReadString(candidate.publisher) ||
+                !reader.ReadString(candidate.version) || !reader.Read(isUWP)) {
+                return false;
+            }
+            candidate.isUWP = isUWP != 0;
+        }
+        parsed.m_directories[path] = std::move(directory);
+    }
+
+    if (!reader.AtEnd()) {
+        return false;
+    }
+    fingerprints = std::move(parsed);
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ApplicationDiscovery.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Fingerabdruck-Baum über die Verzeichnisquellen einer ApplicationDiscovery.
+// Pro Verzeichnis: Änderungszeit, Anzahl der Einträge, ein Hash über den ganzen Teilbaum,
+// die Namen der Unterverzeichnisse und die direkt darin gefundenen Kandidaten.
+// Die Änderungszeit eines Verzeichnisses ändert sich, wenn darin ein Eintrag angelegt,
+// gelöscht oder umbenannt wird, nicht aber bei Änderungen tiefer im Baum. Ein neuer Lauf
+// fragt deshalb jedes bekannte Verzeichnis ab, liest aber nur die geänderten neu.
+class DirectoryFingerprints {
+public:
+    struct Directory {
+        int64_t modified = 0;
+        uint32_t entryCount = 0;
+        uint64_t treeHash = 0;
+        std::vector<std::wstring> children;  // Namen der Unterverzeichnisse
+        std::vector<ApplicationDiscovery::Candidate> candidates;
+    };
+
+    const Directory* Find(const std::wstring& path) const;
+    void Set(const std::wstring& path, Directory directory);
+    size_t Size() const { return m_directories.size(); }
+    bool Empty() const { return m_directories.empty(); }
+
+    // Berechnet die Teilbaum-Hashes unterhalb der Wurzeln; Fingerprint() fasst die
+    // Wurzeln in ihrer Reihenfolge zusammen. Gleicher Fingerprint heißt gleiche Bäume.
+    void ComputeHashes(const std::vector<std::wstring>& roots);
+    uint64_t Fingerprint() const { return m_fingerprint; }
+
+    std::string Serialize() const;
+
+    // false bei beschädigten oder abgeschnittenen Daten; fingerprints bleibt dann leer
+    static bool Parse(std::string_view data, DirectoryFingerprints& fingerprints);
+
+private:
+    std::unordered_map<std::wstring, Directory> m_directories;
+    uint64_t m_fingerprint = 0;
+
+    uint64_t HashTree(const std::wstring& path);
+};
@@ -42,17 +42,8 @@ std::vector<ApplicationInfo> GenericLaunchCommand::GetMatchingApplications() con
         return {};
     }
     
-    auto results = m_applicationFinder.FindApplications(m_currentSearchTerm);
-    
-    // Ensure all applications have icons loaded
-    for (auto& app : results) {
-        if (!app.hIcon) {
-            // If icon is not loaded, try to load it now (non-const operation)
-            // This is a workaround since we can't modify the finder here
-        }
-    }
-    
-    return results;
+    // Icons lädt der IconCache erst beim Zeichnen
+    return m_applicationFinder.FindApplications(m_currentSearchTerm);
 }
 
 void GenericLaunchCommand::LaunchApplication(const ApplicationInfo& app) {
@@ -0,0 +1,427 @@
+#include "IconCache.h"
+#include "ApplicationFinder.h"
+#include "../../Platform/PlatformServices.h"
+#include "../../Storage/PersistenceService.h"
+#include <windows.h>
+#include <shellapi.h>
+#include <shlobj.h>
+#include <objbase.h>
+#include <objidl.h>
+#include <shlguid.h>
+#include <algorithm>
+#include <cstring>
+#include <cwctype>
+#include <filesystem>
+
+#pragma comment(lib, "shell32.lib")
+#pragma comment(lib, "ole32.lib")
+
+namespace {
+
+// Feste Icons aus shell32.dll für Einträge ohne eigene Datei
+constexpr int SHELL32_STORE_ICON = 15;
+constexpr int SHELL32_SETTINGS_ICON = 316;
+constexpr int SHELL32_APPLICATION_ICON = 2;
+
+HICON ExtractIconFromFile(const std::wstring& filePath) {
+    if (filePath.empty() || !std::filesystem::exists(filePath)) {
+        return nullptr;
+    }
+
+    // Try to extract large icon first (32x32)
+    HICON hIconLarge = nullptr;
+    HICON hIconSmall = nullptr;
+
+    UINT iconCount = ExtractIconExW(filePath.c_str(), -1, &hIconLarge, &hIconSmall, 1);
+    if (iconCount > 0) {
+        ExtractIconExW(filePath.c_str(), 0, &hIconLarge, &hIconSmall, 1);
+
+        // Prefer large icon, fallback to small
+        if (hIconLarge) {
+            if (hIconSmall) DestroyIcon(hIconSmall);
+            return hIconLarge;
+        } else if (hIconSmall) {
+            return hIconSmall;
+        }
+    }
+
+    // Fallback: try using LoadImage
+    HICON hIcon = static_cast<HICON>(LoadImageW(
+        nullptr,
+        filePath.c_str(),
+        IMAGE_ICON,
+        32, 32,
+        LR_LOADFROMFILE | LR_DEFAULTSIZE
+    ));
+
+    return hIcon;
+}
+
+// COM ist auf dem Icon-Thread bereits initialisiert
+HICON ExtractIconFromShortcut(const std::wstring& lnkPath) {
+    if (lnkPath.empty() || !std::filesystem::exists(lnkPath)) {
+        return nullptr;
+    }
+
+    IShellLinkW* pShellLink = nullptr;
+    HRESULT hr = CoCreateInstance(CLSID_ShellLink, nullptr, CLSCTX_INPROC_SERVER,
+                                  IID_IShellLinkW, reinterpret_cast<void**>(&pShellLink));
+    if (FAILED(hr)) {
+        return nullptr;
+    }
+
+    IPersistFile* pPersistFile = nullptr;
+    hr = pShellLink->QueryInterface(IID_IPersistFile, reinterpret_cast<void**>(&pPersistFile));
+    if (FAILED(hr)) {
+        pShellLink->Release();
+        return nullptr;
+    }
+
+    hr = pPersistFile->Load(lnkPath.c_str(), STGM_READ);
+    if (FAILED(hr)) {
+        pPersistFile->Release();
+        pShellLink->Release();
+        return nullptr;
+    }
+
+    wchar_t targetPath[MAX_PATH] = {};
+    wchar_t iconPath[MAX_PATH] = {};
+    int iconIndex = 0;
+
+    // Get target path
+    pShellLink->GetPath(targetPath, MAX_PATH, nullptr, SLGP_UNCPRIORITY);
+
+    // Get icon information
+    pShellLink->GetIconLocation(iconPath, MAX_PATH, &iconIndex);
+
+    pPersistFile->Release();
+    pShellLink->Release();
+
+    HICON hIcon = nullptr;
+
+    // Try to extract from specified icon path first
+    if (wcslen(iconPath) > 0 && std::filesystem::exists(iconPath)) {
+        HICON hIconLarge = nullptr;
+        HICON hIconSmall = nullptr;
+        UINT count = ExtractIconExW(iconPath, iconIndex, &hIconLarge, &hIconSmall, 1);
+        if (count > 0) {
+            hIcon = hIconLarge ? hIconLarge : hIconSmall;
+            if (hIconLarge && hIconSmall && hIconLarge != hIconSmall) {
+                DestroyIcon(hIconSmall);
+            }
+        }
+    }
+
+    // Fallback to target executable
+    if (!hIcon && wcslen(targetPath) > 0) {
+        hIcon = ExtractIconFromFile(targetPath);
+    }
+
+    return hIcon;
+}
+
+HICON GetSystemIcon(const std::wstring& fileName) {
+    SHFILEINFOW sfi = {};
+    DWORD_PTR result = SHGetFileInfoW(
+        fileName.c_str(),
+        FILE_ATTRIBUTE_NORMAL,
+        &sfi,
+        sizeof(sfi),
+        SHGFI_ICON | SHGFI_LARGEICON | SHGFI_USEFILEATTRIBUTES
+    );
+
+    return result ? sfi.hIcon : nullptr;
+}
+
+HICON LoadIconForKey(const IconKey& key) {
+    HICON hIcon = nullptr;
+
+    if (key.index != 0) {
+        // Bestimmte Ressource eines Moduls
+        ExtractIconExW(key.path.c_str(), key.index, &hIcon, nullptr, 1);
+    } else {
+        std::wstring extension = std::filesystem::path(key.path).extension().wstring();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::towlower);
+
+        if (extension == L".lnk") {
+            // Handle shortcuts
+            hIcon = ExtractIconFromShortcut(key.path);
+        } else if (extension == L".exe" || extension == L".com" || extension == L".scr") {
+            // Handle executables
+            hIcon = ExtractIconFromFile(key.path);
+        } else if (extension == L".msc" || extension == L".cpl") {
+            // Handle system management tools
+            hIcon = GetSystemIcon(key.path);
+        } else {
+            // Try to find executable in system paths
+            std::wstring fullPath = key.path;
+            if (!std::filesystem::exists(fullPath)) {
+                // Search in System32
+                std::wstring system32Path = L"C:\\Windows\\System32\\" + key.path;
+                if (std::filesystem::exists(system32Path)) {
+                    fullPath = system32Path;
+                } else {
+                    // Search in Windows directory
+                    std::wstring windowsPath = L"C:\\Windows\\" + key.path;
+                    if (std::filesystem::exists(windowsPath)) {
+                        fullPath = windowsPath;
+                    }
+                }
+            }
+
+            if (std::filesystem::exists(fullPath)) {
+                hIcon = ExtractIconFromFile(fullPath);
+            } else {
+                // Use system icon for the file type
+                hIcon = GetSystemIcon(key.path);
+            }
+        }
+    }
+
+    // Fallback to default application icon
+    if (!hIcon) {
+        ExtractIconExW(L"shell32.dll", SHELL32_APPLICATION_ICON, &hIcon, nullptr, 1);
+    }
+    return hIcon;
+}
+
+// Speicherbedarf der Farb- und Maskenbitmap
+size_t IconBytes(HICON icon) {
+    ICONINFO info = {};
+    if (!icon || !GetIconInfo(icon, &info)) return 0;
+
+    size_t bytes = 0;
+    for (HBITMAP bitmap : { info.hbmColor, info.hbmMask }) {
+        if (!bitmap) continue;
+        BITMAP bm = {};
+        if (GetObjectW(bitmap, sizeof(bm), &bm)) {
+            bytes += static_cast<size_t>(bm.bmWidthBytes) * static_cast<size_t>(bm.bmHeight);
+        }
+        DeleteObject(bitmap);
+    }
+    return bytes;
+}
+
+// Änderungszeit und Größe für den Thumbnail-Schlüssel; fehlt die Datei, bleibt beides 0
+void GetFileStamp(const std::wstring& path, int64_t& modifiedTime, uint64_t& fileSize) {
+    WIN32_FILE_ATTRIBUTE_DATA data = {};
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data)) {
+        modifiedTime = 0;
+        fileSize = 0;
+        return;
+    }
+    modifiedTime = (int64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+    fileSize = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+}
+
+// Liest ein Bitmap als 32-Bit-BGRA von oben nach unten
+bool ReadBitmapPixels(HDC hdc, HBITMAP bitmap, uint32_t width, uint32_t height, std::vector<uint8_t>& pixels) {
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = static_cast<LONG>(width);
+    bmi.bmiHeader.biHeight = -static_cast<LONG>(height);
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    pixels.resize(size_t(width) * height * 4);
+    return GetDIBits(hdc, bitmap, 0, height, pixels.data(), &bmi, DIB_RGB_COLORS) == static_cast<int>(height);
+}
+
+// Rastert ein Icon auf die Thumbnail-Größe; einfarbige Icons ohne Farb-Bitmap werden übersprungen
+bool RasterizeIcon(HICON icon, uint8_t* thumbnail) {
+    ICONINFO info = {};
+    if (!GetIconInfo(icon, &info)) return false;
+
+    bool ok = false;
+    BITMAP bm = {};
+    if (info.hbmColor && GetObjectW(info.hbmColor, sizeof(bm), &bm) && bm.bmWidth > 0 && bm.bmHeight > 0) {
+        uint32_t width = static_cast<uint32_t>(bm.bmWidth);
+        uint32_t height = static_cast<uint32_t>(bm.bmHeight);
+        std::vector<uint8_t> color;
+        std::vector<uint8_t> mask;
+        HDC hdc = GetDC(nullptr);
+        if (ReadBitmapPixels(hdc, info.hbmColor, width, height, color)) {
+            bool hasMask = info.hbmMask && ReadBitmapPixels(hdc, info.hbmMask, width, height, mask);
+            ok = IconThumbnailStore::Rasterize(color.data(), hasMask ? mask.data() : nullptr, width, height, thumbnail);
+        }
+        ReleaseDC(nullptr, hdc);
+    }
+
+    if (info.hbmColor) DeleteObject(info.hbmColor);
+    if (info.hbmMask) DeleteObject(info.hbmMask);
+    return ok;
+}
+
+HICON CreateIconFromThumbnail(const uint8_t* thumbnail) {
+    const int size = static_cast<int>(IconThumbnailStore::ICON_SIZE);
+
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = size;
+    bmi.bmiHeader.biHeight = -size;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    HBITMAP color = CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (!color || !bits) {
+        if (color) DeleteObject(color);
+        return nullptr;
+    }
+    std::memcpy(bits, thumbnail, IconThumbnailStore::PIXEL_BYTES);
+
+    // Leere AND-Maske: die Deckkraft steckt im Alphakanal
+    std::vector<uint8_t> maskBits(size_t(size) * size / 8, 0);
+    HBITMAP mask = CreateBitmap(size, size, 1, 1, maskBits.data());
+
+    ICONINFO info = {};
+    info.fIcon = TRUE;
+    info.hbmColor = color;
+    info.hbmMask = mask;
+    HICON icon = mask ? CreateIconIndirect(&info) : nullptr;
+
+    DeleteObject(color);
+    if (mask) DeleteObject(mask);
+    return icon;
+}
+
+} // namespace
+
+IconCache& IconCache::Instance() {
+    static IconCache instance;
+    return instance;
+}
+
+IconCache::IconCache()
+    : m_icons(BYTE_BUDGET),
+      m_thumbnailPath(PlatformServices::Instance().FileSystem().GetCacheDirectory() / L"icons.bin"),
+      m_persistence(PersistenceService::Instance()) {
+    m_worker = std::thread([this]() { WorkerLoop(); });
+}
+
+IconCache::~IconCache() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+    m_persistence.Flush(m_thumbnailPath);
+}
+
+void IconCache::SetReadyCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_readyCallback = std::move(callback);
+}
+
+HICON IconCache::Request(const IconKey& key) {
+    std::vector<LoadedIcon> loaded;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        loaded.swap(m_loaded);
+        for (const LoadedIcon& icon : loaded) {
+            m_pending.erase(icon.key);
+        }
+    }
+    // Fertige Icons erst hier übernehmen, damit nur der UI-Thread verdrängt
+    for (LoadedIcon& icon : loaded) {
+        m_icons.Put(icon.key, std::move(icon.icon), icon.bytes);
+    }
+
+    if (IconHandle* cached = m_icons.Find(key)) {
+        return cached->get();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_pending.insert(key).second) {
+            return nullptr;
+        }
+        m_queue.push_back(key);
+        if (m_queue.size() > MAX_QUEUED_REQUESTS) {
+            m_pending.erase(m_queue.front());
+            m_queue.pop_front();
+        }
+    }
+    m_condition.notify_one();
+    return nullptr;
+}
+
+IconKey IconCache::KeyFor(const ApplicationInfo& app) {
+    if (app.isUWP || app.path.find(L"ms-windows-store:") != std::wstring::npos) {
+        return { L"shell32.dll", SHELL32_STORE_ICON };
+    }
+    if (app.path.find(L"ms-settings:") != std::wstring::npos) {
+        return { L"shell32.dll", SHELL32_SETTINGS_ICON };
+    }
+    return { app.iconPath.empty() ? app.path : app.iconPath, 0 };
+}
+
+void IconCache::WorkerLoop() {
+    // Einmal pro Thread statt pro Verknüpfung
+    HRESULT comResult = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
+
+    // Bereits gerasterte Icons früherer Sitzungen einblenden
+    m_thumbnails.Open(m_thumbnailPath);
+
+    while (true) {
+        IconKey key;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) break;
+            // Neueste Anforderung zuerst: das sind die gerade sichtbaren Treffer
+            key = std::move(m_queue.back());
+            m_queue.pop_back();
+        }
+
+        HICON icon = nullptr;
+        try {
+            icon = ResolveIcon(key);
+        }
+        catch (...) {
+            // Ohne Icon weiter, der Eintrag zeigt dann das Kategorie-Symbol
+        }
+        size_t bytes = std::max(IconBytes(icon), MISSING_ICON_BYTES);
+
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_loaded.push_back({ std::move(key), IconHandle(icon), bytes });
+            callback = m_readyCallback;
+        }
+        if (callback) {
+            callback();
+        }
+    }
+
+    if (SUCCEEDED(comResult)) {
+        CoUninitialize();
+    }
+}
+
+HICON IconCache::ResolveIcon(const IconKey& key) {
+    int64_t modifiedTime = 0;
+    uint64_t fileSize = 0;
+    GetFileStamp(key.path, modifiedTime, fileSize);
+    uint64_t thumbnailKey = IconThumbnailStore::MakeKey(key.path, key.index, modifiedTime, fileSize);
+
+    // Schon einmal gerastert: ohne COM und ohne Icon-Extraktion
+    std::vector<uint8_t> thumbnail(IconThumbnailStore::PIXEL_BYTES);
+    if (m_thumbnails.Find(thumbnailKey, thumbnail.data())) {
+        if (HICON icon = CreateIconFromThumbnail(thumbnail.data())) {
+            return icon;
+        }
+    }
+
+    HICON icon = LoadIconForKey(key);
+    if (icon && RasterizeIcon(icon, thumbnail.data())) {
+        m_thumbnails.Add(thumbnailKey, thumbnail.data());
+        m_persistence.ScheduleWrite(m_thumbnailPath, [this]() { return m_thumbnails.Serialize(); });
+    }
+    return icon;
+}
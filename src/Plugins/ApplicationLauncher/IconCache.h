@@ -0,0 +1,103 @@
+#pragma once
+
+#include <windows.h>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+#include "../../Storage/LruCache.h"
+#include "IconThumbnailStore.h"
+
+struct ApplicationInfo;
+class PersistenceService;
+
+// Herkunft eines Icons: Datei plus Ressourcenindex.
+// Index 0 bedeutet "Icon der Datei selbst" (bei Verknüpfungen das Icon des Ziels).
+struct IconKey {
+    std::wstring path;
+    int index = 0;
+
+    bool operator==(const IconKey& other) const { return index == other.index && path == other.path; }
+};
+
+struct IconKeyHash {
+    size_t operator()(const IconKey& key) const {
+        return std::hash<std::wstring>()(key.path) * 31 + static_cast<size_t>(key.index);
+    }
+};
+
+// Lädt Anwendungs-Icons erst, wenn ein Treffer tatsächlich gezeichnet wird.
+// Request liefert ein bereits geladenes Icon sofort, sonst nullptr; das Icon wird dann auf
+// einem eigenen Hintergrund-Thread extrahiert (COM und ExtractIconExW) und der Ready-Callback
+// meldet, dass neu gezeichnet werden kann.
+// Geladene Icons liegen in einem LRU-Cache mit Byte-Budget. Übernommen und verdrängt wird nur
+// in Request auf dem UI-Thread; ein geliefertes Icon bleibt bis zum nächsten Request gültig.
+// Vor dem Extrahieren schaut der Icon-Thread in den IconThumbnailStore (icons.bin); neu
+// extrahierte Icons landen dort gerastert und werden über den PersistenceService gespeichert.
+class IconCache {
+public:
+    static IconCache& Instance();
+
+    // Der Callback läuft auf dem Icon-Thread
+    void SetReadyCallback(std::function<void()> callback);
+
+    // Nur auf dem UI-Thread aufrufen
+    HICON Request(const IconKey& key);
+
+    // Icon-Quelle einer Anwendung, ohne die Datei anzufassen
+    static IconKey KeyFor(const ApplicationInfo& app);
+
+private:
+    IconCache();
+    ~IconCache();
+
+    IconCache(const IconCache&) = delete;
+    IconCache& operator=(const IconCache&) = delete;
+
+    struct IconDeleter {
+        void operator()(HICON icon) const { DestroyIcon(icon); }
+    };
+    using IconHandle = std::unique_ptr<std::remove_pointer_t<HICON>, IconDeleter>;
+
+    struct LoadedIcon {
+        IconKey key;
+        IconHandle icon;
+        size_t bytes;
+    };
+
+    // Reicht für einige hundert 32x32-Icons; sichtbar sind höchstens MAX_SEARCH_RESULTS
+    static constexpr size_t BYTE_BUDGET = 2 * 1024 * 1024;
+    // Ältere Anforderungen verfallen, wenn schneller getippt als geladen wird
+    static constexpr size_t MAX_QUEUED_REQUESTS = 64;
+    // Kosten eines Eintrags ohne Icon, damit Fehlschläge nicht erneut geladen werden
+    static constexpr size_t MISSING_ICON_BYTES = 64;
+
+    // Nur UI-Thread
+    LruCache<IconKey, IconHandle, IconKeyHash> m_icons;
+
+    // Geteilt mit dem Icon-Thread
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<IconKey> m_queue;
+    std::unordered_set<IconKey, IconKeyHash> m_pending;
+    std::vector<LoadedIcon> m_loaded;
+    std::function<void()> m_readyCallback;
+    bool m_stopping = false;
+
+    // Nur Icon-Thread (Serialize läuft zusätzlich auf dem Persistenz-Thread, der Store sperrt selbst)
+    IconThumbnailStore m_thumbnails;
+    std::filesystem::path m_thumbnailPath;
+    PersistenceService& m_persistence;
+
+    std::thread m_worker;
+
+    void WorkerLoop();
+    HICON ResolveIcon(const IconKey& key);
+};
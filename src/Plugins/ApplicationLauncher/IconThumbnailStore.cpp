@@ -0,0 +1,262 @@
+#include "IconThumbnailStore.h"
+
+#include "../../Platform/PlatformServices.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const uint32_t kStoreMagic = 0x43495057; // "WPIC"
+const uint32_t kStoreVersion = 1;
+
+const uint64_t kFnvOffset = 14695981039346656037ull;
+const uint64_t kFnvPrime = 1099511628211ull;
+
+void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+}
+
+template <typename T>
+void HashValue(uint64_t& hash, T value) {
+    HashBytes(hash, &value, sizeof(value));
+}
+
+} // namespace
+
+uint64_t IconThumbnailStore::MakeKey(std::wstring_view path, int index, int64_t modifiedTime, uint64_t fileSize) {
+    // Windows-Pfade sind unabhängig von Groß/Kleinschreibung; ASCII genügt für den Schlüssel
+    uint64_t hash = kFnvOffset;
+    for (wchar_t c : path) {
+        if (c >= L'A' && c <= L'Z') c = static_cast<wchar_t>(c - L'A' + L'a');
+        HashValue(hash, static_cast<uint32_t>(c));
+    }
+    HashValue(hash, static_cast<int32_t>(index));
+    HashValue(hash, modifiedTime);
+    HashValue(hash, fileSize);
+    return hash;
+}
+
+uint64_t IconThumbnailStore::ContentHash(const uint8_t* thumbnail) {
+    uint64_t hash = kFnvOffset;
+    HashBytes(hash, thumbnail, PIXEL_BYTES);
+    return hash;
+}
+
+bool IconThumbnailStore::Rasterize(const uint8_t* color, const uint8_t* mask, uint32_t width, uint32_t height,
+                                   uint8_t* thumbnail) {
+    if (!color || width == 0 || height == 0) {
+        return false;
+    }
+
+    // Alte Icons ohne Alphakanal: Deckkraft aus der AND-Maske
+    size_t pixelCount = size_t(width) * height;
+    bool hasAlpha = false;
+    for (size_t i = 0; i < pixelCount && !hasAlpha; ++i) {
+        hasAlpha = color[i * 4 + 3] != 0;
+    }
+    auto alphaAt = [&](size_t i) -> uint32_t {
+        if (hasAlpha) return color[i * 4 + 3];
+        if (mask) return mask[i * 4] ? 0 : 255;
+        return 255;
+    };
+
+    for (uint32_t y = 0; y < ICON_SIZE; ++y) {
+        uint32_t y0 = y * height / ICON_SIZE;
+        uint32_t y1 = std::max(y0 + 1, (y + 1) * height / ICON_SIZE);
+        for (uint32_t x = 0; x < ICON_SIZE; ++x) {
+            uint32_t x0 = x * width / ICON_SIZE;
+            uint32_t x1 = std::max(x0 + 1, (x + 1) * width / ICON_SIZE);
+
+            // Farben mit Alpha gewichten, sonst färben durchsichtige Pixel die Kanten ein
+            uint64_t b = 0, g = 0, r = 0, a = 0, n = 0;
+            for (uint32_t sy = y0; sy < y1; ++sy) {
+                for (uint32_t sx = x0; sx < x1; ++sx) {
+                    size_t i = size_t(sy) * width + sx;
+                    uint32_t alpha = alphaAt(i);
+                    b += uint64_t(color[i * 4]) * alpha;
+                    g += uint64_t(color[i * 4 + 1]) * alpha;
+                    r += uint64_t(color[i * 4 + 2]) * alpha;
+                    a += alpha;
+                    ++n;
+                }
+            }
+
+            uint8_t* out = thumbnail + (size_t(y) * ICON_SIZE + x) * 4;
+            if (a == 0) {
+                std::memset(out, 0, 4);
+                continue;
+            }
+            out[0] = static_cast<uint8_t>((b + a / 2) / a);
+            out[1] = static_cast<uint8_t>((g + a / 2) / a);
+            out[2] = static_cast<uint8_t>((r + a / 2) / a);
+            out[3] = static_cast<uint8_t>((a + n / 2) / n);
+        }
+    }
+    return true;
+}
+
+bool IconThumbnailStore::Open(const std::filesystem::path& path) {
+    std::unique_ptr<IMappedFile> file = PlatformServices::Instance().FileSystem().MapReadOnly(path);
+    if (!file || file->Size() < sizeof(Header)) {
+        return false;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(file->Data());
+    if (header->magic != kStoreMagic || header->version != kStoreVersion || header->iconSize != ICON_SIZE) {
+        return false;
+    }
+
+    uint64_t entriesOffset = sizeof(Header);
+    uint64_t blocksOffset = entriesOffset + uint64_t(header->entryCount) * sizeof(Entry);
+    if (blocksOffset + uint64_t(header->blockCount) * PIXEL_BYTES != file->Size()) {
+        return false;
+    }
+
+    // Sortierung und Blockverweise prüfen, sonst liefe Find ins Leere
+    const Entry* entries = reinterpret_cast<const Entry*>(file->Data() + entriesOffset);
+    for (uint32_t i = 0; i < header->entryCount; ++i) {
+        if (entries[i].block >= header->blockCount || (i > 0 && entries[i - 1].key >= entries[i].key)) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries = entries;
+    m_blocks = reinterpret_cast<const uint8_t*>(file->Data() + blocksOffset);
+    m_entryCount = header->entryCount;
+    m_blockCount = header->blockCount;
+    m_usedMapped.clear();
+    m_file = std::move(file);
+    return true;
+}
+
+const IconThumbnailStore::Entry* IconThumbnailStore::FindMapped(uint64_t key) const {
+    const Entry* end = m_entries + m_entryCount;
+    const Entry* it = std::lower_bound(m_entries, end, key,
+                                       [](const Entry& entry, uint64_t value) { return entry.key < value; });
+    return it != end && it->key == key ? it : nullptr;
+}
+
+bool IconThumbnailStore::Find(uint64_t key, uint8_t* thumbnail) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto owned = m_owned.find(key);
+    if (owned != m_owned.end()) {
+        owned->second.used = true;
+        std::memcpy(thumbnail, &m_ownedBlocks[size_t(owned->second.block) * PIXEL_BYTES], PIXEL_BYTES);
+        return true;
+    }
+    if (const Entry* entry = FindMapped(key)) {
+        m_usedMapped.insert(key);
+        std::memcpy(thumbnail, m_blocks + size_t(entry->block) * PIXEL_BYTES, PIXEL_BYTES);
+        return true;
+    }
+    return false;
+}
+
+void IconThumbnailStore::Add(uint64_t key, const uint8_t* thumbnail) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_owned[key] = { StoreBlockLocked(thumbnail), true };
+}
+
+size_t IconThumbnailStore::Size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t size = m_owned.size();
+    for (uint32_t i = 0; i < m_entryCount; ++i) {
+        if (m_owned.find(m_entries[i].key) == m_owned.end()) ++size;
+    }
+    return size;
+}
+
+uint32_t IconThumbnailStore::StoreBlockLocked(const uint8_t* thumbnail) {
+    // Gleiches Bild (z. B. dasselbe Standard-Icon vieler Verknüpfungen) nur einmal ablegen
+    uint64_t hash = ContentHash(thumbnail);
+    auto it = m_blockByContent.find(hash);
+    if (it != m_blockByContent.end() &&
+        std::memcmp(&m_ownedBlocks[size_t(it->second) * PIXEL_BYTES], thumbnail, PIXEL_BYTES) == 0) {
+        return it->second;
+    }
+
+    uint32_t block = static_cast<uint32_t>(m_ownedBlocks.size() / PIXEL_BYTES);
+    m_ownedBlocks.insert(m_ownedBlocks.end(), thumbnail, thumbnail + PIXEL_BYTES);
+    m_blockByContent.emplace(hash, block);
+    return block;
+}
+
+void IconThumbnailStore::DetachLocked() {
+    if (!m_file) return;
+
+    for (uint32_t i = 0; i < m_entryCount; ++i) {
+        const Entry& entry = m_entries[i];
+        if (m_owned.find(entry.key) != m_owned.end()) continue;
+        bool used = m_usedMapped.count(entry.key) != 0;
+        m_owned[entry.key] = { StoreBlockLocked(m_blocks + size_t(entry.block) * PIXEL_BYTES), used };
+    }
+
+    m_entries = nullptr;
+    m_blocks = nullptr;
+    m_entryCount = 0;
+    m_blockCount = 0;
+    m_usedMapped.clear();
+    m_file.reset();
+}
+
+std::string IconThumbnailStore::Serialize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DetachLocked();
+
+    // Benutzte Einträge haben Vorrang, danach die übrigen bis zur Obergrenze
+    std::vector<std::pair<uint64_t, OwnedEntry>> kept(m_owned.begin(), m_owned.end());
+    std::stable_partition(kept.begin(), kept.end(),
+                          [](const std::pair<uint64_t, OwnedEntry>& entry) { return entry.second.used; });
+    if (kept.size() > MAX_ENTRIES) {
+        kept.resize(MAX_ENTRIES);
+    }
+    std::sort(kept.begin(), kept.end(),
+              [](const std::pair<uint64_t, OwnedEntry>& a, const std::pair<uint64_t, OwnedEntry>& b) {
+                  return a.first < b.first;
+              });
+
+    // Speicher auf den geschriebenen Stand verdichten; Blöcke ohne Eintrag fallen weg
+    std::vector<uint8_t> blocks;
+    std::unordered_map<uint32_t, uint32_t> blockMap;
+    std::unordered_map<uint64_t, OwnedEntry> owned;
+    for (auto& [key, entry] : kept) {
+        auto it = blockMap.find(entry.block);
+        if (it == blockMap.end()) {
+            it = blockMap.emplace(entry.block, static_cast<uint32_t>(blocks.size() / PIXEL_BYTES)).first;
+            const uint8_t* pixels = &m_ownedBlocks[size_t(entry.block) * PIXEL_BYTES];
+            blocks.insert(blocks.end(), pixels, pixels + PIXEL_BYTES);
+        }
+        entry.block = it->second;
+        owned.emplace(key, entry);
+    }
+    m_owned = std::move(owned);
+    m_ownedBlocks = std::move(blocks);
+    m_blockByContent.clear();
+    for (uint32_t block = 0; block < m_ownedBlocks.size() / PIXEL_BYTES; ++block) {
+        m_blockByContent.emplace(ContentHash(&m_ownedBlocks[size_t(block) * PIXEL_BYTES]), block);
+    }
+
+    Header header = {};
+    header.magic = kStoreMagic;
+    header.version = kStoreVersion;
+    header.iconSize = ICON_SIZE;
+    header.entryCount = static_cast<uint32_t>(kept.size());
+    header.blockCount = static_cast<uint32_t>(m_ownedBlocks.size() / PIXEL_BYTES);
+
+    std::string out(sizeof(Header) + kept.size() * sizeof(Entry) + m_ownedBlocks.size(), '\0');
+    std::memcpy(&out[0], &header, sizeof(Header));
+    size_t offset = sizeof(Header);
+    for (const auto& [key, entry] : kept) {
+        Entry record = { key, entry.block, 0 };
+        std::memcpy(&out[offset], &record, sizeof(Entry));
+        offset += sizeof(Entry);
+    }
+    if (!m_ownedBlocks.empty()) {
+        std::memcpy(&out[offset], m_ownedBlocks.data(), m_ownedBlocks.size());
+    }
+    return out;
+}
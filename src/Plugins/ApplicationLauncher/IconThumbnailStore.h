@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../../Platform/IFileSystem.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Persistenter Icon-Cache (icons.bin) mit vorgerasterten 32x32-Thumbnails (BGRA, nicht
+// vormultipliziertes Alpha, Zeilen von oben nach unten).
+// Schlüssel ist ein Hash aus Icon-Quelle, Ressourcenindex, Änderungszeit und Größe der Datei;
+// ändert sich die Datei, entsteht ein neuer Schlüssel und der alte Eintrag läuft aus.
+// Die Pixelblöcke sind inhaltsadressiert: Einträge mit identischem Bild teilen sich einen Block.
+// Aufbau, eingeblendet statt gelesen:
+//   Header | Entry[entryCount] nach Schlüssel sortiert | Pixelblock[blockCount]
+// Thread-sicher; Find kopiert die Pixel, damit Serialize die Einblendung jederzeit freigeben kann.
+class IconThumbnailStore {
+public:
+    static constexpr uint32_t ICON_SIZE = 32;
+    static constexpr size_t PIXEL_BYTES = ICON_SIZE * ICON_SIZE * 4;
+    static constexpr size_t MAX_ENTRIES = 4096;
+
+    static uint64_t MakeKey(std::wstring_view path, int index, int64_t modifiedTime, uint64_t fileSize);
+
+    // Rechnet ein Icon-Bitmap beliebiger Größe auf ICON_SIZE um (Flächenmittel, beim Vergrößern
+    // nächster Nachbar). color ist BGRA von oben nach unten; trägt es kein Alpha, liefert die
+    // AND-Maske (ebenfalls BGRA, gesetzt = durchsichtig) die Deckkraft. mask darf nullptr sein.
+    static bool Rasterize(const uint8_t* color, const uint8_t* mask, uint32_t width, uint32_t height,
+                          uint8_t* thumbnail);
+
+    // Blendet die Datei ein; false, wenn sie fehlt oder nicht zu ihren Zählern passt
+    bool Open(const std::filesystem::path& path);
+
+    // Kopiert PIXEL_BYTES nach thumbnail
+    bool Find(uint64_t key, uint8_t* thumbnail);
+    void Add(uint64_t key, const uint8_t* thumbnail);
+    size_t Size() const;
+
+    // Dateiinhalt: in dieser Sitzung benutzte Einträge zuerst, dann die übrigen bis MAX_ENTRIES.
+    // Gibt die Einblendung frei (die Datei lässt sich sonst unter Windows nicht ersetzen).
+    std::string Serialize();
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t iconSize;
+        uint32_t entryCount;
+        uint32_t blockCount;
+        uint32_t reserved;
+    };
+
+    struct Entry {
+        uint64_t key;
+        uint32_t block;
+        uint32_t reserved;
+    };
+
+    struct OwnedEntry {
+        uint32_t block;
+        bool used;
+    };
+
+    mutable std::mutex m_mutex;
+
+    // Eingeblendete Datei
+    std::unique_ptr<IMappedFile> m_file;
+    const Entry* m_entries = nullptr;
+    const uint8_t* m_blocks = nullptr;
+    uint32_t m_entryCount = 0;
+    uint32_t m_blockCount = 0;
+    std::unordered_set<uint64_t> m_usedMapped;
+
+    // Neue und aus der Datei übernommene Einträge
+    std::unordered_map<uint64_t, OwnedEntry> m_owned;
+    std::vector<uint8_t> m_ownedBlocks;
+    std::unordered_map<uint64_t, uint32_t> m_blockByContent;
+
+    const Entry* FindMapped(uint64_t key) const;
+    uint32_t StoreBlockLocked(const uint8_t* thumbnail);
+    void DetachLocked();
+    static uint64_t ContentHash(const uint8_t* thumbnail);
+};
@@ -0,0 +1,35 @@
+#include "LaunchApplicationCommand.h"
+#include "IconCache.h"
+#include "../../Platform/PlatformServices.h"
+#include <thread>
+
+LaunchApplicationCommand::LaunchApplicationCommand(const ApplicationInfo& app)
+    : m_app(app) {
+}
+
+std::wstring LaunchApplicationCommand::GetName() const {
+    return m_app.name;
+}
+
+std::wstring LaunchApplicationCommand::GetDescription() const {
+    return m_app.description.empty() ? m_app.path : m_app.description;
+}
+
+CommandCategory LaunchApplicationCommand::GetCategory() const {
+    return CommandCategory::APPLICATION_LAUNCHER;
+}
+
+HICON LaunchApplicationCommand::GetIcon() const {
+    return IconCache::Instance().Request(IconCache::KeyFor(m_app));
+}
+
+void LaunchApplicationCommand::Execute() {
+    // Werte kopieren: Der Command kann mit der nächsten Suche verschwinden
+    std::thread([path = m_app.path, name = m_app.name]() {
+        ILauncher& launcher = PlatformServices::Instance().Launcher();
+        if (!launcher.Open(path)) {
+            // Falls der Pfad nicht startet, über den Namen versuchen
+            launcher.Open(name);
+        }
+    }).detach();
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../../Commands/ICommand.h"
+#include "ApplicationFinder.h"
+
+// Ergebnis der Anwendungssuche: startet genau eine gefundene Anwendung.
+// Hält eine eigene Kopie der ApplicationInfo und ist damit unabhängig davon,
+// ob der Katalog inzwischen neu aufgebaut wurde. Das Icon kommt aus dem IconCache.
+class LaunchApplicationCommand : public ICommand {
+public:
+    explicit LaunchApplicationCommand(const ApplicationInfo& app);
+
+    std::wstring GetName() const override;
+    std::wstring GetDescription() const override;
+    CommandCategory GetCategory() const override;
+    void Execute() override;
+
+    // Nur UI-Thread; nullptr, solange das Icon noch im Hintergrund lädt
+    HICON GetIcon() const;
+
+private:
+    ApplicationInfo m_app;
+};
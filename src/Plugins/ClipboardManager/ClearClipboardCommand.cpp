@@ -1,5 +1,5 @@
 #include "ClearClipboardCommand.h"
-#include <windows.h>
+#include "../../Platform/PlatformServices.h"
 
 std::wstring ClearClipboardCommand::GetName() const {
     return L"Clear Clipboard";
@@ -14,11 +14,10 @@ CommandCategory ClearClipboardCommand::GetCategory() const {
 }
 
 void ClearClipboardCommand::Execute() {
-    if (OpenClipboard(NULL)) {
-        EmptyClipboard();
-        CloseClipboard();
-        MessageBoxW(NULL, L"Clipboard cleared successfully!", L"Info", MB_OK | MB_ICONINFORMATION);
+    INotifier& notifier = PlatformServices::Instance().Notifier();
+    if (PlatformServices::Instance().Clipboard().Clear()) {
+        notifier.ShowInfo(L"Info", L"Clipboard cleared successfully!");
     } else {
-        MessageBoxW(NULL, L"Failed to access clipboard!", L"Error", MB_OK | MB_ICONERROR);
+        notifier.ShowError(L"Error", L"Failed to access clipboard!");
     }
 } 
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "ProcessSearchProvider.h"
+#include "TerminateProcessByIdCommand.h"
+#include "../../Search/TextFolding.h"
+
+void ProcessSearchProvider::Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) {
+    std::wstring term = query;
+    if (!StripTerminateWord(term) || term.empty()) return;
+    FoldInto(term, m_foldedName);
+
+    // Der Stand bleibt bis zum Ende der Suche gültig, auch wenn ein neuer veröffentlicht wird
+    ProcessTable::SnapshotPtr snapshot = ProcessTable::Instance().Current();
+    snapshot->Match(m_foldedName, MAX_PROCESS_RESULTS, m_matches);
+
+    double score = PROCESS_SCORE;
+    for (const ProcessTable::Process* process : m_matches) {
+        if (token.IsCancelled()) break;
+        hits.push_back({ std::make_shared<TerminateProcessByIdCommand>(process->processId, process->name), score });
+        score -= 1.0;
+    }
+}
+
+bool ProcessSearchProvider::StripTerminateWord(std::wstring& query) {
+    static const wchar_t* const terminateWords[] = { L"terminate ", L"term ", L"kill ", L"stop " };
+
+    std::wstring folded = FoldText(query);
+    for (const wchar_t* word : terminateWords) {
+        std::wstring_view prefix(word);
+        if (folded.compare(0, prefix.size(), prefix) == 0) {
+            size_t start = query.find_first_not_of(L' ', prefix.size());
+            query = (start == std::wstring::npos) ? std::wstring() : query.substr(start);
+            return true;
+        }
+    }
+    return false;
+}
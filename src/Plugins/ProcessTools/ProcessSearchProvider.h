@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../../Search/SearchScheduler.h"
+#include "ProcessTable.h"
+
+// Listet laufende Prozesse für "terminate"/"term"/"kill"/"stop <name>".
+// Jeder Treffer beendet genau einen Prozess; ohne Kommando-Wort liefert der Provider nichts.
+// Die Prozesse kommen aus dem aktuellen Stand der ProcessTable, eine Suche nimmt selbst
+// keinen Prozess-Snapshot.
+class ProcessSearchProvider : public ISearchProvider {
+public:
+    void Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) override;
+
+private:
+    static constexpr size_t MAX_PROCESS_RESULTS = 5;
+    static constexpr double PROCESS_SCORE = 92.0;
+
+    std::wstring m_foldedName;
+    std::vector<const ProcessTable::Process*> m_matches;
+
+    // Entfernt ein führendes Terminate-Wort; false, wenn keines vorhanden ist
+    static bool StripTerminateWord(std::wstring& query);
+};
@@ -0,0 +1,257 @@
+#include "ProcessTable.h"
+#include "../../Platform/PlatformServices.h"
+#include "../../Search/FuzzyMatcher.h"
+#include "../../Search/StringSearch.h"
+#include "../../Search/TextFolding.h"
+#include "../../Search/TopK.h"
+#include <algorithm>
+#include <limits>
+
+using namespace std::chrono;
+
+namespace {
+
+int64_t ToNanoseconds(milliseconds duration) {
+    return duration_cast<nanoseconds>(duration).count();
+}
+
+bool SameProcess(const ProcessTable::Process& known, const ProcessEntry& entry) {
+    return known.startTime == entry.startTime && known.parentProcessId == entry.parentProcessId &&
+           known.name == entry.exeName;
+}
+
+// Anzeigename ohne ".exe", wie ihn "!t <name>" erwartet
+std::wstring_view WithoutExe(std::wstring_view name, std::wstring_view foldedName) {
+    static const std::wstring_view exe = L".exe";
+    if (foldedName.size() > exe.size() && foldedName.compare(foldedName.size() - exe.size(), exe.size(), exe) == 0) {
+        name.remove_suffix(exe.size());
+    }
+    return name;
+}
+
+} // namespace
+
+// --- Snapshot ----------------------------------------------------------------
+
+ProcessTable::Snapshot::Snapshot(uint64_t version, std::vector<Process> processes)
+    : m_version(version), m_processes(std::move(processes)) {
+    std::sort(m_processes.begin(), m_processes.end(), [](const Process& a, const Process& b) {
+        return a.foldedName != b.foldedName ? a.foldedName < b.foldedName : a.processId < b.processId;
+    });
+
+    m_byId.resize(m_processes.size());
+    for (uint32_t i = 0; i < m_byId.size(); ++i) {
+        m_byId[i] = i;
+    }
+    std::sort(m_byId.begin(), m_byId.end(), [this](uint32_t a, uint32_t b) {
+        return m_processes[a].processId < m_processes[b].processId;
+    });
+}
+
+const ProcessTable::Process* ProcessTable::Snapshot::FindById(uint32_t processId) const {
+    auto it = std::lower_bound(m_byId.begin(), m_byId.end(), processId, [this](uint32_t index, uint32_t id) {
+        return m_processes[index].processId < id;
+    });
+    if (it == m_byId.end() || m_processes[*it].processId != processId) {
+        return nullptr;
+    }
+    return &m_processes[*it];
+}
+
+void ProcessTable::Snapshot::Match(std::wstring_view foldedQuery, size_t limit, std::vector<const Process*>& out) const {
+    out.clear();
+    if (foldedQuery.empty() || limit == 0) {
+        return;
+    }
+
+    struct Ranked {
+        const Process* process;
+        uint32_t tier;      // 0 Namensanfang, 1 Teilstring, 2 + Fehler bei Tippfehlern
+        uint32_t position;
+    };
+    std::vector<Ranked> ranked;
+
+    // Treffer am Namensanfang liegen in der Sortierung zusammen
+    auto first = std::lower_bound(m_processes.begin(), m_processes.end(), foldedQuery,
+                                  [](const Process& process, std::wstring_view query) { return process.foldedName < query; });
+    auto last = first;
+    while (last != m_processes.end() && last->foldedName.compare(0, foldedQuery.size(), foldedQuery) == 0) {
+        ranked.push_back({ &*last, 0, 0 });
+        ++last;
+    }
+
+    FuzzyMatcher matcher;
+    matcher.SetPattern(foldedQuery);
+    uint32_t typoBudget = FuzzyMatcher::TypoBudget(foldedQuery.size());
+    for (auto it = m_processes.begin(); it != m_processes.end(); ++it) {
+        if (it == first) {
+            it = last;
+            if (it == m_processes.end()) break;
+        }
+        size_t position = FindFolded(it->foldedName, foldedQuery);
+        FuzzyMatcher::Match match;
+        if (position != std::wstring_view::npos) {
+            ranked.push_back({ &*it, 1, static_cast<uint32_t>(position) });
+        } else if (typoBudget > 0 && matcher.Search(it->foldedName, typoBudget, match)) {
+            ranked.push_back({ &*it, 2 + match.distance, match.end });
+        }
+    }
+
+    KeepTopK(ranked, limit, [](const Ranked& a, const Ranked& b) {
+        if (a.tier != b.tier) return a.tier < b.tier;
+        if (a.position != b.position) return a.position < b.position;
+        if (a.process->name.size() != b.process->name.size()) return a.process->name.size() < b.process->name.size();
+        return a.process->processId < b.process->processId;
+    });
+    out.reserve(ranked.size());
+    for (const Ranked& entry : ranked) {
+        out.push_back(entry.process);
+    }
+}
+
+// --- ProcessTable ------------------------------------------------------------
+
+ProcessTable& ProcessTable::Instance() {
+    static ProcessTable instance;
+    return instance;
+}
+
+ProcessTable::ProcessTable()
+    : m_lastRefresh(std::numeric_limits<int64_t>::min() / 2),
+      m_lastUse(std::numeric_limits<int64_t>::min() / 2) {
+    // Vor dem Thread anlegen, damit die Dienste beim Beenden erst nach der Tabelle abgebaut werden
+    PlatformServices::Instance();
+    std::atomic_store(&m_snapshot, std::make_shared<const Snapshot>(m_nextVersion++, std::vector<Process>()));
+    m_worker = std::thread(&ProcessTable::RefreshLoop, this);
+}
+
+ProcessTable::~ProcessTable() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+ProcessTable::SnapshotPtr ProcessTable::Current() {
+    MarkUsed();
+    return std::atomic_load(&m_snapshot);
+}
+
+ProcessTable::SnapshotPtr ProcessTable::Fresh(milliseconds maxAge) {
+    MarkUsed();
+    if (Now() - m_lastRefresh.load() > ToNanoseconds(maxAge)) {
+        return Refresh();
+    }
+    return std::atomic_load(&m_snapshot);
+}
+
+std::vector<std::wstring> ProcessTable::SuggestNames(const std::wstring& query, size_t limit) {
+    SnapshotPtr snapshot = Current();
+
+    std::vector<const Process*> candidates;
+    if (query.empty()) {
+        // Zuletzt gestartete zuerst; unbekannte Startzeiten (0) landen hinten
+        for (const Process& process : snapshot->Processes()) {
+            candidates.push_back(&process);
+        }
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Process* a, const Process* b) {
+            return a->startTime > b->startTime;
+        });
+    } else {
+        // Mehrere Instanzen ergeben nur einen Vorschlag, daher mehr Treffer holen als nötig
+        snapshot->Match(FoldText(query), limit * 4, candidates);
+    }
+
+    std::vector<std::wstring> names;
+    std::vector<std::wstring_view> foldedNames;
+    for (const Process* process : candidates) {
+        if (names.size() >= limit) break;
+        std::wstring_view folded = WithoutExe(process->foldedName, process->foldedName);
+        if (std::find(foldedNames.begin(), foldedNames.end(), folded) != foldedNames.end()) continue;
+        foldedNames.push_back(folded);
+        names.emplace_back(WithoutExe(process->name, process->foldedName));
+    }
+    return names;
+}
+
+ProcessTable::SnapshotPtr ProcessTable::Refresh() {
+    std::lock_guard<std::mutex> lock(m_refreshMutex);
+    SnapshotPtr previous = std::atomic_load(&m_snapshot);
+    if (!PlatformServices::Instance().Processes().Enumerate(m_entries)) {
+        return previous;
+    }
+    m_lastRefresh.store(Now());
+
+    // Meist hat sich nichts geändert: dann ohne eine einzige Kopie beim alten Stand bleiben
+    bool changed = m_entries.size() != previous->Size();
+    for (size_t i = 0; !changed && i < m_entries.size(); ++i) {
+        const Process* known = previous->FindById(m_entries[i].processId);
+        changed = !known || !SameProcess(*known, m_entries[i]);
+    }
+    if (!changed) {
+        return previous;
+    }
+
+    // Bekannte Prozesse übernehmen, nur neue falten
+    std::vector<Process> processes;
+    processes.reserve(m_entries.size());
+    for (ProcessEntry& entry : m_entries) {
+        const Process* known = previous->FindById(entry.processId);
+        if (known && SameProcess(*known, entry)) {
+            processes.push_back(*known);
+            continue;
+        }
+        Process process;
+        process.processId = entry.processId;
+        process.parentProcessId = entry.parentProcessId;
+        process.startTime = entry.startTime;
+        process.name = std::move(entry.exeName);
+        process.foldedName = FoldText(process.name);
+        processes.push_back(std::move(process));
+    }
+
+    SnapshotPtr snapshot = std::make_shared<const Snapshot>(m_nextVersion++, std::move(processes));
+    std::atomic_store(&m_snapshot, snapshot);
+    return snapshot;
+}
+
+void ProcessTable::RefreshLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        lock.unlock();
+        try {
+            Refresh();
+        } catch (...) {
+            // Der bisherige Stand bleibt stehen
+        }
+        lock.lock();
+
+        bool active = Now() - m_lastUse.load() < ToNanoseconds(ACTIVE_PERIOD);
+        m_wake.wait_for(lock, active ? ACTIVE_INTERVAL : IDLE_INTERVAL,
+                        [this]() { return m_stopping || m_refreshRequested; });
+        m_refreshRequested = false;
+    }
+}
+
+void ProcessTable::MarkUsed() {
+    int64_t now = Now();
+    int64_t previous = m_lastUse.exchange(now);
+    if (now - previous < ToNanoseconds(ACTIVE_PERIOD)) {
+        return;
+    }
+
+    // Erste Abfrage nach einer Ruhepause: nicht bis zum nächsten Ruhe-Intervall warten
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_refreshRequested = true;
+    }
+    m_wake.notify_one();
+}
+
+int64_t ProcessTable::Now() {
+    return duration_cast<nanoseconds>(PlatformServices::Instance().Clock().Monotonic().time_since_epoch()).count();
+}
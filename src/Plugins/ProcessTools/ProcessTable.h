@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../../Platform/IProcessEnumerator.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Tabelle der laufenden Prozesse, im Hintergrund aus dem IProcessEnumerator der
+// PlatformServices aktualisiert. Veröffentlicht wird wie beim Anwendungskatalog ein
+// unveränderlicher Stand (Snapshot), den Suchen ohne Lock greifen; auf dem Tastendruck-Pfad
+// entsteht so nie ein Prozess-Snapshot des Systems.
+// Jede Aktualisierung vergleicht mit dem vorigen Stand: Prozesse mit gleicher ID, Startzeit und
+// gleichem Namen werden übernommen, nur neue werden gefaltet. Ohne Änderung bleibt der Stand.
+// Nach einer Abfrage wird ACTIVE_PERIOD lang alle ACTIVE_INTERVAL aktualisiert, sonst nur alle
+// IDLE_INTERVAL; die erste Abfrage nach einer Ruhepause stößt sofort eine Aktualisierung an.
+class ProcessTable {
+public:
+    struct Process {
+        uint32_t processId = 0;
+        uint32_t parentProcessId = 0;
+        uint64_t startTime = 0;
+        std::wstring name;
+        std::wstring foldedName;
+    };
+
+    class Snapshot {
+    public:
+        Snapshot(uint64_t version, std::vector<Process> processes);
+
+        uint64_t Version() const { return m_version; }
+        size_t Size() const { return m_processes.size(); }
+
+        // Nach gefaltetem Namen sortiert, bei gleichem Namen nach Prozess-ID
+        const std::vector<Process>& Processes() const { return m_processes; }
+        const Process* FindById(uint32_t processId) const;
+
+        // Beste Treffer zu einer gefalteten Anfrage: Namensanfang vor Teilstring vor Tippfehlern,
+        // innerhalb davon frühere Trefferposition, kürzerer Name. Zeiger bleiben mit dem Stand gültig.
+        void Match(std::wstring_view foldedQuery, size_t limit, std::vector<const Process*>& out) const;
+
+    private:
+        uint64_t m_version;
+        std::vector<Process> m_processes;
+        std::vector<uint32_t> m_byId;  // Positionen in m_processes, nach Prozess-ID sortiert
+    };
+
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    static constexpr std::chrono::milliseconds ACTIVE_INTERVAL{ 1000 };
+    static constexpr std::chrono::milliseconds IDLE_INTERVAL{ 10000 };
+    static constexpr std::chrono::milliseconds ACTIVE_PERIOD{ 30000 };
+
+    static ProcessTable& Instance();
+
+    ~ProcessTable();
+
+    ProcessTable(const ProcessTable&) = delete;
+    ProcessTable& operator=(const ProcessTable&) = delete;
+
+    // Thread-sicher und ohne Lock; zählt als Abfrage (siehe oben). Vor der ersten Aktualisierung leer.
+    SnapshotPtr Current();
+
+    // Wie Current, aktualisiert aber auf dem aufrufenden Thread, wenn die letzte Aktualisierung
+    // länger als maxAge zurückliegt (vor dem Beenden von Prozessen)
+    SnapshotPtr Fresh(std::chrono::milliseconds maxAge = ACTIVE_INTERVAL);
+
+    // Verschiedene Prozessnamen zur Anfrage (ohne ".exe"), für die "!t"-Vorschläge.
+    // Ohne Anfrage die zuletzt gestarteten.
+    std::vector<std::wstring> SuggestNames(const std::wstring& query, size_t limit);
+
+    // Nimmt sofort einen Prozess-Snapshot und veröffentlicht die Änderungen
+    SnapshotPtr Refresh();
+
+private:
+    ProcessTable();
+
+    // Nur über std::atomic_load/std::atomic_store zugreifen
+    SnapshotPtr m_snapshot;
+    uint64_t m_nextVersion = 1;
+
+    // Hält Refresh exklusiv (Hintergrund-Thread und Fresh), auch für den Puffer m_entries
+    std::mutex m_refreshMutex;
+    std::vector<ProcessEntry> m_entries;
+    std::atomic<int64_t> m_lastRefresh;  // Monotonic, in Nanosekunden
+    std::atomic<int64_t> m_lastUse;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_refreshRequested = false;
+    bool m_stopping = false;
+    std::thread m_worker;
+
+    void RefreshLoop();
+    void MarkUsed();
+    static int64_t Now();
+};
@@ -0,0 +1,27 @@
+#include "TerminateProcessByIdCommand.h"
+#include "../../Platform/PlatformServices.h"
+
+TerminateProcessByIdCommand::TerminateProcessByIdCommand(uint32_t processId, const std::wstring& exeName)
+    : m_processId(processId), m_exeName(exeName) {
+}
+
+std::wstring TerminateProcessByIdCommand::GetName() const {
+    return L"Terminate " + m_exeName;
+}
+
+std::wstring TerminateProcessByIdCommand::GetDescription() const {
+    return L"Ends process " + m_exeName + L" (PID: " + std::to_wstring(m_processId) + L")";
+}
+
+CommandCategory TerminateProcessByIdCommand::GetCategory() const {
+    return CommandCategory::PROCESS_TOOLS;
+}
+
+void TerminateProcessByIdCommand::Execute() {
+    PlatformServices& services = PlatformServices::Instance();
+    if (!services.Processes().Terminate(m_processId)) {
+        std::wstring errorMsg = L"Prozess " + m_exeName + L" (PID: " + std::to_wstring(m_processId) +
+                                L") konnte nicht beendet werden.";
+        services.Notifier().ShowError(L"WinPal - Terminierung fehlgeschlagen", errorMsg);
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../../Commands/ICommand.h"
+#include <cstdint>
+
+// Ergebnis der Prozesssuche: beendet genau einen laufenden Prozess über seine PID
+class TerminateProcessByIdCommand : public ICommand {
+public:
+    TerminateProcessByIdCommand(uint32_t processId, const std::wstring& exeName);
+
+    std::wstring GetName() const override;
+    std::wstring GetDescription() const override;
+    CommandCategory GetCategory() const override;
+    void Execute() override;
+
+private:
+    uint32_t m_processId;
+    std::wstring m_exeName;
+};
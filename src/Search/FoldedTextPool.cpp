@@ -0,0 +1,89 @@
+#include "FoldedTextPool.h"
+#include "TextFolding.h"
+#include <utility>
+
+// Kopieren und Verschieben müssen die Views auf die eigenen Strings neu setzen
+FoldedTextPool::FoldedTextPool(const FoldedTextPool& other) {
+    *this = other;
+}
+
+FoldedTextPool::FoldedTextPool(FoldedTextPool&& other) noexcept {
+    *this = std::move(other);
+}
+
+FoldedTextPool& FoldedTextPool::operator=(const FoldedTextPool& other) {
+    if (this == &other) return *this;
+    m_display = other.m_display;
+    m_folded = other.m_folded;
+    m_attached = other.m_attached;
+    if (m_attached) {
+        m_displayView = other.m_displayView;
+        m_foldedView = other.m_foldedView;
+    } else {
+        UseOwnBuffers();
+    }
+    return *this;
+}
+
+FoldedTextPool& FoldedTextPool::operator=(FoldedTextPool&& other) noexcept {
+    if (this == &other) return *this;
+    m_display = std::move(other.m_display);
+    m_folded = std::move(other.m_folded);
+    m_attached = other.m_attached;
+    if (m_attached) {
+        m_displayView = other.m_displayView;
+        m_foldedView = other.m_foldedView;
+    } else {
+        UseOwnBuffers();
+    }
+    other.Clear();
+    return *this;
+}
+
+FoldedTextPool::Span FoldedTextPool::Append(std::wstring_view text) {
+    if (m_attached) {
+        // Fremde Puffer sind schreibgeschützt: einmalig in eigenen Speicher übernehmen
+        m_display.assign(m_displayView);
+        m_folded.assign(m_foldedView);
+        m_attached = false;
+    }
+
+    Span span;
+    span.offset = static_cast<uint32_t>(m_folded.size());
+    span.length = static_cast<uint32_t>(text.size());
+
+    m_display.append(text.data(), text.size());
+    m_folded.reserve(m_folded.size() + text.size());
+    for (wchar_t c : text) {
+        m_folded.push_back(FoldChar(c));
+    }
+    UseOwnBuffers();
+    return span;
+}
+
+void FoldedTextPool::Reserve(size_t characters) {
+    if (m_attached) return;
+    m_display.reserve(characters);
+    m_folded.reserve(characters);
+    UseOwnBuffers();
+}
+
+void FoldedTextPool::Clear() {
+    m_display.clear();
+    m_folded.clear();
+    m_attached = false;
+    UseOwnBuffers();
+}
+
+void FoldedTextPool::Attach(std::wstring_view display, std::wstring_view folded) {
+    m_display.clear();
+    m_folded.clear();
+    m_displayView = display;
+    m_foldedView = folded.substr(0, display.size());
+    m_attached = true;
+}
+
+void FoldedTextPool::UseOwnBuffers() {
+    m_displayView = m_display;
+    m_foldedView = m_folded;
+}
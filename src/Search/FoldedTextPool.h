@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Zusammenhängender Speicher für Suchtexte. Jeder Text liegt zweimal vor:
+// einmal im Original (für die Anzeige) und einmal gefaltet (für den Vergleich).
+// Beide Puffer haben dasselbe Layout, ein Span gilt also für beide.
+// Statt eigener Puffer kann der Pool auch fremde Puffer (z.B. aus dem eingeblendeten
+// Anwendungs-Cache) ohne Kopie nutzen; erst ein Append kopiert sie in eigenen Speicher.
+class FoldedTextPool {
+public:
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    FoldedTextPool() = default;
+    FoldedTextPool(const FoldedTextPool& other);
+    FoldedTextPool(FoldedTextPool&& other) noexcept;
+    FoldedTextPool& operator=(const FoldedTextPool& other);
+    FoldedTextPool& operator=(FoldedTextPool&& other) noexcept;
+
+    Span Append(std::wstring_view text);
+    void Reserve(size_t characters);
+    void Clear();
+
+    // display und folded müssen gleich lang sein und bis zum nächsten Clear/Append gültig bleiben
+    void Attach(std::wstring_view display, std::wstring_view folded);
+
+    std::wstring_view Display(Span span) const {
+        return std::wstring_view(m_displayView.data() + span.offset, span.length);
+    }
+
+    std::wstring_view Folded(Span span) const {
+        return std::wstring_view(m_foldedView.data() + span.offset, span.length);
+    }
+
+    // Gesamte Puffer, z.B. zum Serialisieren
+    std::wstring_view DisplayBuffer() const { return m_displayView; }
+    std::wstring_view FoldedBuffer() const { return m_foldedView; }
+
+    size_t Size() const { return m_foldedView.size(); }
+
+private:
+    std::wstring m_display;
+    std::wstring m_folded;
+
+    // Zeigen auf die eigenen Strings oder auf angehängte fremde Puffer
+    std::wstring_view m_displayView;
+    std::wstring_view m_foldedView;
+    bool m_attached = false;
+
+    void UseOwnBuffers();
+};
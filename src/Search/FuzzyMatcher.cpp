@@ -0,0 +1,197 @@
+#include "FuzzyMatcher.h"
+#include <algorithm>
+
+uint32_t FuzzyMatcher::TypoBudget(size_t patternLength) {
+    if (patternLength < 4) return 0;
+    if (patternLength < 8) return 1;
+    return 2;
+}
+
+void FuzzyMatcher::SetPattern(std::wstring_view foldedPattern) {
+    m_pattern.assign(foldedPattern.data(), foldedPattern.size());
+    std::fill(std::begin(m_asciiMasks), std::end(m_asciiMasks), 0);
+    m_otherMasks.clear();
+
+    if (m_pattern.size() > MAX_BIT_PARALLEL_LENGTH) {
+        return;
+    }
+
+    // Bitmaske pro Zeichen: Bit i gesetzt, wenn pattern[i] == Zeichen
+    for (size_t i = 0; i < m_pattern.size(); ++i) {
+        wchar_t c = m_pattern[i];
+        uint64_t bit = uint64_t(1) << i;
+        if (static_cast<uint32_t>(c) < 128) {
+            m_asciiMasks[c] |= bit;
+            continue;
+        }
+        auto it = std::find_if(m_otherMasks.begin(), m_otherMasks.end(),
+                               [c](const std::pair<wchar_t, uint64_t>& entry) { return entry.first == c; });
+        if (it != m_otherMasks.end()) {
+            it->second |= bit;
+        } else {
+            m_otherMasks.emplace_back(c, bit);
+        }
+    }
+}
+
+uint64_t FuzzyMatcher::MaskFor(wchar_t c) const {
+    if (static_cast<uint32_t>(c) < 128) {
+        return m_asciiMasks[c];
+    }
+    for (const auto& entry : m_otherMasks) {
+        if (entry.first == c) return entry.second;
+    }
+    return 0;
+}
+
+bool FuzzyMatcher::Search(std::wstring_view foldedText, uint32_t maxDistance, Match& match) const {
+    match = Match();
+    if (m_pattern.empty()) {
+        return false;
+    }
+    if (m_pattern.size() <= MAX_BIT_PARALLEL_LENGTH) {
+        return SearchBitParallel(foldedText, maxDistance, match);
+    }
+    return SearchTable(foldedText, maxDistance, match);
+}
+
+bool FuzzyMatcher::SearchBitParallel(std::wstring_view text, uint32_t maxDistance, Match& match) const {
+    // Hyyrö 2003: Myers' Bitvektor-Algorithmus mit Transpositionen (OSA-Distanz).
+    // Die obere Tabellenzeile ist 0 (HP ohne "| 1"), das Muster darf also überall beginnen.
+    const uint64_t lastBit = uint64_t(1) << (m_pattern.size() - 1);
+    uint64_t vp = ~uint64_t(0);
+    uint64_t vn = 0;
+    uint64_t d0 = 0;
+    uint64_t prevEq = 0;
+    uint32_t score = static_cast<uint32_t>(m_pattern.size());
+    uint32_t best = maxDistance + 1;
+
+    for (size_t j = 0; j < text.size(); ++j) {
+        uint64_t eq = MaskFor(text[j]);
+        uint64_t tr = (((~d0) & eq) << 1) & prevEq;
+        d0 = (((eq & vp) + vp) ^ vp) | eq | vn | tr;
+        uint64_t hp = vn | ~(d0 | vp);
+        uint64_t hn = d0 & vp;
+
+        if (hp & lastBit) {
+            ++score;
+        } else if (hn & lastBit) {
+            --score;
+        }
+
+        hp <<= 1;
+        hn <<= 1;
+        vp = hn | ~(d0 | hp);
+        vn = hp & d0;
+        prevEq = eq;
+
+        if (score < best) {
+            best = score;
+            match.distance = score;
+            match.end = static_cast<uint32_t>(j + 1);
+            if (best == 0) break;
+        }
+    }
+
+    return best <= maxDistance;
+}
+
+bool FuzzyMatcher::SearchTable(std::wstring_view text, uint32_t maxDistance, Match& match) const {
+    // Spaltenweise DP, drei Spalten reichen für die Transposition
+    const size_t m = m_pattern.size();
+    m_table.assign(3 * (m + 1), 0);
+    uint32_t* prev2 = m_table.data();
+    uint32_t* prev = prev2 + (m + 1);
+    uint32_t* cur = prev + (m + 1);
+
+    for (size_t i = 0; i <= m; ++i) {
+        prev[i] = static_cast<uint32_t>(i);
+    }
+
+    uint32_t best = maxDistance + 1;
+    for (size_t j = 1; j <= text.size(); ++j) {
+        cur[0] = 0;
+        for (size_t i = 1; i <= m; ++i) {
+            uint32_t cost = (m_pattern[i - 1] == text[j - 1]) ? 0 : 1;
+            uint32_t value = std::min({ prev[i] + 1, cur[i - 1] + 1, prev[i - 1] + cost });
+            if (i > 1 && j > 1 && m_pattern[i - 1] == text[j - 2] && m_pattern[i - 2] == text[j - 1]) {
+                value = std::min(value, prev2[i - 2] + 1);
+            }
+            cur[i] = value;
+        }
+
+        if (cur[m] < best) {
+            best = cur[m];
+            match.distance = best;
+            match.end = static_cast<uint32_t>(j);
+            if (best == 0) break;
+        }
+
+        uint32_t* recycled = prev2;
+        prev2 = prev;
+        prev = cur;
+        cur = recycled;
+    }
+
+    return best <= maxDistance;
+}
+
+bool FuzzyMatcher::Locate(std::wstring_view foldedText, uint32_t maxDistance, Match& match,
+                          std::vector<uint32_t>& positions) const {
+    positions.clear();
+    if (!Search(foldedText, maxDistance, match)) {
+        return false;
+    }
+
+    // Ein Treffer mit d Fehlern überdeckt höchstens m + d Textzeichen,
+    // die volle Tabelle wird also nur über dieses Fenster aufgebaut
+    const size_t m = m_pattern.size();
+    const size_t end = match.end;
+    const size_t lo = end - std::min(end, m + match.distance);
+    const size_t w = end - lo;
+    std::wstring_view t = foldedText.substr(lo, w);
+
+    m_table.assign((m + 1) * (w + 1), 0);
+    auto at = [this, w](size_t i, size_t j) -> uint32_t& { return m_table[i * (w + 1) + j]; };
+
+    for (size_t i = 1; i <= m; ++i) {
+        at(i, 0) = static_cast<uint32_t>(i);
+        for (size_t j = 1; j <= w; ++j) {
+            uint32_t cost = (m_pattern[i - 1] == t[j - 1]) ? 0 : 1;
+            uint32_t value = std::min({ at(i - 1, j) + 1, at(i, j - 1) + 1, at(i - 1, j - 1) + cost });
+            if (i > 1 && j > 1 && m_pattern[i - 1] == t[j - 2] && m_pattern[i - 2] == t[j - 1]) {
+                value = std::min(value, at(i - 2, j - 2) + 1);
+            }
+            at(i, j) = value;
+        }
+    }
+
+    // Rückverfolgung vom Trefferende; Übereinstimmungen bevorzugt
+    size_t i = m;
+    size_t j = w;
+    while (i > 0) {
+        uint32_t value = at(i, j);
+        if (j > 0 && m_pattern[i - 1] == t[j - 1] && value == at(i - 1, j - 1)) {
+            positions.push_back(static_cast<uint32_t>(lo + j - 1));
+            --i;
+            --j;
+        } else if (i > 1 && j > 1 && m_pattern[i - 1] == t[j - 2] && m_pattern[i - 2] == t[j - 1] &&
+                   value == at(i - 2, j - 2) + 1) {
+            positions.push_back(static_cast<uint32_t>(lo + j - 1));
+            positions.push_back(static_cast<uint32_t>(lo + j - 2));
+            i -= 2;
+            j -= 2;
+        } else if (j > 0 && value == at(i - 1, j - 1) + 1) {
+            --i;
+            --j;
+        } else if (value == at(i - 1, j) + 1) {
+            --i;
+        } else {
+            --j;
+        }
+    }
+
+    match.start = static_cast<uint32_t>(lo + j);
+    std::reverse(positions.begin(), positions.end());
+    return true;
+}
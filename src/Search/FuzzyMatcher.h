@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Tippfehlertoleranter Matcher: sucht das Muster an beliebiger Stelle im Text
+// und zählt Einfügen, Löschen, Ersetzen und Vertauschen benachbarter Zeichen
+// als je einen Fehler ("ntoepad" -> "notepad" = 1).
+// Muster bis 64 Zeichen laufen bit-parallel (Myers/Hyyrö, ein uint64_t pro Textzeichen),
+// längere Muster über die klassische DP-Tabelle.
+// Beide Seiten müssen bereits gefaltet sein (siehe TextFolding.h).
+class FuzzyMatcher {
+public:
+    struct Match {
+        uint32_t distance = 0;  // Anzahl Tippfehler
+        uint32_t start = 0;     // erste Textposition des Treffers (nur Locate)
+        uint32_t end = 0;       // Textposition hinter dem Treffer
+    };
+
+    static constexpr size_t MAX_BIT_PARALLEL_LENGTH = 64;
+
+    // Erlaubte Tippfehler abhängig von der Musterlänge (kurze Queries müssen exakt sein)
+    static uint32_t TypoBudget(size_t patternLength);
+
+    // Bereitet das Muster vor; einmal pro Query aufrufen
+    void SetPattern(std::wstring_view foldedPattern);
+    size_t PatternLength() const { return m_pattern.size(); }
+
+    // Bester Treffer mit höchstens maxDistance Fehlern (kleinste Distanz, bei Gleichstand der früheste)
+    bool Search(std::wstring_view foldedText, uint32_t maxDistance, Match& match) const;
+
+    // Wie Search, ermittelt zusätzlich den Trefferanfang und die Textpositionen,
+    // auf die Musterzeichen passen (z.B. zum Hervorheben)
+    bool Locate(std::wstring_view foldedText, uint32_t maxDistance, Match& match,
+                std::vector<uint32_t>& positions) const;
+
+private:
+    std::wstring m_pattern;
+    uint64_t m_asciiMasks[128] = {};
+    std::vector<std::pair<wchar_t, uint64_t>> m_otherMasks;
+
+    // Wiederverwendeter DP-Speicher für lange Muster und Locate
+    mutable std::vector<uint32_t> m_table;
+
+    uint64_t MaskFor(wchar_t c) const;
+    bool SearchBitParallel(std::wstring_view text, uint32_t maxDistance, Match& match) const;
+    bool SearchTable(std::wstring_view text, uint32_t maxDistance, Match& match) const;
+};
@@ -0,0 +1,134 @@
+#include "SearchScheduler.h"
+#include <algorithm>
+
+SearchScheduler::SearchScheduler(size_t workerCount, size_t maxResults, ResultsCallback onResults)
+    : m_maxResults(maxResults), m_onResults(std::move(onResults)), m_pool(workerCount) {
+}
+
+SearchScheduler::~SearchScheduler() {
+    // Laufende Provider brechen ab und starten nicht neu; m_pool joint danach als erstes Member
+    Cancel();
+}
+
+void SearchScheduler::AddProvider(std::unique_ptr<ISearchProvider> provider) {
+    if (!provider) return;
+    auto slot = std::make_unique<ProviderSlot>();
+    slot->provider = std::move(provider);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_slots.push_back(std::move(slot));
+}
+
+uint64_t SearchScheduler::Submit(const std::wstring& query) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        generation = m_latestGeneration.fetch_add(1) + 1;
+        m_query = query;
+        m_cancelled = false;
+        m_merged.clear();
+        m_finishedProviders = 0;
+
+        // Beschäftigte Provider holen sich die neue Query selbst, sobald sie fertig sind
+        for (auto& slot : m_slots) {
+            if (!slot->running) {
+                slot->running = true;
+                ProviderSlot* target = slot.get();
+                m_pool.Enqueue([this, target]() { RunProvider(*target); });
+            }
+        }
+    }
+    m_completed.notify_all();
+    return generation;
+}
+
+void SearchScheduler::Cancel() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_latestGeneration.fetch_add(1);
+        m_cancelled = true;
+        m_merged.clear();
+        m_finishedProviders = 0;
+    }
+    m_completed.notify_all();
+}
+
+bool SearchScheduler::TakeResults(uint64_t generation, std::vector<SearchHit>& results, bool& complete) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_cancelled || m_latestGeneration.load() != generation) {
+        return false;
+    }
+    results = m_merged;
+    complete = m_finishedProviders == m_slots.size();
+    return true;
+}
+
+bool SearchScheduler::WaitForGeneration(uint64_t generation, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completed.wait_for(lock, timeout, [this, generation]() {
+        return m_latestGeneration.load() != generation || m_finishedProviders == m_slots.size();
+    });
+    return !m_cancelled && m_latestGeneration.load() == generation && m_finishedProviders == m_slots.size();
+}
+
+void SearchScheduler::RunProvider(ProviderSlot& slot) {
+    for (;;) {
+        uint64_t generation;
+        std::wstring query;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_cancelled) {
+                slot.running = false;
+                return;
+            }
+            generation = m_latestGeneration.load();
+            query = m_query;
+        }
+
+        slot.hits.clear();
+        CancellationToken token(m_latestGeneration, generation);
+        try {
+            slot.provider->Search(query, token, slot.hits);
+        } catch (...) {
+            // Ein fehlerhafter Provider liefert einfach keine Treffer
+            slot.hits.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_latestGeneration.load() != generation) {
+                // Veraltet: Ergebnis verwerfen und ggf. mit der neuesten Query weitermachen
+                continue;
+            }
+            MergeLocked(slot.hits);
+            ++m_finishedProviders;
+            slot.running = false;
+        }
+        m_completed.notify_all();
+
+        if (m_onResults) {
+            m_onResults(generation);
+        }
+        return;
+    }
+}
+
+void SearchScheduler::MergeLocked(const std::vector<SearchHit>& hits) {
+    for (const auto& hit : hits) {
+        if (!hit.command) continue;
+        auto existing = std::find_if(m_merged.begin(), m_merged.end(),
+                                     [&hit](const SearchHit& merged) { return merged.command.get() == hit.command.get(); });
+        if (existing != m_merged.end()) {
+            existing->score = std::max(existing->score, hit.score);
+        } else {
+            m_merged.push_back(hit);
+        }
+    }
+
+    // Stabil, damit bei gleichem Score die Reihenfolge der Provider erhalten bleibt
+    std::stable_sort(m_merged.begin(), m_merged.end(),
+                     [](const SearchHit& a, const SearchHit& b) { return a.score > b.score; });
+    if (m_merged.size() > m_maxResults) {
+        m_merged.resize(m_maxResults);
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../Commands/ICommand.h"
+#include "../Concurrency/ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Ein Treffer eines Providers. Für registrierte Commands zeigt command ohne
+// Besitz auf den Command; Provider mit dynamischen Ergebnissen (Apps, Prozesse)
+// erzeugen eigene Objekte, die über den shared_ptr am Leben bleiben.
+struct SearchHit {
+    std::shared_ptr<ICommand> command;
+    double score = 0.0;
+};
+
+// Von Providern regelmäßig abzufragen; wird true, sobald eine neuere Query eingegangen ist
+class CancellationToken {
+public:
+    CancellationToken(const std::atomic<uint64_t>& latest, uint64_t generation)
+        : m_latest(latest), m_generation(generation) {}
+
+    bool IsCancelled() const { return m_latest.load(std::memory_order_relaxed) != m_generation; }
+    uint64_t Generation() const { return m_generation; }
+
+private:
+    const std::atomic<uint64_t>& m_latest;
+    uint64_t m_generation;
+};
+
+class ISearchProvider {
+public:
+    virtual ~ISearchProvider() = default;
+
+    // Läuft auf einem Worker-Thread. Ein Provider wird nie parallel zu sich selbst
+    // aufgerufen und darf daher eigene Puffer wiederverwenden.
+    virtual void Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) = 0;
+};
+
+// Führt alle Provider pro Query-Generation auf einem Worker-Pool aus.
+// Eine neue Query macht ältere Generationen ungültig; laufende Provider sehen das
+// über ihr CancellationToken und starten danach direkt mit der neuesten Query.
+// Nach jedem fertigen Provider werden die Treffer zusammengeführt (gleicher Command:
+// höchster Score gewinnt) und onResults(generation) auf dem Worker aufgerufen.
+// Plattformunabhängig; unter Windows stellt der Callback eine Nachricht ins Fenster.
+class SearchScheduler {
+public:
+    using ResultsCallback = std::function<void(uint64_t generation)>;
+
+    SearchScheduler(size_t workerCount, size_t maxResults, ResultsCallback onResults);
+    ~SearchScheduler();
+
+    SearchScheduler(const SearchScheduler&) = delete;
+    SearchScheduler& operator=(const SearchScheduler&) = delete;
+
+    // Nur vor dem ersten Submit aufrufen
+    void AddProvider(std::unique_ptr<ISearchProvider> provider);
+
+    // Startet eine neue Generation und gibt deren Nummer zurück
+    uint64_t Submit(const std::wstring& query);
+
+    // Verwirft alle laufenden Suchen (z.B. bei leerem Eingabefeld)
+    void Cancel();
+
+    uint64_t LatestGeneration() const { return m_latestGeneration.load(); }
+
+    // Kopiert die bisher zusammengeführten Treffer; false, wenn generation veraltet ist.
+    // complete ist true, sobald alle Provider dieser Generation fertig sind.
+    bool TakeResults(uint64_t generation, std::vector<SearchHit>& results, bool& complete) const;
+
+    // Blockiert, bis alle Provider der Generation fertig sind (Enter auf noch laufender Suche,
+    // Tests und Benchmarks); false bei Timeout oder veralteter Generation
+    bool WaitForGeneration(uint64_t generation, std::chrono::milliseconds timeout) const;
+
+private:
+    struct ProviderSlot {
+        std::unique_ptr<ISearchProvider> provider;
+        std::vector<SearchHit> hits;
+        bool running = false;
+    };
+
+    std::vector<std::unique_ptr<ProviderSlot>> m_slots;
+    size_t m_maxResults;
+    ResultsCallback m_onResults;
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_completed;
+    std::atomic<uint64_t> m_latestGeneration{ 0 };
+    std::wstring m_query;
+    bool m_cancelled = false;
+    std::vector<SearchHit> m_merged;
+    size_t m_finishedProviders = 0;
+
+    // Als letztes Mitglied zuerst zerstört: Worker sind beendet, bevor Provider und Puffer verschwinden
+    ThreadPool m_pool;
+
+    void RunProvider(ProviderSlot& slot);
+    void MergeLocked(const std::vector<SearchHit>& hits);
+};
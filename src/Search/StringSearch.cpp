@@ -0,0 +1,221 @@
+#include "StringSearch.h"
+#include "TextFolding.h"
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WINPAL_SEARCH_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC erlaubt AVX2-Intrinsics ohne Compilerflag, GCC/Clang brauchen das target-Attribut
+#if defined(WINPAL_SEARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define WINPAL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define WINPAL_TARGET_AVX2
+#endif
+
+namespace {
+
+bool MatchesAt(const wchar_t* text, std::wstring_view needle) {
+    for (size_t k = 0; k < needle.size(); ++k) {
+        if (FoldChar(text[k]) != needle[k]) return false;
+    }
+    return true;
+}
+
+size_t FinishScalar(std::wstring_view haystack, std::wstring_view needle, size_t from) {
+    size_t pos = FindFoldedScalar(haystack.substr(from), needle);
+    return (pos == std::wstring_view::npos) ? pos : from + pos;
+}
+
+#ifdef WINPAL_SEARCH_X86
+
+// Für gefaltete ASCII-Buchstaben gilt: (c | 0x20) == nadel <=> FoldChar(c) == nadel.
+// Für alle anderen ASCII-Zeichen muss c exakt passen.
+wchar_t CaseBit(wchar_t c) {
+    return (c >= L'a' && c <= L'z') ? 0x20 : 0;
+}
+
+// Bits außerhalb von ASCII; Lanes mit solchen Zeichen werden immer skalar geprüft
+const wchar_t kNonAsciiBits = static_cast<wchar_t>(~static_cast<wchar_t>(0x7F));
+const uint32_t kLaneBits = (1u << sizeof(wchar_t)) - 1;
+
+unsigned LowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+inline __m128i Splat128(wchar_t c) {
+    return (sizeof(wchar_t) == 2) ? _mm_set1_epi16(static_cast<short>(c)) : _mm_set1_epi32(static_cast<int>(c));
+}
+
+inline __m128i CmpEq128(__m128i a, __m128i b) {
+    return (sizeof(wchar_t) == 2) ? _mm_cmpeq_epi16(a, b) : _mm_cmpeq_epi32(a, b);
+}
+
+size_t FindSse2(std::wstring_view haystack, std::wstring_view needle) {
+    constexpr size_t lanes = sizeof(__m128i) / sizeof(wchar_t);
+    const size_t n = needle.size();
+    const wchar_t* data = haystack.data();
+
+    const __m128i first = Splat128(needle[0]);
+    const __m128i firstCase = Splat128(CaseBit(needle[0]));
+    const __m128i last = Splat128(needle[n - 1]);
+    const __m128i lastCase = Splat128(CaseBit(needle[n - 1]));
+    const __m128i nonAscii = Splat128(kNonAsciiBits);
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + lanes + n - 1 <= haystack.size(); i += lanes) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + n - 1));
+
+        uint32_t firstHit = static_cast<uint32_t>(_mm_movemask_epi8(CmpEq128(_mm_or_si128(a, firstCase), first)));
+        uint32_t lastHit = static_cast<uint32_t>(_mm_movemask_epi8(CmpEq128(_mm_or_si128(b, lastCase), last)));
+        uint32_t asciiA = static_cast<uint32_t>(_mm_movemask_epi8(CmpEq128(_mm_and_si128(a, nonAscii), zero)));
+        uint32_t asciiB = static_cast<uint32_t>(_mm_movemask_epi8(CmpEq128(_mm_and_si128(b, nonAscii), zero)));
+        uint32_t candidates = (firstHit | ~asciiA) & (lastHit | ~asciiB) & 0xFFFFu;
+
+        while (candidates != 0) {
+            size_t lane = LowestBit(candidates) / sizeof(wchar_t);
+            if (MatchesAt(data + i + lane, needle)) return i + lane;
+            candidates &= ~(kLaneBits << (lane * sizeof(wchar_t)));
+        }
+    }
+
+    return FinishScalar(haystack, needle, i);
+}
+
+WINPAL_TARGET_AVX2 inline __m256i Splat256(wchar_t c) {
+    return (sizeof(wchar_t) == 2) ? _mm256_set1_epi16(static_cast<short>(c)) : _mm256_set1_epi32(static_cast<int>(c));
+}
+
+WINPAL_TARGET_AVX2 inline __m256i CmpEq256(__m256i a, __m256i b) {
+    return (sizeof(wchar_t) == 2) ? _mm256_cmpeq_epi16(a, b) : _mm256_cmpeq_epi32(a, b);
+}
+
+WINPAL_TARGET_AVX2 size_t FindAvx2(std::wstring_view haystack, std::wstring_view needle) {
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(wchar_t);
+    const size_t n = needle.size();
+    const wchar_t* data = haystack.data();
+
+    const __m256i first = Splat256(needle[0]);
+    const __m256i firstCase = Splat256(CaseBit(needle[0]));
+    const __m256i last = Splat256(needle[n - 1]);
+    const __m256i lastCase = Splat256(CaseBit(needle[n - 1]));
+    const __m256i nonAscii = Splat256(kNonAsciiBits);
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + lanes + n - 1 <= haystack.size(); i += lanes) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + n - 1));
+
+        uint32_t firstHit = static_cast<uint32_t>(_mm256_movemask_epi8(CmpEq256(_mm256_or_si256(a, firstCase), first)));
+        uint32_t lastHit = static_cast<uint32_t>(_mm256_movemask_epi8(CmpEq256(_mm256_or_si256(b, lastCase), last)));
+        uint32_t asciiA = static_cast<uint32_t>(_mm256_movemask_epi8(CmpEq256(_mm256_and_si256(a, nonAscii), zero)));
+        uint32_t asciiB = static_cast<uint32_t>(_mm256_movemask_epi8(CmpEq256(_mm256_and_si256(b, nonAscii), zero)));
+        uint32_t candidates = (firstHit | ~asciiA) & (lastHit | ~asciiB);
+
+        while (candidates != 0) {
+            size_t lane = LowestBit(candidates) / sizeof(wchar_t);
+            if (MatchesAt(data + i + lane, needle)) return i + lane;
+            candidates &= ~(kLaneBits << (lane * sizeof(wchar_t)));
+        }
+    }
+
+    return FinishScalar(haystack, needle, i);
+}
+
+bool CpuHasAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // AVX setzt voraus, dass das Betriebssystem die YMM-Register sichert (OSXSAVE + XCR0)
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // WINPAL_SEARCH_X86
+
+using FindKernel = size_t (*)(std::wstring_view, std::wstring_view);
+
+// Die Vektor-Kernel setzen eine nicht leere Nadel voraus, die in den Text passt
+template <FindKernel kernel>
+size_t FindChecked(std::wstring_view haystack, std::wstring_view foldedNeedle) {
+    if (foldedNeedle.empty()) return 0;
+    if (foldedNeedle.size() > haystack.size()) return std::wstring_view::npos;
+    return kernel(haystack, foldedNeedle);
+}
+
+struct KernelChoice {
+    FindKernel find;
+    const char* name;
+};
+
+KernelChoice SelectKernel() {
+#ifdef WINPAL_SEARCH_X86
+    if (CpuHasAvx2()) return { FindAvx2, "avx2" };
+    return { FindSse2, "sse2" };
+#else
+    return { FindFoldedScalar, "scalar" };
+#endif
+}
+
+const KernelChoice& ActiveKernel() {
+    static const KernelChoice choice = SelectKernel();
+    return choice;
+}
+
+} // namespace
+
+size_t FindFoldedScalar(std::wstring_view haystack, std::wstring_view foldedNeedle) {
+    if (foldedNeedle.empty()) return 0;
+    if (foldedNeedle.size() > haystack.size()) return std::wstring_view::npos;
+
+    const size_t limit = haystack.size() - foldedNeedle.size();
+    for (size_t i = 0; i <= limit; ++i) {
+        if (FoldChar(haystack[i]) == foldedNeedle[0] && MatchesAt(haystack.data() + i, foldedNeedle)) {
+            return i;
+        }
+    }
+    return std::wstring_view::npos;
+}
+
+size_t FindFolded(std::wstring_view haystack, std::wstring_view foldedNeedle) {
+    if (foldedNeedle.empty()) return 0;
+    if (foldedNeedle.size() > haystack.size()) return std::wstring_view::npos;
+    return ActiveKernel().find(haystack, foldedNeedle);
+}
+
+std::vector<StringSearchKernel> AvailableStringSearchKernels() {
+    std::vector<StringSearchKernel> kernels;
+    kernels.push_back({ "scalar", FindFoldedScalar });
+#ifdef WINPAL_SEARCH_X86
+    kernels.push_back({ "sse2", FindChecked<FindSse2> });
+    if (CpuHasAvx2()) kernels.push_back({ "avx2", FindChecked<FindAvx2> });
+#endif
+    return kernels;
+}
+
+const char* ActiveStringSearchKernel() {
+    return ActiveKernel().name;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+// Case-insensitive Teilstring-Suche ohne gefaltete Kopie des Textes.
+// Der Text (haystack) wird beim Vergleich on-the-fly mit FoldChar gefaltet,
+// die Nadel muss bereits gefaltet sein (FoldText/FoldInto).
+// Auf x86 läuft die Suche mit SSE2 bzw. AVX2 (zur Laufzeit gewählt):
+// Kandidaten werden über erstes und letztes Nadelzeichen blockweise gefiltert
+// und anschließend skalar bestätigt. Blöcke mit Nicht-ASCII-Zeichen werden
+// immer skalar geprüft, das Ergebnis ist also identisch zur skalaren Variante.
+
+// Position des ersten Treffers oder std::wstring_view::npos
+size_t FindFolded(std::wstring_view haystack, std::wstring_view foldedNeedle);
+
+// Skalare Referenz (auch Fallback ohne SIMD)
+size_t FindFoldedScalar(std::wstring_view haystack, std::wstring_view foldedNeedle);
+
+inline bool ContainsFolded(std::wstring_view haystack, std::wstring_view foldedNeedle) {
+    return FindFolded(haystack, foldedNeedle) != std::wstring_view::npos;
+}
+
+// Name des aktiven Kernels ("avx2", "sse2" oder "scalar"), z.B. für den Benchmark
+const char* ActiveStringSearchKernel();
+
+// Alle Kernel, die auf dieser CPU laufen, mit denselben Randfällen wie FindFolded.
+// Für Äquivalenztests gegen FindFoldedScalar, unabhängig davon, welcher aktiv ist.
+struct StringSearchKernel {
+    const char* name;
+    size_t (*find)(std::wstring_view haystack, std::wstring_view foldedNeedle);
+};
+std::vector<StringSearchKernel> AvailableStringSearchKernels();
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cwctype>
+#include <string>
+#include <string_view>
+
+// Einheitliche Kleinschreibung für alle Suchpfade. ASCII wird ohne
+// Locale-Aufruf gefaltet, alles andere geht wie bisher über towlower.
+inline wchar_t FoldChar(wchar_t c) {
+    if (c < 0x80) {
+        return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+    }
+    return static_cast<wchar_t>(::towlower(static_cast<wint_t>(c)));
+}
+
+// Faltet text in out. out behält seine Kapazität, damit wiederholte
+// Aufrufe (z.B. pro Tastendruck) nach dem ersten Mal nichts allokieren.
+inline void FoldInto(std::wstring_view text, std::wstring& out) {
+    out.resize(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        out[i] = FoldChar(text[i]);
+    }
+}
+
+inline std::wstring FoldText(std::wstring_view text) {
+    std::wstring result;
+    FoldInto(text, result);
+    return result;
+}
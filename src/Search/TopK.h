@@ -0,0 +1,17 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Behält nur die besten k Elemente, sortiert nach "better" (a vor b, wenn better(a, b)).
+// Statt die komplette Trefferliste zu sortieren wird per Heap-Auswahl
+// (std::partial_sort) in O(n log k) selektiert; der Rest wird abgeschnitten.
+template <typename T, typename Better>
+void KeepTopK(std::vector<T>& items, size_t k, Better better) {
+    if (items.size() > k) {
+        std::partial_sort(items.begin(), items.begin() + k, items.end(), better);
+        items.erase(items.begin() + k, items.end());
+    } else {
+        std::sort(items.begin(), items.end(), better);
+    }
+}
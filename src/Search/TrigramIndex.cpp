@@ -0,0 +1,199 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+
+// Kopieren und Verschieben müssen die Views auf die eigenen Vektoren neu setzen
+TrigramIndex::TrigramIndex(const TrigramIndex& other) {
+    *this = other;
+}
+
+TrigramIndex::TrigramIndex(TrigramIndex&& other) noexcept {
+    *this = std::move(other);
+}
+
+TrigramIndex& TrigramIndex::operator=(const TrigramIndex& other) {
+    if (this == &other) return *this;
+    m_keys = other.m_keys;
+    m_offsets = other.m_offsets;
+    m_postings = other.m_postings;
+    m_documentCount = other.m_documentCount;
+    m_pending = other.m_pending;
+    m_attached = other.m_attached;
+    if (m_attached) {
+        m_keysView = other.m_keysView;
+        m_offsetsView = other.m_offsetsView;
+        m_postingsView = other.m_postingsView;
+        m_keyCount = other.m_keyCount;
+        m_postingCount = other.m_postingCount;
+    } else {
+        UseOwnArrays();
+    }
+    return *this;
+}
+
+TrigramIndex& TrigramIndex::operator=(TrigramIndex&& other) noexcept {
+    if (this == &other) return *this;
+    m_keys = std::move(other.m_keys);
+    m_offsets = std::move(other.m_offsets);
+    m_postings = std::move(other.m_postings);
+    m_documentCount = other.m_documentCount;
+    m_pending = std::move(other.m_pending);
+    m_attached = other.m_attached;
+    if (m_attached) {
+        m_keysView = other.m_keysView;
+        m_offsetsView = other.m_offsetsView;
+        m_postingsView = other.m_postingsView;
+        m_keyCount = other.m_keyCount;
+        m_postingCount = other.m_postingCount;
+    } else {
+        UseOwnArrays();
+    }
+    other.Clear();
+    return *this;
+}
+
+uint64_t TrigramIndex::MakeKey(const wchar_t* gram) {
+    // 21 Bit pro Zeichen reichen für jeden Unicode-Codepoint bzw. jede UTF-16-Einheit
+    auto unit = [](wchar_t c) { return static_cast<uint64_t>(static_cast<uint32_t>(c) & 0x1FFFFF); };
+    return (unit(gram[0]) << 42) | (unit(gram[1]) << 21) | unit(gram[2]);
+}
+
+void TrigramIndex::Add(uint32_t document, std::wstring_view foldedText) {
+    if (foldedText.size() < GRAM_LENGTH) return;
+    for (size_t i = 0; i + GRAM_LENGTH <= foldedText.size(); ++i) {
+        m_pending.emplace_back(MakeKey(foldedText.data() + i), document);
+    }
+}
+
+void TrigramIndex::Finalize(uint32_t documentCount) {
+    std::sort(m_pending.begin(), m_pending.end());
+    m_pending.erase(std::unique(m_pending.begin(), m_pending.end()), m_pending.end());
+
+    m_keys.clear();
+    m_offsets.clear();
+    m_postings.clear();
+    m_postings.reserve(m_pending.size());
+
+    for (const auto& entry : m_pending) {
+        if (m_keys.empty() || m_keys.back() != entry.first) {
+            m_keys.push_back(entry.first);
+            m_offsets.push_back(static_cast<uint32_t>(m_postings.size()));
+        }
+        m_postings.push_back(entry.second);
+    }
+    m_offsets.push_back(static_cast<uint32_t>(m_postings.size()));
+    m_documentCount = documentCount;
+    m_attached = false;
+    UseOwnArrays();
+
+    // Aufbaupuffer komplett freigeben
+    std::vector<std::pair<uint64_t, uint32_t>>().swap(m_pending);
+}
+
+void TrigramIndex::Clear() {
+    m_keys.clear();
+    m_offsets.clear();
+    m_postings.clear();
+    m_pending.clear();
+    m_documentCount = 0;
+    m_attached = false;
+    UseOwnArrays();
+}
+
+bool TrigramIndex::Candidates(std::wstring_view foldedQuery, std::vector<uint32_t>& out, QueryRanges& ranges) const {
+    out.clear();
+    if (foldedQuery.size() < GRAM_LENGTH) {
+        return false;
+    }
+
+    // Posting-Bereiche aller Query-Trigramme; fehlt eines, gibt es keinen Treffer.
+    // Beide Puffer einmal auf ihre Obergrenze statt mit jeder breiteren Query nachzuwachsen.
+    ranges.clear();
+    if (ranges.capacity() < foldedQuery.size()) ranges.reserve(foldedQuery.size());
+    if (out.capacity() < m_documentCount) out.reserve(m_documentCount);
+    for (size_t i = 0; i + GRAM_LENGTH <= foldedQuery.size(); ++i) {
+        uint64_t key = MakeKey(foldedQuery.data() + i);
+        const uint64_t* keysEnd = m_keysView + m_keyCount;
+        const uint64_t* it = std::lower_bound(m_keysView, keysEnd, key);
+        if (it == keysEnd || *it != key) {
+            return true;
+        }
+        size_t slot = static_cast<size_t>(it - m_keysView);
+        uint32_t first = m_offsetsView[slot];
+        uint32_t last = m_offsetsView[slot + 1];
+        if (first > last || last > m_postingCount) {
+            // Beschädigte Offsets: lieber kein Treffer als außerhalb lesen
+            return true;
+        }
+        ranges.emplace_back(first, last);
+    }
+
+    // Kürzeste Liste zuerst, doppelte Trigramme der Query fallen weg
+    std::sort(ranges.begin(), ranges.end(),
+              [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) {
+                  uint32_t lengthA = a.second - a.first;
+                  uint32_t lengthB = b.second - b.first;
+                  return (lengthA != lengthB) ? lengthA < lengthB : a.first < b.first;
+              });
+    ranges.erase(std::unique(ranges.begin(), ranges.end()), ranges.end());
+
+    // Die Schnittmenge ist Teil der kürzesten Liste; ungültige IDs fallen schon hier weg
+    const auto& shortest = ranges.front();
+    for (uint32_t i = shortest.first; i < shortest.second; ++i) {
+        if (m_postingsView[i] < m_documentCount) {
+            out.push_back(m_postingsView[i]);
+        }
+    }
+    for (size_t r = 1; r < ranges.size() && !out.empty(); ++r) {
+        IntersectGalloping(out, m_postingsView + ranges[r].first,
+                           ranges[r].second - ranges[r].first);
+    }
+    return true;
+}
+
+void TrigramIndex::IntersectGalloping(std::vector<uint32_t>& inOut, const uint32_t* list, size_t length) {
+    size_t write = 0;
+    size_t pos = 0;
+    for (size_t read = 0; read < inOut.size() && pos < length; ++read) {
+        uint32_t value = inOut[read];
+
+        // Exponentiell vorspringen, dann binär im letzten Intervall suchen
+        size_t bound = 1;
+        while (pos + bound < length && list[pos + bound] < value) {
+            bound <<= 1;
+        }
+        const uint32_t* first = list + pos + bound / 2;
+        const uint32_t* last = list + std::min(pos + bound + 1, length);
+        pos = static_cast<size_t>(std::lower_bound(first, last, value) - list);
+
+        if (pos < length && list[pos] == value) {
+            inOut[write++] = value;
+            ++pos;
+        }
+    }
+    inOut.resize(write);
+}
+
+bool TrigramIndex::Attach(const uint64_t* keys, uint32_t keyCount, const uint32_t* offsets,
+                          const uint32_t* postings, uint32_t postingCount, uint32_t documentCount) {
+    Clear();
+    if (!keys || !offsets || (!postings && postingCount > 0) || offsets[0] != 0 || offsets[keyCount] != postingCount) {
+        return false;
+    }
+
+    m_keysView = keys;
+    m_offsetsView = offsets;
+    m_postingsView = postings;
+    m_keyCount = keyCount;
+    m_postingCount = postingCount;
+    m_documentCount = documentCount;
+    m_attached = true;
+    return true;
+}
+
+void TrigramIndex::UseOwnArrays() {
+    m_keysView = m_keys.data();
+    m_offsetsView = m_offsets.data();
+    m_postingsView = m_postings.data();
+    m_keyCount = m_keys.size();
+    m_postingCount = m_postings.size();
+}
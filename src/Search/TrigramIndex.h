@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Invertierter Index über Zeichen-Trigramme (gefaltete Texte).
+// Layout wie CSR: sortierte Trigramm-Schlüssel, Offsets und eine gemeinsame,
+// pro Schlüssel aufsteigend sortierte Posting-Liste mit Dokument-IDs.
+// Candidates() schneidet die Listen aller Query-Trigramme (kürzeste zuerst, galoppierend)
+// und liefert eine Obermenge der Dokumente, die die Query als Teilstring enthalten.
+// Wie der FoldedTextPool kann der Index fremde Arrays (z.B. aus dem eingeblendeten
+// Anwendungs-Cache) ohne Kopie nutzen; ein neuer Aufbau wechselt in eigenen Speicher.
+class TrigramIndex {
+public:
+    static constexpr size_t GRAM_LENGTH = 3;
+
+    TrigramIndex() = default;
+    TrigramIndex(const TrigramIndex& other);
+    TrigramIndex(TrigramIndex&& other) noexcept;
+    TrigramIndex& operator=(const TrigramIndex& other);
+    TrigramIndex& operator=(TrigramIndex&& other) noexcept;
+
+    // Aufbau: beliebig viele Texte pro Dokument hinzufügen, dann Finalize()
+    void Add(uint32_t document, std::wstring_view foldedText);
+    void Finalize(uint32_t documentCount);
+    void Clear();
+
+    // Anzahl der indizierten Dokumente (IDs 0 .. DocumentCount()-1)
+    uint32_t DocumentCount() const { return m_documentCount; }
+    bool Empty() const { return m_keyCount == 0; }
+
+    // Posting-Bereiche einer Query; vom Aufrufer gehalten, damit gleichzeitige Queries
+    // auf demselben Index keinen gemeinsamen Speicher teilen
+    using QueryRanges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    // false: Query zu kurz, der Aufrufer muss selbst alle Dokumente prüfen.
+    // true: out enthält die Kandidaten aufsteigend sortiert (ggf. leer).
+    bool Candidates(std::wstring_view foldedQuery, std::vector<uint32_t>& out, QueryRanges& ranges) const;
+
+    // Nutzt fertige Arrays ohne Kopie; sie müssen bis zum nächsten Clear/Finalize gültig bleiben.
+    // Geprüft werden hier nur die Grenzen (O(1)), damit das Einblenden nichts einliest;
+    // Candidates prüft jeden gelesenen Bereich und verwirft Dokument-IDs außerhalb.
+    // false und leerer Index, wenn die Grenzen nicht passen.
+    bool Attach(const uint64_t* keys, uint32_t keyCount, const uint32_t* offsets,
+                const uint32_t* postings, uint32_t postingCount, uint32_t documentCount);
+
+    // Rohdaten zum Serialisieren; Offsets() hat KeyCount() + 1 Einträge
+    const uint64_t* Keys() const { return m_keysView; }
+    const uint32_t* Offsets() const { return m_offsetsView; }
+    const uint32_t* Postings() const { return m_postingsView; }
+    size_t KeyCount() const { return m_keyCount; }
+    size_t PostingCount() const { return m_postingCount; }
+
+    // Bausteine, die auch inkrementelle Indizes (HistoryIndex) verwenden
+    static uint64_t MakeKey(const wchar_t* gram);
+    static void IntersectGalloping(std::vector<uint32_t>& inOut, const uint32_t* list, size_t length);
+
+private:
+    std::vector<uint64_t> m_keys;
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_postings;
+    uint32_t m_documentCount = 0;
+
+    // Zeigen auf die eigenen Vektoren oder auf angehängte fremde Arrays
+    const uint64_t* m_keysView = nullptr;
+    const uint32_t* m_offsetsView = nullptr;
+    const uint32_t* m_postingsView = nullptr;
+    size_t m_keyCount = 0;
+    size_t m_postingCount = 0;
+    bool m_attached = false;
+
+    // Nur während des Aufbaus belegt
+    std::vector<std::pair<uint64_t, uint32_t>> m_pending;
+
+    void UseOwnArrays();
+};
@@ -0,0 +1,31 @@
+#include "AtomicFile.h"
+
+#include "../Platform/PlatformServices.h"
+#include <fstream>
+#include <system_error>
+
+bool WriteFileAtomically(const std::filesystem::path& path, std::string_view contents) {
+    std::filesystem::path tempPath = path;
+    tempPath += L".tmp";
+
+    bool written = false;
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (out.is_open()) {
+            out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            out.close();
+            written = !out.fail();
+        }
+    }
+
+    // Ohne Sync kann das Umbenennen vor den Daten auf der Platte landen
+    std::error_code ec;
+    if (written && PlatformServices::Instance().FileSystem().SyncFile(tempPath)) {
+        std::filesystem::rename(tempPath, path, ec);
+        if (!ec) {
+            return true;
+        }
+    }
+    std::filesystem::remove(tempPath, ec);
+    return false;
+}
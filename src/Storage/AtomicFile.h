@@ -0,0 +1,10 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+// Schreibt erst nach path + ".tmp", bringt die Datei über IFileSystem::SyncFile auf den
+// Datenträger und ersetzt die Zieldatei dann per Umbenennen, damit nach einem Absturz oder
+// Stromausfall nie eine halb geschriebene oder leere Datei liegt.
+// false, wenn Schreiben, Sync oder Umbenennen fehlschlägt; die Zieldatei bleibt dann unverändert.
+bool WriteFileAtomically(const std::filesystem::path& path, std::string_view contents);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (IEEE 802.3, wie zlib) zur Erkennung beschädigter oder abgeschnittener Datensätze.
+// crc ist der Wert eines vorherigen Aufrufs, um Daten stückweise zu prüfen.
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
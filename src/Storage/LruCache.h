@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// LRU-Cache mit Byte-Budget statt fester Eintragszahl.
+// Jeder Eintrag bringt seine Kosten in Bytes mit; übersteigt die Summe das Budget, fallen
+// die am längsten nicht benutzten Einträge heraus und ihre Werte werden zerstört.
+// Der zuletzt eingefügte Eintrag bleibt immer erhalten, auch wenn er allein das Budget sprengt.
+// Nicht thread-sicher.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    explicit LruCache(size_t byteBudget) : m_byteBudget(byteBudget) {}
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    // Treffer werden als zuletzt benutzt markiert; der Zeiger gilt bis zum nächsten Put/Clear
+    Value* Find(const Key& key) {
+        auto it = m_lookup.find(key);
+        if (it == m_lookup.end()) return nullptr;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->value;
+    }
+
+    bool Contains(const Key& key) const { return m_lookup.find(key) != m_lookup.end(); }
+
+    // Ersetzt einen vorhandenen Eintrag mit gleichem Schlüssel
+    void Put(const Key& key, Value value, size_t bytes) {
+        auto it = m_lookup.find(key);
+        if (it != m_lookup.end()) {
+            m_usedBytes -= it->second->bytes;
+            m_entries.erase(it->second);
+            m_lookup.erase(it);
+        }
+        m_entries.push_front({ key, std::move(value), bytes });
+        m_lookup.emplace(key, m_entries.begin());
+        m_usedBytes += bytes;
+
+        while (m_usedBytes > m_byteBudget && m_entries.size() > 1) {
+            Entry& oldest = m_entries.back();
+            m_usedBytes -= oldest.bytes;
+            m_lookup.erase(oldest.key);
+            m_entries.pop_back();
+        }
+    }
+
+    void Clear() {
+        m_lookup.clear();
+        m_entries.clear();
+        m_usedBytes = 0;
+    }
+
+    size_t Size() const { return m_entries.size(); }
+    size_t UsedBytes() const { return m_usedBytes; }
+    size_t ByteBudget() const { return m_byteBudget; }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t bytes;
+    };
+
+    // Vorne das zuletzt benutzte Element, hinten der nächste Verdrängungskandidat
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> m_lookup;
+    size_t m_byteBudget;
+    size_t m_usedBytes = 0;
+};
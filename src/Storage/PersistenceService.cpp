@@ -0,0 +1,148 @@
+#include "PersistenceService.h"
+
+#include "AtomicFile.h"
+#include <algorithm>
+#include <vector>
+
+using namespace std::chrono;
+
+PersistenceService& PersistenceService::Instance() {
+    static PersistenceService instance;
+    return instance;
+}
+
+PersistenceService::PersistenceService() {
+    m_worker = std::thread(&PersistenceService::WorkerLoop, this);
+}
+
+PersistenceService::~PersistenceService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+    // Was beim Beenden noch aussteht, wird jetzt geschrieben
+    Flush();
+}
+
+void PersistenceService::Schedule(const std::filesystem::path& key, Job job) {
+    steady_clock::time_point now = steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_pending.try_emplace(key);
+        Pending& pending = it->second;
+        if (inserted) {
+            pending.firstChange = now;
+        }
+        pending.job = std::move(job);
+        pending.due = std::min(now + DEBOUNCE, pending.firstChange + MAX_LATENCY);
+    }
+    m_wake.notify_one();
+}
+
+void PersistenceService::ScheduleWrite(const std::filesystem::path& path, std::function<std::string()> serialize) {
+    Schedule(path, [path, serialize = std::move(serialize)]() {
+        return WriteFileAtomically(path, serialize());
+    });
+}
+
+void PersistenceService::Flush() {
+    std::lock_guard<std::mutex> run(m_runMutex);
+    std::vector<Job> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [key, pending] : m_pending) {
+            jobs.push_back(std::move(pending.job));
+        }
+        m_pending.clear();
+    }
+    for (Job& job : jobs) {
+        Run(job);
+    }
+}
+
+void PersistenceService::Flush(const std::filesystem::path& key) {
+    std::lock_guard<std::mutex> run(m_runMutex);
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pending.find(key);
+        if (it == m_pending.end()) {
+            return;
+        }
+        job = std::move(it->second.job);
+        m_pending.erase(it);
+    }
+    Run(job);
+}
+
+void PersistenceService::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        if (m_pending.empty()) {
+            m_wake.wait(lock);
+            continue;
+        }
+
+        steady_clock::time_point due = steady_clock::time_point::max();
+        for (const auto& [key, pending] : m_pending) {
+            due = std::min(due, pending.due);
+        }
+        if (steady_clock::now() < due) {
+            m_wake.wait_until(lock, due);
+            continue;
+        }
+
+        lock.unlock();
+        RunDue();
+        lock.lock();
+    }
+}
+
+void PersistenceService::RunDue() {
+    std::lock_guard<std::mutex> run(m_runMutex);
+    std::vector<std::pair<std::filesystem::path, Job>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        steady_clock::time_point now = steady_clock::now();
+        for (auto it = m_pending.begin(); it != m_pending.end();) {
+            if (it->second.due <= now) {
+                jobs.emplace_back(it->first, std::move(it->second.job));
+                it = m_pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& [key, job] : jobs) {
+        if (!Run(job)) {
+            Reschedule(key, std::move(job));
+        }
+    }
+}
+
+void PersistenceService::Reschedule(const std::filesystem::path& key, Job job) {
+    // Läuft auf dem Worker, der die Wartezeit danach ohnehin neu bestimmt
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto [it, inserted] = m_pending.try_emplace(key);
+    if (!inserted) {
+        // Ein inzwischen gemeldeter Job schreibt den neueren Stand
+        return;
+    }
+    steady_clock::time_point now = steady_clock::now();
+    it->second.job = std::move(job);
+    it->second.firstChange = now;
+    it->second.due = now + RETRY_DELAY;
+}
+
+bool PersistenceService::Run(Job& job) {
+    try {
+        return !job || job();
+    } catch (...) {
+        // Ein fehlgeschlagener Schreibvorgang darf den Thread nicht beenden
+        return false;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Gemeinsamer Hintergrund-Thread für alles, was auf die Platte muss (Verlauf, Frecency,
+// Auswahlen, App-Cache). Statt sofort zu schreiben, meldet ein Besitzer nur "geändert";
+// der Job läuft erst, wenn DEBOUNCE lang nichts Neues kam, spätestens aber MAX_LATENCY nach
+// der ersten Änderung. Eine Serie von Ausführungen ergibt so genau einen Schreibvorgang,
+// und auf dem Eingabepfad passiert keine Datei-I/O.
+// Jobs je Schlüssel (in der Regel die Zieldatei) werden zusammengefasst: der zuletzt
+// gemeldete Job gewinnt. Jobs laufen nie parallel zueinander.
+// Ein Job meldet mit false (oder einer Ausnahme), dass nichts geschrieben wurde; er läuft dann
+// RETRY_DELAY später erneut, sofern bis dahin kein neuerer Job für denselben Schlüssel kam.
+class PersistenceService {
+public:
+    using Job = std::function<bool()>;
+
+    static constexpr std::chrono::milliseconds DEBOUNCE{ 500 };
+    static constexpr std::chrono::milliseconds MAX_LATENCY{ 5000 };
+    static constexpr std::chrono::milliseconds RETRY_DELAY{ 2000 };
+
+    static PersistenceService& Instance();
+
+    ~PersistenceService();
+
+    PersistenceService(const PersistenceService&) = delete;
+    PersistenceService& operator=(const PersistenceService&) = delete;
+
+    // Plant job für key ein bzw. ersetzt einen noch nicht gelaufenen Job
+    void Schedule(const std::filesystem::path& key, Job job);
+
+    // Wie Schedule; serialize läuft auf dem Hintergrund-Thread, das Ergebnis wird per
+    // Schreiben-und-Umbenennen nach path geschrieben
+    void ScheduleWrite(const std::filesystem::path& path, std::function<std::string()> serialize);
+
+    // Führt alle bzw. den ausstehenden Job zu key sofort auf dem aufrufenden Thread aus
+    // und wartet einen gerade laufenden ab (beim Beenden und in Destruktoren der Besitzer).
+    // Das ist der letzte Versuch: scheitert der Job hier, wird er nicht erneut eingeplant.
+    void Flush();
+    void Flush(const std::filesystem::path& key);
+
+private:
+    PersistenceService();
+
+    struct Pending {
+        Job job;
+        std::chrono::steady_clock::time_point firstChange;
+        std::chrono::steady_clock::time_point due;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::map<std::filesystem::path, Pending> m_pending;
+    bool m_stopping = false;
+
+    // Wird beim Herausnehmen und Ausführen gehalten, damit Flush einen laufenden Job abwartet
+    std::mutex m_runMutex;
+
+    std::thread m_worker;
+
+    void WorkerLoop();
+    void RunDue();
+    void Reschedule(const std::filesystem::path& key, Job job);
+    static bool Run(Job& job);
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Ringpuffer fester Kapazität, neuestes Element zuerst.
+// PushFront ist O(1): ist der Puffer voll, wird das älteste Element per Move überschrieben,
+// statt wie bei vector::insert(begin) alle Einträge zu verschieben.
+// Index 0 und begin() liefern das neueste Element, size()-1 das älteste.
+template <typename T>
+class RingBuffer {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const RingBuffer* ring, size_t index) : m_ring(ring), m_index(index) {}
+
+        reference operator*() const { return (*m_ring)[m_index]; }
+        pointer operator->() const { return &(*m_ring)[m_index]; }
+        const_iterator& operator++() { ++m_index; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++m_index; return old; }
+        bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const RingBuffer* m_ring;
+        size_t m_index;
+    };
+
+    explicit RingBuffer(size_t capacity) : m_capacity(capacity > 0 ? capacity : 1) {}
+
+    void PushFront(T value) {
+        if (m_slots.size() < m_capacity) {
+            // Wachstumsphase: m_next ist immer das Ende des Vektors
+            m_slots.push_back(std::move(value));
+        } else {
+            m_slots[m_next] = std::move(value);
+        }
+        m_next = (m_next + 1) % m_capacity;
+        if (m_count < m_capacity) ++m_count;
+    }
+
+    // Ändert die Kapazität und behält dabei die neuesten Elemente
+    void SetCapacity(size_t capacity) {
+        if (capacity == 0) capacity = 1;
+        if (capacity == m_capacity) return;
+
+        std::vector<T> ordered;
+        ordered.reserve(std::min(m_count, capacity));
+        for (size_t i = std::min(m_count, capacity); i-- > 0;) {
+            ordered.push_back(std::move(Slot(i)));
+        }
+        m_slots = std::move(ordered);
+        m_capacity = capacity;
+        m_count = m_slots.size();
+        m_next = m_count % m_capacity;
+    }
+
+    void clear() {
+        m_slots.clear();
+        m_next = 0;
+        m_count = 0;
+    }
+
+    size_t size() const { return m_count; }
+    size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_count == 0; }
+
+    const T& operator[](size_t index) const { return m_slots[Physical(index)]; }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[m_count - 1]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_count); }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_capacity;
+    size_t m_next = 0;  // Nächste Schreibposition, direkt hinter dem neuesten Element
+    size_t m_count = 0;
+
+    size_t Physical(size_t index) const { return (m_next + m_capacity - 1 - index) % m_capacity; }
+    T& Slot(size_t index) { return m_slots[Physical(index)]; }
+};
@@ -0,0 +1,138 @@
+// Nebenläufigkeit der Katalog-Snapshots wie im ApplicationFinder: Leser holen den aktuellen
+// ApplicationCatalog per atomic_load und ranken darauf, während Schreiber neu gebaute und aus
+// der Cache-Datei eingeblendete Kataloge per atomic_store veröffentlichen.
+// Sinnvoll vor allem mit -DWINPAL_SANITIZE_THREAD=ON; ohne TSan prüft der Test nur die Ergebnisse.
+
+#include "Plugins/ApplicationLauncher/ApplicationCache.h"
+#include "Plugins/ApplicationLauncher/ApplicationCatalog.h"
+#include "Search/TextFolding.h"
+#include "Storage/AtomicFile.h"
+#include "Tests/TestSupport.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t kReaders = 4;
+const int kRounds = 12;
+
+std::vector<ApplicationInfo> MakeApplications(int round) {
+    std::vector<ApplicationInfo> applications;
+    // Jede Runde ändert Umfang und Namen, damit sich Index und Treffer wirklich unterscheiden
+    size_t count = 1500 + static_cast<size_t>(round) * 37;
+    for (size_t i = 0; i < count; ++i) {
+        applications.emplace_back(L"App " + std::to_wstring(i) + L" r" + std::to_wstring(round),
+                                  L"C:\\Programs\\app" + std::to_wstring(i) + L".exe",
+                                  L"Tool number " + std::to_wstring(i));
+    }
+    return applications;
+}
+
+struct Shared {
+    ApplicationCatalog::Ptr catalog;
+    std::mutex publishMutex;
+    uint64_t version = 0;
+    std::atomic<bool> stop{ false };
+    std::atomic<long> searches{ 0 };
+    std::atomic<long> errors{ 0 };
+
+    // Versionen steigen wie im ApplicationFinder nur unter dem Schreib-Lock
+    void Publish(const std::function<ApplicationCatalog::Ptr(uint64_t)>& make) {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        ApplicationCatalog::Ptr next = make(version + 1);
+        if (next) {
+            ++version;
+            std::atomic_store(&catalog, std::move(next));
+        }
+    }
+};
+
+void Reader(Shared& shared, size_t seed) {
+    const wchar_t* queries[] = { L"app 1", L"tool", L"aplp 12", L"r3", L"ap", L"number 99" };
+    std::wstring folded;
+    ApplicationIndex::RankScratch scratch;
+    std::vector<uint32_t> ranked;
+    uint64_t lastVersion = 0;
+    for (size_t k = seed; !shared.stop.load(); ++k) {
+        ApplicationCatalog::Ptr catalog = std::atomic_load(&shared.catalog);
+        if (catalog->Version() < lastVersion) ++shared.errors;
+        lastVersion = catalog->Version();
+
+        FoldInto(queries[k % 6], folded);
+        catalog->Rank(folded, 15, scratch, ranked);
+        for (uint32_t index : ranked) {
+            if (index >= catalog->Size() || catalog->Get(index).name.empty()) ++shared.errors;
+        }
+        ++shared.searches;
+    }
+}
+
+void TestConcurrentPublish() {
+    test::TempDirectory temp("winpal-catalogstress");
+    Shared shared;
+    shared.Publish([](uint64_t version) { return ApplicationCatalog::Build(version, 1, MakeApplications(0), ""); });
+
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < kReaders; ++i) {
+        readers.emplace_back(Reader, std::ref(shared), i);
+    }
+
+    // Neu entdeckte Kataloge
+    std::thread builder([&shared]() {
+        for (int round = 1; round <= kRounds; ++round) {
+            std::vector<ApplicationInfo> applications = MakeApplications(round);
+            shared.Publish([&](uint64_t version) {
+                return ApplicationCatalog::Build(version, round, std::move(applications), "");
+            });
+        }
+    });
+
+    // Kataloge über der eingeblendeten Cache-Datei, die ein Vorgänger geschrieben hat
+    std::thread mapper([&shared, &temp]() {
+        std::filesystem::path path = temp.Path() / "applications.bin";
+        for (int round = 1; round <= kRounds; ++round) {
+            std::string contents = std::atomic_load(&shared.catalog)->Serialize();
+            if (!WriteFileAtomically(path, contents)) {
+                ++shared.errors;
+                continue;
+            }
+            std::unique_ptr<ApplicationCache> cache = ApplicationCache::Open(path);
+            if (!cache) {
+                ++shared.errors;
+                continue;
+            }
+            shared.Publish([&](uint64_t version) {
+                return ApplicationCatalog::FromCache(version, std::move(cache));
+            });
+        }
+    });
+
+    builder.join();
+    mapper.join();
+    // Auch der letzte Stand soll noch gelesen werden
+    long searches = shared.searches.load();
+    test::WaitUntil([&]() { return shared.searches.load() > searches + static_cast<long>(kReaders); },
+                    std::chrono::seconds(5));
+    shared.stop = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    CHECK(shared.errors.load() == 0);
+    CHECK(shared.searches.load() > 0);
+    ApplicationCatalog::Ptr last = std::atomic_load(&shared.catalog);
+    CHECK(last->Version() == shared.version);
+    CHECK(shared.version == 2 * kRounds + 1);
+}
+
+} // namespace
+
+int main() {
+    TestConcurrentPublish();
+    return test::Result("CatalogStressTests");
+}
@@ -0,0 +1,240 @@
+// CatalogWatcher über MockDirectoryWatcher: Bündeln der Meldungen zu Stapeln, Überlauf und
+// Ausfall einer Beobachtung, und eine inkrementelle ApplicationDiscovery mit den Stapeln,
+// die denselben Katalog liefern muss wie ein vollständiger Lauf.
+
+#include "Platform/Mock/MockPlatform.h"
+#include "Plugins/ApplicationLauncher/ApplicationDiscovery.h"
+#include "Plugins/ApplicationLauncher/CatalogWatcher.h"
+#include "Plugins/ApplicationLauncher/DirectoryFingerprints.h"
+#include "Tests/TestSupport.h"
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::chrono;
+using Action = DirectoryChange::Action;
+using Candidate = ApplicationDiscovery::Candidate;
+using Changes = ApplicationDiscovery::Changes;
+
+namespace {
+
+MockDirectoryWatcher* g_watcher = nullptr;
+
+// Sammelt die Stapel eines CatalogWatcher
+class BatchCollector {
+public:
+    CatalogWatcher::BatchCallback Callback() {
+        return [this](const Changes& changes) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_batches.push_back(changes);
+            m_arrived.notify_all();
+        };
+    }
+
+    // Wartet auf den ersten Stapel und danach, bis settle lang keiner mehr kommt.
+    // Liefert alle zusammengeführt und vergisst sie; false ohne Stapel.
+    bool Take(Changes& merged, size_t& count, milliseconds settle = milliseconds(800)) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_arrived.wait_for(lock, seconds(5), [this]() { return !m_batches.empty(); })) {
+            return false;
+        }
+        for (size_t seen = 0; seen != m_batches.size();) {
+            seen = m_batches.size();
+            m_arrived.wait_for(lock, settle, [this, seen]() { return m_batches.size() != seen; });
+        }
+        merged = {};
+        for (const Changes& batch : m_batches) {
+            merged.Merge(batch);
+        }
+        count = m_batches.size();
+        m_batches.clear();
+        return true;
+    }
+
+    size_t Count() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_batches.size();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_arrived;
+    std::vector<Changes> m_batches;
+};
+
+void WriteFile(const fs::path& path, const std::string& content) {
+    std::ofstream(path) << content << "\n";
+}
+
+// Jede .exe ist eine Anwendung; die erste Zeile wird zur Beschreibung
+bool DescribeFile(const fs::path& file, Candidate& candidate) {
+    if (file.extension() != ".exe") return false;
+    std::ifstream in(file);
+    std::string line;
+    std::getline(in, line);
+    candidate.name = file.stem().wstring();
+    candidate.path = file.wstring();
+    candidate.description = std::wstring(line.begin(), line.end());
+    return true;
+}
+
+// Zwei überlappende Wurzeln wie Benutzer- und gemeinsames Startmenü
+ApplicationDiscovery MakeDiscovery(const fs::path& root) {
+    ApplicationDiscovery discovery(4);
+    discovery.AddDirectory(root, true, DescribeFile);
+    discovery.AddDirectory(root / "V0", true, DescribeFile);
+    return discovery;
+}
+
+bool SameCatalogue(const std::vector<Candidate>& a, const std::vector<Candidate>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].path != b[i].path || a[i].description != b[i].description) return false;
+    }
+    return true;
+}
+
+void BuildTree(const fs::path& root) {
+    for (int vendor = 0; vendor < 5; ++vendor) {
+        for (int product = 0; product < 5; ++product) {
+            fs::path directory = root / ("V" + std::to_string(vendor)) / ("P" + std::to_string(product));
+            fs::create_directories(directory);
+            for (int file = 0; file < 3; ++file) {
+                WriteFile(directory / ("a" + std::to_string(file) + ".exe"), "v1");
+            }
+        }
+    }
+}
+
+void TestBatching() {
+    test::TempDirectory temp("winpal-catalogwatcher");
+    const fs::path& root = temp.Path();
+    BuildTree(root);
+
+    BatchCollector collector;
+    CatalogWatcher watcher;
+    CHECK(watcher.Start(MakeDiscovery(root).Directories(), collector.Callback()));
+    CHECK(watcher.Complete());
+
+    // Pro Eintrag wird sein Verzeichnis vermerkt, Schlüssel wie im Fingerabdruck-Baum
+    g_watcher->Emit({ { Action::Added, root / "V1" / "P1" / "new.exe" }, { Action::Removed, root / "V2" / "old" } });
+    g_watcher->Emit({ { Action::Modified, root / "top.exe" } });
+    Changes changes;
+    size_t count = 0;
+    CHECK(collector.Take(changes, count));
+    CHECK(count == 1);
+    CHECK(!changes.overflow);
+    CHECK(changes.directories.size() == 3);
+    CHECK(changes.directories.count((root / "V1" / "P1").wstring()) == 1);
+    CHECK(changes.directories.count((root / "V2").wstring()) == 1);
+    CHECK(changes.directories.count(root.wstring()) == 1);
+
+    // Ein Installer mit vielen Dateien ergibt einen Stapel
+    for (int i = 0; i < 200; ++i) {
+        g_watcher->Emit({ { Action::Added, root / "V3" / ("burst" + std::to_string(i) + ".exe") } });
+    }
+    CHECK(collector.Take(changes, count));
+    CHECK(count == 1);
+    CHECK(changes.directories.size() == 1);
+
+    // Dauernde Meldungen verzögern den Stapel höchstens um MAX_LATENCY
+    steady_clock::time_point first = steady_clock::now();
+    steady_clock::time_point firstBatch{};
+    while (steady_clock::now() - first < CatalogWatcher::MAX_LATENCY + seconds(1)) {
+        g_watcher->Emit({ { Action::Modified, root / "V4" / "busy.exe" } });
+        std::this_thread::sleep_for(milliseconds(50));
+        if (firstBatch == steady_clock::time_point{} && collector.Count() > 0) {
+            firstBatch = steady_clock::now();
+        }
+    }
+    CHECK(firstBatch != steady_clock::time_point{});
+    CHECK(firstBatch - first < CatalogWatcher::MAX_LATENCY + milliseconds(500));
+    collector.Take(changes, count);
+
+    // Überlauf: alles nachprüfen, die Beobachtung bleibt aber vollständig
+    g_watcher->Emit({ { Action::Overflow, root } });
+    CHECK(collector.Take(changes, count));
+    CHECK(changes.overflow);
+    CHECK(watcher.Complete());
+
+    // Dauerhafter Ausfall einer Wurzel
+    g_watcher->Emit({ { Action::Stopped, root / "V0" } });
+    CHECK(collector.Take(changes, count));
+    CHECK(changes.overflow);
+    CHECK(!watcher.Complete());
+
+    watcher.Stop();
+    CHECK(!watcher.Complete());
+}
+
+void TestIncrementalRun() {
+    test::TempDirectory temp("winpal-catalogwatcher-run");
+    const fs::path& root = temp.Path();
+    BuildTree(root);
+
+    DirectoryFingerprints previous;
+    std::vector<Candidate> baseline;
+    CHECK(MakeDiscovery(root).Run(baseline, nullptr, &previous));
+    CHECK(baseline.size() == 75);
+
+    BatchCollector collector;
+    CatalogWatcher watcher;
+    CHECK(watcher.Start(MakeDiscovery(root).Directories(), collector.Callback()));
+
+    // Dateisystem ändern und melden, was ein echter Watcher melden würde
+    WriteFile(root / "V1" / "P1" / "new.exe", "added");
+    g_watcher->Emit({ { Action::Added, root / "V1" / "P1" / "new.exe" } });
+    fs::remove(root / "V2" / "P2" / "a0.exe");
+    g_watcher->Emit({ { Action::Removed, root / "V2" / "P2" / "a0.exe" } });
+    fs::rename(root / "V3" / "P3" / "a1.exe", root / "V3" / "P3" / "renamed.exe");
+    g_watcher->Emit({ { Action::RenamedFrom, root / "V3" / "P3" / "a1.exe" },
+                      { Action::RenamedTo, root / "V3" / "P3" / "renamed.exe" } });
+    // Überschreiben ändert die Änderungszeit des Verzeichnisses nicht
+    WriteFile(root / "V4" / "P4" / "a2.exe", "v2");
+    g_watcher->Emit({ { Action::Modified, root / "V4" / "P4" / "a2.exe" } });
+    fs::create_directories(root / "V3" / "NewDir" / "Sub");
+    WriteFile(root / "V3" / "NewDir" / "Sub" / "deep.exe", "new directory");
+    g_watcher->Emit({ { Action::Added, root / "V3" / "NewDir" } });
+    fs::rename(root / "V4" / "P0", root / "V4" / "Moved");
+    g_watcher->Emit({ { Action::RenamedFrom, root / "V4" / "P0" }, { Action::RenamedTo, root / "V4" / "Moved" } });
+    WriteFile(root / "V0" / "P1" / "overlap.exe", "both roots");
+    g_watcher->Emit({ { Action::Added, root / "V0" / "P1" / "overlap.exe" } });
+
+    Changes changes;
+    size_t count = 0;
+    CHECK(collector.Take(changes, count));
+    CHECK(!changes.overflow);
+    watcher.Stop();
+
+    ApplicationDiscovery incremental = MakeDiscovery(root);
+    DirectoryFingerprints next;
+    std::vector<Candidate> updated;
+    CHECK(incremental.Run(updated, &previous, &next, &changes));
+
+    DirectoryFingerprints fullFingerprints;
+    std::vector<Candidate> full;
+    CHECK(MakeDiscovery(root).Run(full, nullptr, &fullFingerprints));
+
+    CHECK(full.size() == 77);
+    CHECK(SameCatalogue(updated, full));
+    CHECK(next.Fingerprint() == fullFingerprints.Fingerprint());
+    // Gelesen werden nur die gemeldeten und die drei neuen Verzeichnisse (V0/P1 liegt unter beiden Wurzeln)
+    CHECK(incremental.DirectoriesRead() <= changes.directories.size() + 4);
+    CHECK(incremental.DirectoriesReused() > 0);
+}
+
+} // namespace
+
+int main() {
+    auto watcher = std::make_unique<MockDirectoryWatcher>();
+    g_watcher = watcher.get();
+    PlatformServices::Instance().SetDirectoryWatcher(std::move(watcher));
+
+    TestBatching();
+    TestIncrementalRun();
+    return test::Result("CatalogWatcherTests");
+}
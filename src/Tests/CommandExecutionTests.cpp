@@ -0,0 +1,143 @@
+// Shebang- und Natural-Commands des CommandManagers gegen die Mock-Plattform: Starts landen im
+// ILauncher, Meldungen im INotifier, die Zwischenablage im IClipboard und "kill" über die
+// ProcessTable im IProcessEnumerator. Erfolgreiche Commands erscheinen im Verlauf.
+
+#include "Commands/CommandManager.h"
+#include "Platform/Mock/MockPlatform.h"
+#include "Tests/TestSupport.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+MockLauncher* g_launcher = nullptr;
+MockNotifier* g_notifier = nullptr;
+MockClipboard* g_clipboard = nullptr;
+MockProcessEnumerator* g_processes = nullptr;
+
+std::pair<std::wstring, std::wstring> LastOpened() {
+    std::vector<std::pair<std::wstring, std::wstring>> opened = g_launcher->Opened();
+    return opened.empty() ? std::pair<std::wstring, std::wstring>() : opened.back();
+}
+
+bool InHistory(CommandManager& manager, const std::wstring& name) {
+    return manager.GetExecutionHistory().CountExecutions(name) > 0;
+}
+
+void TestShebangLaunches(CommandManager& manager) {
+    CHECK(manager.IsShebangCommand(L"!f"));
+    CHECK(!manager.IsShebangCommand(L"f"));
+
+    CHECK(manager.ExecuteShebangCommand(L"!f downloads"));
+    CHECK(LastOpened().first == L"shell:Downloads");
+    CHECK(InHistory(manager, L"Open Downloads Folder"));
+
+    CHECK(manager.ExecuteShebangCommand(L"!N   ipconfig  "));
+    CHECK(LastOpened() == std::make_pair(std::wstring(L"cmd.exe"), std::wstring(L"/k ipconfig /all")));
+
+    CHECK(manager.ExecuteShebangCommand(L"!s disk"));
+    CHECK(LastOpened().first == L"cleanmgr.exe");
+
+    CHECK(manager.ExecuteShebangCommand(L"!d ps"));
+    CHECK(LastOpened().first == L"powershell.exe");
+
+    CHECK(manager.ExecuteShebangCommand(L"!z Sound"));
+    CHECK(LastOpened().first == L"ms-settings:sound");
+    CHECK(InHistory(manager, L"Settings: Sound"));
+
+    CHECK(manager.ExecuteShebangCommand(L"!z"));
+    CHECK(LastOpened().first == L"ms-settings:");
+
+    CHECK(manager.ExecuteShebangCommand(L"!l notepad"));
+    CHECK(LastOpened().first == L"notepad");
+    CHECK(InHistory(manager, L"Launch notepad"));
+
+    // Unbekannte Ziele starten nichts
+    size_t opened = g_launcher->Opened().size();
+    CHECK(!manager.ExecuteShebangCommand(L"!f nowhere"));
+    CHECK(!manager.ExecuteShebangCommand(L"!x"));
+    CHECK(!manager.ExecuteShebangCommand(L"!"));
+    CHECK(g_launcher->Opened().size() == opened);
+}
+
+void TestShebangMessages(CommandManager& manager) {
+    size_t messages = g_notifier->Messages().size();
+    CHECK(manager.ExecuteShebangCommand(L"!c clear"));
+    CHECK(g_clipboard->Clears() == 1);
+    CHECK(InHistory(manager, L"Clear Clipboard"));
+    CHECK(g_notifier->Messages().size() == messages + 1);
+
+    g_clipboard->SetSucceed(false);
+    CHECK(!manager.ExecuteShebangCommand(L"!c"));
+    CHECK(g_clipboard->Clears() == 2);
+    CHECK(g_notifier->Messages().size() == messages + 2);
+    CHECK(g_notifier->Messages().back().first == L"WinPal - Fehler");
+
+    // Git Bash gibt es hier nicht: Meldung statt Start
+    size_t opened = g_launcher->Opened().size();
+    CHECK(!manager.ExecuteShebangCommand(L"!d gitbash"));
+    CHECK(g_launcher->Opened().size() == opened);
+    CHECK(g_notifier->Messages().back().first == L"WinPal - Git Bash");
+
+    // Ein fehlgeschlagener Start landet nicht im Verlauf
+    g_launcher->SetSucceed(false);
+    CHECK(!manager.ExecuteShebangCommand(L"!l missing"));
+    CHECK(!InHistory(manager, L"Launch missing"));
+    g_launcher->SetSucceed(true);
+}
+
+void TestNaturalCommands(CommandManager& manager) {
+    CHECK(manager.IsNaturalCommand(L"Launch calc"));
+    CHECK(manager.IsNaturalCommand(L"kill chrome"));
+    CHECK(!manager.IsNaturalCommand(L"killchrome"));
+    CHECK(!manager.IsNaturalCommand(L"notepad"));
+
+    CHECK(manager.ExecuteNaturalCommand(L"START   calc  "));
+    CHECK(LastOpened().first == L"calc");
+    CHECK(!manager.ExecuteNaturalCommand(L"open   "));
+
+    // "kill" beendet alle Prozesse, deren Name den Begriff enthält, ohne Groß/Kleinschreibung
+    g_processes->AddProcess(100, L"Chrome.exe", 1, 10);
+    g_processes->AddProcess(101, L"chrome.exe", 100, 11);
+    g_processes->AddProcess(102, L"notepad.exe", 1, 12);
+    CHECK(manager.ExecuteNaturalCommand(L"kill CHROME"));
+    std::vector<ProcessEntry> remaining;
+    CHECK(g_processes->Enumerate(remaining));
+    CHECK(remaining.size() == 1 && remaining[0].processId == 102);
+    CHECK(InHistory(manager, L"Terminate CHROME"));
+    CHECK(g_notifier->Messages().back().first == L"WinPal - Prozess beendet");
+
+    CHECK(!manager.ExecuteNaturalCommand(L"stop firefox"));
+    CHECK(g_notifier->Messages().back().first == L"WinPal - Prozess nicht gefunden");
+}
+
+} // namespace
+
+int main() {
+    // CommandManager lädt Verlauf und Auswahlen; ein leeres Verzeichnis hält echte Daten heraus
+    test::TempDirectory temp("winpal-commandexecution");
+    PlatformServices& services = PlatformServices::Instance();
+    services.SetFileSystem(std::make_unique<MockFileSystem>(temp.Path()));
+    auto launcher = std::make_unique<MockLauncher>();
+    auto notifier = std::make_unique<MockNotifier>();
+    auto clipboard = std::make_unique<MockClipboard>();
+    auto processes = std::make_unique<MockProcessEnumerator>();
+    g_launcher = launcher.get();
+    g_notifier = notifier.get();
+    g_clipboard = clipboard.get();
+    g_processes = processes.get();
+    services.SetLauncher(std::move(launcher));
+    services.SetNotifier(std::move(notifier));
+    services.SetClipboard(std::move(clipboard));
+    services.SetProcessEnumerator(std::move(processes));
+
+    {
+        CommandManager manager;
+        TestShebangLaunches(manager);
+        TestShebangMessages(manager);
+        TestNaturalCommands(manager);
+    }
+    return test::Result("CommandExecutionTests");
+}
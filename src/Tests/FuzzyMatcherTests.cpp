@@ -0,0 +1,215 @@
+// FuzzyMatcher gegen eine eigene DP-Referenz (OSA-Distanz, Muster beginnt an beliebiger Stelle):
+// der bit-parallele Pfad bis 64 Zeichen und die DP-Tabelle darüber müssen dieselbe Distanz und
+// dasselbe (früheste) Trefferende liefern. Locate muss einen Ausschnitt liefern, dessen globale
+// Distanz zum Muster der gemeldeten entspricht.
+
+#include "Search/FuzzyMatcher.h"
+#include "Tests/TestSupport.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Reference {
+    bool found = false;
+    uint32_t distance = 0;
+    uint32_t end = 0;
+};
+
+// Volle Tabelle mit Zeile 0 = 0 (freier Anfang im Text); Trefferende j >= 1
+Reference SemiGlobal(const std::wstring& pattern, const std::wstring& text, uint32_t maxDistance) {
+    const size_t m = pattern.size();
+    const size_t n = text.size();
+    std::vector<std::vector<uint32_t>> d(m + 1, std::vector<uint32_t>(n + 1, 0));
+    for (size_t i = 0; i <= m; ++i) d[i][0] = static_cast<uint32_t>(i);
+    for (size_t i = 1; i <= m; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            uint32_t cost = pattern[i - 1] == text[j - 1] ? 0 : 1;
+            d[i][j] = std::min({ d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + cost });
+            if (i > 1 && j > 1 && pattern[i - 1] == text[j - 2] && pattern[i - 2] == text[j - 1]) {
+                d[i][j] = std::min(d[i][j], d[i - 2][j - 2] + 1);
+            }
+        }
+    }
+
+    Reference best;
+    for (size_t j = 1; j <= n; ++j) {
+        if (d[m][j] <= maxDistance && (!best.found || d[m][j] < best.distance)) {
+            best = { true, d[m][j], static_cast<uint32_t>(j) };
+        }
+    }
+    return best;
+}
+
+// Klassische OSA-Distanz zweier ganzer Zeichenketten
+uint32_t Global(const std::wstring& a, const std::wstring& b) {
+    std::vector<std::vector<uint32_t>> d(a.size() + 1, std::vector<uint32_t>(b.size() + 1, 0));
+    for (size_t i = 0; i <= a.size(); ++i) d[i][0] = static_cast<uint32_t>(i);
+    for (size_t j = 0; j <= b.size(); ++j) d[0][j] = static_cast<uint32_t>(j);
+    for (size_t i = 1; i <= a.size(); ++i) {
+        for (size_t j = 1; j <= b.size(); ++j) {
+            uint32_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            d[i][j] = std::min({ d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + cost });
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                d[i][j] = std::min(d[i][j], d[i - 2][j - 2] + 1);
+            }
+        }
+    }
+    return d[a.size()][b.size()];
+}
+
+void CheckAgainstReference(const std::wstring& pattern, const std::wstring& text, uint32_t maxDistance) {
+    FuzzyMatcher matcher;
+    matcher.SetPattern(pattern);
+    FuzzyMatcher::Match match;
+    bool found = matcher.Search(text, maxDistance, match);
+    Reference expected = SemiGlobal(pattern, text, maxDistance);
+
+    bool same = found == expected.found && (!found || (match.distance == expected.distance && match.end == expected.end));
+    if (!same) {
+        std::fprintf(stderr, "Muster %zu, Text %zu, max %u: %d/%u/%u statt %d/%u/%u\n", pattern.size(), text.size(),
+                     maxDistance, found, match.distance, match.end, expected.found, expected.distance, expected.end);
+    }
+    CHECK(same);
+    if (!found) return;
+
+    // Locate findet denselben Treffer und einen Anfang, ab dem die Distanz stimmt
+    FuzzyMatcher::Match located;
+    std::vector<uint32_t> positions;
+    CHECK(matcher.Locate(text, maxDistance, located, positions));
+    CHECK(located.distance == match.distance && located.end == match.end);
+    CHECK(located.start <= located.end);
+    CHECK(Global(pattern, text.substr(located.start, located.end - located.start)) == located.distance);
+    CHECK(std::is_sorted(positions.begin(), positions.end()));
+    CHECK(std::adjacent_find(positions.begin(), positions.end()) == positions.end());
+    CHECK(positions.size() <= pattern.size());
+    for (uint32_t position : positions) {
+        CHECK(position >= located.start && position < located.end);
+        CHECK(pattern.find(text[position]) != std::wstring::npos);
+    }
+}
+
+std::wstring RandomText(std::mt19937& random, const std::wstring& alphabet, size_t length) {
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::wstring text(length, L'\0');
+    for (wchar_t& c : text) c = alphabet[pick(random)];
+    return text;
+}
+
+// Baut einen Text mit dem Muster darin, in das einige Tippfehler eingestreut sind
+std::wstring WithTypos(std::mt19937& random, const std::wstring& alphabet, const std::wstring& pattern, int typos) {
+    std::wstring text = pattern;
+    std::uniform_int_distribution<int> kind(0, 3);
+    for (int t = 0; t < typos && text.size() > 2; ++t) {
+        std::uniform_int_distribution<size_t> at(0, text.size() - 2);
+        size_t i = at(random);
+        switch (kind(random)) {
+            case 0: text[i] = alphabet[i % alphabet.size()]; break;
+            case 1: text.erase(i, 1); break;
+            case 2: text.insert(i, 1, alphabet[(i * 7) % alphabet.size()]); break;
+            default: std::swap(text[i], text[i + 1]); break;
+        }
+    }
+    std::uniform_int_distribution<size_t> padding(0, 12);
+    return RandomText(random, alphabet, padding(random)) + text + RandomText(random, alphabet, padding(random));
+}
+
+void TestKnownDistances() {
+    FuzzyMatcher matcher;
+    FuzzyMatcher::Match match;
+
+    // Vertauschte Nachbarn kosten einen Fehler, nicht zwei
+    matcher.SetPattern(L"notepad");
+    CHECK(matcher.Search(L"ntoepad", 2, match) && match.distance == 1 && match.end == 7);
+    // Bei gleicher Distanz gewinnt das früheste Ende: "notepd" (ein Löschen) vor "notepda"
+    CHECK(matcher.Search(L"run notepda now", 2, match) && match.distance == 1 && match.end == 10);
+    CHECK(matcher.Search(L"my notepad", 0, match) && match.distance == 0 && match.end == 10);
+    CHECK(!matcher.Search(L"calculator", 2, match));
+
+    matcher.SetPattern(L"abcd");
+    CHECK(matcher.Search(L"xbacdx", 1, match) && match.distance == 1 && match.end == 5);
+
+    // Leeres Muster trifft nie, einzelnes Zeichen exakt oder mit einem Fehler
+    matcher.SetPattern(L"");
+    CHECK(matcher.PatternLength() == 0);
+    CHECK(!matcher.Search(L"abc", 3, match));
+    std::vector<uint32_t> positions{ 1, 2 };
+    CHECK(!matcher.Locate(L"abc", 3, match, positions) && positions.empty());
+
+    matcher.SetPattern(L"c");
+    CHECK(matcher.Search(L"abc", 0, match) && match.distance == 0 && match.end == 3);
+    CHECK(!matcher.Search(L"xyz", 0, match));
+    CHECK(matcher.Search(L"xyz", 1, match) && match.distance == 1 && match.end == 1);
+    CHECK(!matcher.Search(L"", 1, match));
+
+    CHECK(FuzzyMatcher::TypoBudget(3) == 0);
+    CHECK(FuzzyMatcher::TypoBudget(4) == 1);
+    CHECK(FuzzyMatcher::TypoBudget(8) == 2);
+}
+
+void TestLocate() {
+    FuzzyMatcher matcher;
+    FuzzyMatcher::Match match;
+    std::vector<uint32_t> positions;
+
+    matcher.SetPattern(L"note");
+    CHECK(matcher.Locate(L"my notes", 0, match, positions));
+    CHECK(match.start == 3 && match.end == 7);
+    CHECK((positions == std::vector<uint32_t>{ 3, 4, 5, 6 }));
+
+    // Die Vertauschung markiert beide Zeichen
+    matcher.SetPattern(L"notepad");
+    CHECK(matcher.Locate(L"run ntoepad", 1, match, positions));
+    CHECK(match.start == 4 && match.end == 11 && match.distance == 1);
+    CHECK((positions == std::vector<uint32_t>{ 4, 5, 6, 7, 8, 9, 10 }));
+
+    // Ersetztes Zeichen wird nicht markiert
+    CHECK(matcher.Locate(L"notxpad", 1, match, positions));
+    CHECK(match.start == 0 && match.end == 7);
+    CHECK((positions == std::vector<uint32_t>{ 0, 1, 2, 4, 5, 6 }));
+}
+
+void TestBoundary() {
+    // 64 Zeichen nutzen das oberste Bit des Bitvektors, 65 die DP-Tabelle
+    std::mt19937 random(64);
+    const std::wstring alphabet = L"abcdefgh";
+    for (size_t length : { 63u, 64u, 65u, 66u }) {
+        std::wstring pattern = RandomText(random, alphabet, length);
+        for (int typos = 0; typos <= 4; ++typos) {
+            std::wstring text = WithTypos(random, alphabet, pattern, typos);
+            CheckAgainstReference(pattern, text, 0);
+            CheckAgainstReference(pattern, text, 2);
+            CheckAgainstReference(pattern, text, static_cast<uint32_t>(length));
+        }
+        // Exakter Treffer ganz am Textende
+        CheckAgainstReference(pattern, L"zz" + pattern, 0);
+    }
+}
+
+void TestRandom() {
+    std::mt19937 random(4242);
+    // Kleines Alphabet für viele Vertauschungen, dazu Nicht-ASCII (eigene Bitmasken)
+    const std::wstring alphabet = L"abcäö中";
+    std::uniform_int_distribution<size_t> patternLength(1, 70);
+    std::uniform_int_distribution<int> typos(0, 3);
+    for (int round = 0; round < 1500; ++round) {
+        std::wstring pattern = RandomText(random, alphabet, patternLength(random));
+        std::wstring text = round % 3 == 0 ? RandomText(random, alphabet, patternLength(random))
+                                           : WithTypos(random, alphabet, pattern, typos(random));
+        CheckAgainstReference(pattern, text, static_cast<uint32_t>(round % 4));
+        CheckAgainstReference(pattern, text, static_cast<uint32_t>(pattern.size()));
+    }
+}
+
+} // namespace
+
+int main() {
+    TestKnownDistances();
+    TestLocate();
+    TestBoundary();
+    TestRandom();
+    return test::Result("FuzzyMatcherTests");
+}
@@ -0,0 +1,297 @@
+// IconThumbnailStore mit echten Icon-Dateien aus Tests/Fixtures: Rasterize mit Alphakanal,
+// mit AND-Maske und beim Verkleinern, dazu Serialize -> Open und beschädigte icons.bin.
+//   alpha32.ico      32x32, 32 bpp: links deckend rot, rechts Alpha 0 (grün), oben links
+//                    ein halbdurchsichtiges blaues Pixel
+//   mask24.ico       32x32, 24 bpp, blau: nur die AND-Maske lässt die Mitte (8..23) stehen
+//   downscale48.ico  48x48, 32 bpp: Spalten 0..22 deckend rot, ab 23 Alpha 0 (grün)
+
+#include "Plugins/ApplicationLauncher/IconThumbnailStore.h"
+#include "Storage/AtomicFile.h"
+#include "Tests/TestSupport.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const size_t kPixels = IconThumbnailStore::PIXEL_BYTES;
+const uint32_t kSize = IconThumbnailStore::ICON_SIZE;
+
+// Farbe und Maske wie IconCache sie per GetDIBits holt: BGRA, von oben nach unten
+struct IconBitmap {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> color;
+    std::vector<uint8_t> mask;
+};
+
+uint32_t ReadU32(const std::string& data, size_t offset) {
+    uint32_t value = 0;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+uint16_t ReadU16(const std::string& data, size_t offset) {
+    uint16_t value = 0;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+std::string ReadFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Erstes Bild einer .ico-Datei: BITMAPINFOHEADER (doppelte Höhe), XOR-Bitmap mit 24 oder
+// 32 bpp und 1-bpp-AND-Maske, beide von unten nach oben mit auf 4 Bytes aufgefüllten Zeilen
+bool LoadIcon(const char* name, IconBitmap& icon) {
+    std::string data = ReadFile(fs::path(WINPAL_TEST_FIXTURES) / name);
+    if (data.size() < 6 + 16 || ReadU16(data, 2) != 1 || ReadU16(data, 4) == 0) {
+        return false;
+    }
+    size_t image = ReadU32(data, 6 + 12);
+    if (image + 40 > data.size() || ReadU32(data, image) != 40) {
+        return false;
+    }
+
+    icon.width = ReadU32(data, image + 4);
+    icon.height = ReadU32(data, image + 8) / 2;
+    uint16_t bpp = ReadU16(data, image + 14);
+    if (bpp != 24 && bpp != 32) {
+        return false;
+    }
+
+    size_t colorStride = (size_t(icon.width) * bpp / 8 + 3) & ~size_t(3);
+    size_t maskStride = (size_t(icon.width) + 31) / 32 * 4;
+    size_t colorOffset = image + 40;
+    size_t maskOffset = colorOffset + colorStride * icon.height;
+    if (maskOffset + maskStride * icon.height > data.size()) {
+        return false;
+    }
+
+    icon.color.assign(size_t(icon.width) * icon.height * 4, 0);
+    icon.mask.assign(icon.color.size(), 0);
+    for (uint32_t y = 0; y < icon.height; ++y) {
+        size_t row = icon.height - 1 - y;
+        for (uint32_t x = 0; x < icon.width; ++x) {
+            uint8_t* color = &icon.color[(size_t(y) * icon.width + x) * 4];
+            std::memcpy(color, data.data() + colorOffset + row * colorStride + size_t(x) * bpp / 8, bpp / 8);
+
+            uint8_t bits = static_cast<uint8_t>(data[maskOffset + row * maskStride + x / 8]);
+            uint8_t masked = (bits & (0x80 >> (x % 8))) ? 0xFF : 0;
+            std::memset(&icon.mask[(size_t(y) * icon.width + x) * 4], masked, 4);
+        }
+    }
+    return true;
+}
+
+const uint8_t* Pixel(const std::vector<uint8_t>& thumbnail, uint32_t x, uint32_t y) {
+    return &thumbnail[(size_t(y) * kSize + x) * 4];
+}
+
+bool IsPixel(const uint8_t* pixel, uint8_t b, uint8_t g, uint8_t r, uint8_t a) {
+    return pixel[0] == b && pixel[1] == g && pixel[2] == r && pixel[3] == a;
+}
+
+bool Rasterize(const char* name, std::vector<uint8_t>& thumbnail) {
+    IconBitmap icon;
+    if (!LoadIcon(name, icon)) {
+        return false;
+    }
+    thumbnail.assign(kPixels, 0xCD);
+    return IconThumbnailStore::Rasterize(icon.color.data(), icon.mask.data(), icon.width, icon.height,
+                                         thumbnail.data());
+}
+
+void TestRasterizeAlpha() {
+    std::vector<uint8_t> thumbnail;
+    CHECK(Rasterize("alpha32.ico", thumbnail));
+    if (thumbnail.size() != kPixels) return;
+
+    // Alpha bleibt unvormultipliziert; die Maske zählt neben einem Alphakanal nicht
+    CHECK(IsPixel(Pixel(thumbnail, 0, 0), 255, 0, 0, 128));
+    CHECK(IsPixel(Pixel(thumbnail, 1, 0), 0, 0, 255, 255));
+    CHECK(IsPixel(Pixel(thumbnail, 15, 31), 0, 0, 255, 255));
+    CHECK(IsPixel(Pixel(thumbnail, 16, 0), 0, 0, 0, 0));
+    CHECK(IsPixel(Pixel(thumbnail, 31, 31), 0, 0, 0, 0));
+}
+
+void TestRasterizeMask() {
+    std::vector<uint8_t> thumbnail;
+    CHECK(Rasterize("mask24.ico", thumbnail));
+    if (thumbnail.size() != kPixels) return;
+
+    CHECK(IsPixel(Pixel(thumbnail, 8, 8), 255, 0, 0, 255));
+    CHECK(IsPixel(Pixel(thumbnail, 23, 23), 255, 0, 0, 255));
+    CHECK(IsPixel(Pixel(thumbnail, 7, 8), 0, 0, 0, 0));
+    CHECK(IsPixel(Pixel(thumbnail, 24, 16), 0, 0, 0, 0));
+    CHECK(IsPixel(Pixel(thumbnail, 0, 0), 0, 0, 0, 0));
+
+    // Ohne Maske ist ein Icon ohne Alphakanal ganz deckend
+    IconBitmap icon;
+    CHECK(LoadIcon("mask24.ico", icon));
+    std::vector<uint8_t> opaque(kPixels, 0);
+    CHECK(IconThumbnailStore::Rasterize(icon.color.data(), nullptr, icon.width, icon.height, opaque.data()));
+    CHECK(IsPixel(Pixel(opaque, 0, 0), 255, 0, 0, 255));
+    CHECK(IsPixel(Pixel(opaque, 31, 31), 255, 0, 0, 255));
+}
+
+void TestRasterizeDownscale() {
+    std::vector<uint8_t> thumbnail;
+    CHECK(Rasterize("downscale48.ico", thumbnail));
+    if (thumbnail.size() != kPixels) return;
+
+    // Spalte 15 mittelt die Quellspalten 22 (rot) und 23 (durchsichtig): halbe Deckkraft,
+    // aber kein Grün aus dem durchsichtigen Pixel
+    for (uint32_t y : { 0u, 15u, 31u }) {
+        CHECK(IsPixel(Pixel(thumbnail, 0, y), 0, 0, 255, 255));
+        CHECK(IsPixel(Pixel(thumbnail, 14, y), 0, 0, 255, 255));
+        CHECK(IsPixel(Pixel(thumbnail, 15, y), 0, 0, 255, 128));
+        CHECK(IsPixel(Pixel(thumbnail, 16, y), 0, 0, 0, 0));
+        CHECK(IsPixel(Pixel(thumbnail, 31, y), 0, 0, 0, 0));
+    }
+
+    // Ungültige Eingaben lehnt Rasterize ab
+    IconBitmap icon;
+    CHECK(LoadIcon("downscale48.ico", icon));
+    CHECK(!IconThumbnailStore::Rasterize(nullptr, nullptr, 32, 32, thumbnail.data()));
+    CHECK(!IconThumbnailStore::Rasterize(icon.color.data(), nullptr, 0, icon.height, thumbnail.data()));
+}
+
+// icons.bin: Header aus sechs uint32, danach Einträge {uint64 key, uint32 block, uint32 reserved}
+const size_t kHeaderSize = 6 * sizeof(uint32_t);
+const size_t kEntrySize = 16;
+
+struct StoreFile {
+    std::string contents;
+    std::vector<uint64_t> keys;
+    std::vector<std::vector<uint8_t>> thumbnails;
+};
+
+StoreFile MakeStoreFile() {
+    StoreFile file;
+    const char* names[] = { "alpha32.ico", "mask24.ico", "downscale48.ico" };
+    IconThumbnailStore store;
+    for (int i = 0; i < 3; ++i) {
+        std::vector<uint8_t> thumbnail;
+        if (!Rasterize(names[i], thumbnail)) {
+            CHECK(!"Fixture fehlt");
+            thumbnail.assign(kPixels, 0);
+        }
+        uint64_t key = IconThumbnailStore::MakeKey(L"C:\\Icons\\" + std::to_wstring(i) + L".ico", 0, 100 + i, 4096);
+        store.Add(key, thumbnail.data());
+        file.keys.push_back(key);
+        file.thumbnails.push_back(thumbnail);
+    }
+    // Gleiches Bild unter anderem Schlüssel teilt sich den Block
+    uint64_t shared = IconThumbnailStore::MakeKey(L"C:\\Links\\Shortcut.lnk", 0, 100, 4096);
+    store.Add(shared, file.thumbnails[0].data());
+    file.keys.push_back(shared);
+    file.thumbnails.push_back(file.thumbnails[0]);
+
+    CHECK(store.Size() == 4);
+    file.contents = store.Serialize();
+    return file;
+}
+
+void TestRoundTrip() {
+    test::TempDirectory temp("winpal-iconstore");
+    fs::path path = temp.Path() / "icons.bin";
+    StoreFile file = MakeStoreFile();
+    CHECK(file.contents.size() == kHeaderSize + 4 * kEntrySize + 3 * kPixels);
+    CHECK(WriteFileAtomically(path, file.contents));
+
+    IconThumbnailStore store;
+    CHECK(store.Open(path));
+    CHECK(store.Size() == 4);
+    std::vector<uint8_t> thumbnail(kPixels, 0);
+    for (size_t i = 0; i < file.keys.size(); ++i) {
+        CHECK(store.Find(file.keys[i], thumbnail.data()));
+        CHECK(thumbnail == file.thumbnails[i]);
+    }
+    CHECK(!store.Find(IconThumbnailStore::MakeKey(L"C:\\Icons\\0.ico", 0, 101, 4096), thumbnail.data()));
+    CHECK(IconThumbnailStore::MakeKey(L"C:\\ICONS\\0.ICO", 0, 100, 4096) == file.keys[0]);
+
+    // Nach Serialize über der Einblendung bleiben alte und neue Einträge erhalten
+    uint64_t added = IconThumbnailStore::MakeKey(L"C:\\Icons\\new.ico", 0, 1, 1);
+    store.Add(added, file.thumbnails[1].data());
+    std::string rewritten = store.Serialize();
+    CHECK(rewritten.size() == kHeaderSize + 5 * kEntrySize + 3 * kPixels);
+    CHECK(WriteFileAtomically(path, rewritten));
+
+    IconThumbnailStore reopened;
+    CHECK(reopened.Open(path));
+    CHECK(reopened.Size() == 5);
+    CHECK(reopened.Find(added, thumbnail.data()) && thumbnail == file.thumbnails[1]);
+    CHECK(reopened.Find(file.keys[2], thumbnail.data()) && thumbnail == file.thumbnails[2]);
+}
+
+bool OpenContents(const fs::path& path, const std::string& contents) {
+    if (!WriteFileAtomically(path, contents)) {
+        return false;
+    }
+    IconThumbnailStore store;
+    bool opened = store.Open(path);
+    // Abgelehnte Dateien hinterlassen einen leeren Store
+    CHECK(opened || store.Size() == 0);
+    return opened;
+}
+
+void TestRejectCorrupt() {
+    test::TempDirectory temp("winpal-iconstore");
+    fs::path path = temp.Path() / "icons.bin";
+    StoreFile file = MakeStoreFile();
+    CHECK(OpenContents(path, file.contents));
+    CHECK(!IconThumbnailStore().Open(temp.Path() / "missing.bin"));
+
+    // Blockverweis hinter den letzten Block
+    std::string badBlock = file.contents;
+    uint32_t blockCount = ReadU32(badBlock, 16);
+    std::memcpy(&badBlock[kHeaderSize + kEntrySize + 8], &blockCount, sizeof(blockCount));
+    CHECK(!OpenContents(path, badBlock));
+
+    // Zwei Einträge vertauscht: Schlüssel nicht mehr aufsteigend
+    std::string unsorted = file.contents;
+    std::string first = unsorted.substr(kHeaderSize, kEntrySize);
+    unsorted.replace(kHeaderSize, kEntrySize, unsorted, kHeaderSize + kEntrySize, kEntrySize);
+    unsorted.replace(kHeaderSize + kEntrySize, kEntrySize, first);
+    CHECK(!OpenContents(path, unsorted));
+
+    // Doppelter Schlüssel
+    std::string duplicate = file.contents;
+    duplicate.replace(kHeaderSize + kEntrySize, 8, duplicate, kHeaderSize, 8);
+    CHECK(!OpenContents(path, duplicate));
+
+    // Größe passt nicht zu den Zählern
+    CHECK(!OpenContents(path, file.contents.substr(0, file.contents.size() - 1)));
+    CHECK(!OpenContents(path, file.contents + std::string(kPixels, '\0')));
+    std::string moreEntries = file.contents;
+    uint32_t entryCount = ReadU32(moreEntries, 12) + 1;
+    std::memcpy(&moreEntries[12], &entryCount, sizeof(entryCount));
+    CHECK(!OpenContents(path, moreEntries));
+
+    // Fremde Datei und andere Icon-Größe
+    std::string badMagic = file.contents;
+    badMagic[0] ^= 0x01;
+    CHECK(!OpenContents(path, badMagic));
+    std::string badSize = file.contents;
+    uint32_t iconSize = 48;
+    std::memcpy(&badSize[8], &iconSize, sizeof(iconSize));
+    CHECK(!OpenContents(path, badSize));
+    CHECK(!OpenContents(path, file.contents.substr(0, 10)));
+}
+
+} // namespace
+
+int main() {
+    TestRasterizeAlpha();
+    TestRasterizeMask();
+    TestRasterizeDownscale();
+    TestRoundTrip();
+    TestRejectCorrupt();
+    return test::Result("IconThumbnailStoreTests");
+}
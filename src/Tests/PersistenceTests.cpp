@@ -0,0 +1,126 @@
+// WriteFileAtomically, HistoryJournal::Rewrite und PersistenceService über MockFileSystem:
+// die temporäre Datei wird vor dem Umbenennen synchronisiert, ein gescheiterter Sync lässt die
+// Zieldatei unverändert, und ein gescheiterter Schreib-Job läuft nach RETRY_DELAY erneut.
+
+#include "Commands/ExecutionHistory.h"
+#include "Commands/HistoryJournal.h"
+#include "Platform/Mock/MockPlatform.h"
+#include "Storage/AtomicFile.h"
+#include "Storage/PersistenceService.h"
+#include "Tests/TestSupport.h"
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace fs = std::filesystem;
+using namespace std::chrono;
+
+namespace {
+
+MockFileSystem* g_fileSystem = nullptr;
+
+std::string ReadFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+void TestWriteFileAtomically(const fs::path& root) {
+    fs::path path = root / "state.bin";
+    fs::path tempPath = root / "state.bin.tmp";
+
+    CHECK(WriteFileAtomically(path, "first"));
+    CHECK(ReadFile(path) == "first");
+    CHECK(!fs::exists(tempPath));
+    std::vector<fs::path> synced = g_fileSystem->Synced();
+    CHECK(synced.size() == 1 && synced[0] == tempPath);
+
+    // Ohne Sync kein Umbenennen: der alte Stand bleibt
+    g_fileSystem->SetSyncSucceed(false);
+    CHECK(!WriteFileAtomically(path, "second"));
+    CHECK(ReadFile(path) == "first");
+    CHECK(!fs::exists(tempPath));
+    g_fileSystem->SetSyncSucceed(true);
+}
+
+HistoryEntry MakeEntry(const std::wstring& name) {
+    HistoryEntry entry;
+    entry.commandName = name;
+    entry.commandDescription = L"Beschreibung";
+    entry.category = CommandCategory::APPLICATION_LAUNCHER;
+    return entry;
+}
+
+void TestJournalRewrite(const fs::path& root) {
+    HistoryJournal journal(root / "history.journal");
+    journal.Append(MakeEntry(L"eins"));
+    CHECK(journal.Flush());
+
+    // Gescheiterter Snapshot: das alte Journal bleibt samt Datensatz erhalten
+    g_fileSystem->SetSyncSucceed(false);
+    CHECK(!journal.Rewrite({ MakeEntry(L"zwei"), MakeEntry(L"drei") }));
+    CHECK(!fs::exists(root / "history.journal.tmp"));
+    std::vector<HistoryEntry> entries;
+    CHECK(journal.Replay(entries));
+    CHECK(entries.size() == 1 && entries[0].commandName == L"eins");
+
+    g_fileSystem->SetSyncSucceed(true);
+    CHECK(journal.Rewrite({ MakeEntry(L"zwei"), MakeEntry(L"drei") }));
+    std::vector<fs::path> synced = g_fileSystem->Synced();
+    CHECK(!synced.empty() && synced.back() == root / "history.journal.tmp");
+    CHECK(journal.Replay(entries));
+    CHECK(entries.size() == 2 && entries[1].commandName == L"drei");
+}
+
+void TestRetry(const fs::path& root) {
+    PersistenceService& persistence = PersistenceService::Instance();
+    fs::path path = root / "retry.bin";
+    CHECK(WriteFileAtomically(path, "old"));
+
+    // Scheitert der Schreibvorgang, läuft er später erneut
+    g_fileSystem->SetSyncSucceed(false);
+    size_t before = g_fileSystem->Synced().size();
+    persistence.ScheduleWrite(path, []() { return std::string("new"); });
+    CHECK(test::WaitUntil([&]() { return g_fileSystem->Synced().size() > before; }, seconds(3)));
+    CHECK(ReadFile(path) == "old");
+
+    g_fileSystem->SetSyncSucceed(true);
+    CHECK(test::WaitUntil([&]() { return ReadFile(path) == "new"; },
+                          PersistenceService::RETRY_DELAY + seconds(2)));
+
+    // Ausnahmen zählen als Fehlschlag; ein neuerer Job ersetzt den wartenden Versuch
+    std::atomic<int> failing{ 0 };
+    std::atomic<int> replacement{ 0 };
+    fs::path key = root / "job";
+    persistence.Schedule(key, [&]() -> bool { ++failing; throw std::runtime_error("disk"); });
+    CHECK(test::WaitUntil([&]() { return failing.load() == 1; }, seconds(3)));
+    persistence.Schedule(key, [&]() { ++replacement; return true; });
+    persistence.Flush(key);
+    CHECK(replacement.load() == 1);
+    std::this_thread::sleep_for(PersistenceService::RETRY_DELAY + milliseconds(500));
+    CHECK(failing.load() == 1);
+    CHECK(replacement.load() == 1);
+
+    // Flush ist der letzte Versuch und plant nichts neu ein
+    std::atomic<int> flushed{ 0 };
+    persistence.Schedule(key, [&]() { ++flushed; return false; });
+    persistence.Flush(key);
+    CHECK(flushed.load() == 1);
+    std::this_thread::sleep_for(PersistenceService::RETRY_DELAY + milliseconds(500));
+    CHECK(flushed.load() == 1);
+}
+
+} // namespace
+
+int main() {
+    test::TempDirectory temp("winpal-persistence");
+    auto fileSystem = std::make_unique<MockFileSystem>(temp.Path());
+    g_fileSystem = fileSystem.get();
+    PlatformServices::Instance().SetFileSystem(std::move(fileSystem));
+
+    TestWriteFileAtomically(temp.Path());
+    TestJournalRewrite(temp.Path());
+    TestRetry(temp.Path());
+    return test::Result("PersistenceTests");
+}
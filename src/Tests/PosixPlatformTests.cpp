@@ -0,0 +1,226 @@
+// Die POSIX-Implementierungen der Platform-Interfaces gegen das echte System:
+// PosixDirectoryWatcher (inotify) hinter einem CatalogWatcher auf einem temporären Baum,
+// PosixProcessEnumerator (/proc) hinter der ProcessTable mit einem eigenen Kindprozess,
+// PosixFileSystem mit mmap und fsync.
+
+#include "Platform/PlatformServices.h"
+#include "Platform/Posix/PosixPlatform.h"
+#include "Plugins/ApplicationLauncher/ApplicationDiscovery.h"
+#include "Plugins/ApplicationLauncher/CatalogWatcher.h"
+#include "Plugins/ApplicationLauncher/DirectoryFingerprints.h"
+#include "Plugins/ProcessTools/ProcessTable.h"
+#include "Tests/TestSupport.h"
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+using namespace std::chrono;
+using Candidate = ApplicationDiscovery::Candidate;
+using Changes = ApplicationDiscovery::Changes;
+
+namespace {
+
+// Führt die Stapel eines CatalogWatcher zusammen
+class BatchCollector {
+public:
+    CatalogWatcher::BatchCallback Callback() {
+        return [this](const Changes& changes) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_merged.Merge(changes);
+            ++m_count;
+            m_arrived.notify_all();
+        };
+    }
+
+    // Wartet auf den ersten Stapel und danach, bis eine Sekunde lang keiner mehr kommt
+    bool Take(Changes& merged) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_arrived.wait_for(lock, seconds(5), [this]() { return m_count > 0; })) {
+            return false;
+        }
+        for (size_t seen = 0; seen != m_count;) {
+            seen = m_count;
+            m_arrived.wait_for(lock, seconds(1), [this, seen]() { return m_count != seen; });
+        }
+        merged = std::move(m_merged);
+        m_merged = {};
+        m_count = 0;
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_arrived;
+    Changes m_merged;
+    size_t m_count = 0;
+};
+
+void WriteFile(const fs::path& path, const std::string& content) {
+    std::ofstream(path) << content << "\n";
+}
+
+bool DescribeFile(const fs::path& file, Candidate& candidate) {
+    if (file.extension() != ".exe") return false;
+    std::ifstream in(file);
+    std::string line;
+    std::getline(in, line);
+    candidate.name = file.stem().wstring();
+    candidate.path = file.wstring();
+    candidate.description = std::wstring(line.begin(), line.end());
+    return true;
+}
+
+ApplicationDiscovery MakeDiscovery(const fs::path& root) {
+    ApplicationDiscovery discovery(4);
+    discovery.AddDirectory(root, true, DescribeFile);
+    discovery.AddDirectory(root / "V0", true, DescribeFile);
+    return discovery;
+}
+
+bool SameCatalogue(const std::vector<Candidate>& a, const std::vector<Candidate>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].path != b[i].path || a[i].description != b[i].description) return false;
+    }
+    return true;
+}
+
+// Inkrementeller Lauf mit den gemeldeten Änderungen muss dem vollständigen gleichen
+void CheckIncremental(const fs::path& root, DirectoryFingerprints& previous, const Changes& changes) {
+    DirectoryFingerprints next;
+    std::vector<Candidate> updated;
+    CHECK(MakeDiscovery(root).Run(updated, &previous, &next, &changes));
+
+    DirectoryFingerprints fullFingerprints;
+    std::vector<Candidate> full;
+    CHECK(MakeDiscovery(root).Run(full, nullptr, &fullFingerprints));
+    CHECK(SameCatalogue(updated, full));
+    CHECK(next.Fingerprint() == fullFingerprints.Fingerprint());
+    previous = std::move(next);
+}
+
+void TestDirectoryWatcher() {
+    test::TempDirectory temp("winpal-inotify");
+    const fs::path& root = temp.Path();
+    for (int vendor = 0; vendor < 10; ++vendor) {
+        for (int product = 0; product < 10; ++product) {
+            fs::path directory = root / ("V" + std::to_string(vendor)) / ("P" + std::to_string(product));
+            fs::create_directories(directory);
+            for (int file = 0; file < 5; ++file) {
+                WriteFile(directory / ("a" + std::to_string(file) + ".exe"), "v1");
+            }
+        }
+    }
+
+    DirectoryFingerprints previous;
+    std::vector<Candidate> baseline;
+    CHECK(MakeDiscovery(root).Run(baseline, nullptr, &previous));
+
+    BatchCollector collector;
+    CatalogWatcher watcher;
+    CHECK(watcher.Start(MakeDiscovery(root).Directories(), collector.Callback()));
+
+    WriteFile(root / "V3" / "P3" / "new.exe", "added");
+    fs::remove(root / "V4" / "P4" / "a0.exe");
+    fs::rename(root / "V5" / "P5" / "a1.exe", root / "V5" / "P5" / "renamed.exe");
+    WriteFile(root / "V6" / "P6" / "a2.exe", "v2 in place");
+    fs::create_directories(root / "V7" / "NewDir" / "Sub");
+    WriteFile(root / "V7" / "NewDir" / "Sub" / "deep.exe", "new directory");
+    fs::rename(root / "V8" / "P8", root / "V8" / "Moved");
+    WriteFile(root / "V0" / "P1" / "overlap.exe", "both roots");
+    for (int i = 0; i < 300; ++i) {
+        WriteFile(root / "V9" / "P9" / ("burst" + std::to_string(i) + ".exe"), "burst");
+    }
+
+    Changes changes;
+    CHECK(collector.Take(changes));
+    CHECK(!changes.overflow);
+    CHECK(changes.directories.count((root / "V3" / "P3").wstring()) == 1);
+    CHECK(changes.directories.count((root / "V6" / "P6").wstring()) == 1);
+    CHECK(changes.directories.count((root / "V8").wstring()) == 1);
+    CheckIncremental(root, previous, changes);
+
+    // Neue und verschobene Verzeichnisse werden seitdem ebenfalls beobachtet
+    WriteFile(root / "V7" / "NewDir" / "Sub" / "later.exe", "later");
+    WriteFile(root / "V8" / "Moved" / "later.exe", "moved later");
+    fs::remove(root / "V8" / "Moved" / "a3.exe");
+    CHECK(collector.Take(changes));
+    CHECK(changes.directories.count((root / "V7" / "NewDir" / "Sub").wstring()) == 1);
+    CHECK(changes.directories.count((root / "V8" / "Moved").wstring()) == 1);
+    CheckIncremental(root, previous, changes);
+
+    // Verschwindet eine Wurzel, ist die Beobachtung nicht mehr vollständig
+    CHECK(watcher.Complete());
+    fs::remove_all(root / "V0");
+    CHECK(collector.Take(changes));
+    CHECK(changes.overflow);
+    CHECK(!watcher.Complete());
+    watcher.Stop();
+}
+
+void TestProcessEnumerator() {
+    IProcessEnumerator& processes = PlatformServices::Instance().Processes();
+    std::vector<ProcessEntry> entries;
+    CHECK(processes.Enumerate(entries));
+
+    const ProcessEntry* self = nullptr;
+    for (const ProcessEntry& entry : entries) {
+        if (entry.processId == static_cast<uint32_t>(getpid())) self = &entry;
+    }
+    CHECK(self != nullptr);
+    if (self) {
+        CHECK(self->parentProcessId == static_cast<uint32_t>(getppid()));
+        CHECK(self->startTime > 0);
+        // /proc kürzt den Namen auf 15 Zeichen
+        CHECK(self->exeName == L"PosixPlatformTe");
+    }
+
+    // Ein neuer Kindprozess erscheint in der Tabelle und verschwindet nach Terminate
+    ProcessTable& table = ProcessTable::Instance();
+    pid_t child = fork();
+    if (child == 0) {
+        pause();
+        _exit(0);
+    }
+    CHECK(child > 0);
+    ProcessTable::SnapshotPtr snapshot = table.Fresh(milliseconds(0));
+    const ProcessTable::Process* process = snapshot->FindById(static_cast<uint32_t>(child));
+    CHECK(process != nullptr);
+    CHECK(process && process->parentProcessId == static_cast<uint32_t>(getpid()));
+    CHECK(!table.SuggestNames(L"posixplatform", 4).empty());
+
+    CHECK(processes.Terminate(static_cast<uint32_t>(child)));
+    int status = 0;
+    CHECK(waitpid(child, &status, 0) == child);
+    CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGTERM);
+    CHECK(!table.Fresh(milliseconds(0))->FindById(static_cast<uint32_t>(child)));
+}
+
+void TestFileSystem() {
+    test::TempDirectory temp("winpal-posixfs");
+    IFileSystem& fileSystem = PlatformServices::Instance().FileSystem();
+    fs::path path = temp.Path() / "file.bin";
+    WriteFile(path, "contents");
+
+    CHECK(fileSystem.SyncFile(path));
+    CHECK(!fileSystem.SyncFile(temp.Path() / "missing.bin"));
+
+    std::unique_ptr<IMappedFile> mapped = fileSystem.MapReadOnly(path);
+    CHECK(mapped && std::string(mapped->Data(), mapped->Size()) == "contents\n");
+}
+
+} // namespace
+
+int main() {
+    InstallPosixPlatformServices();
+
+    TestDirectoryWatcher();
+    TestProcessEnumerator();
+    TestFileSystem();
+    return test::Result("PosixPlatformTests");
+}
@@ -0,0 +1,116 @@
+// ProcessTable über MockProcessEnumerator: Aktualisieren mit Übernahme unveränderter Prozesse,
+// wiederverwendete Prozess-IDs, Rangfolge von Match und die "!t"-Vorschläge.
+
+#include "Platform/Mock/MockPlatform.h"
+#include "Plugins/ProcessTools/ProcessTable.h"
+#include "Search/TextFolding.h"
+#include "Tests/TestSupport.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+using Process = ProcessTable::Process;
+
+namespace {
+
+MockProcessEnumerator* g_processes = nullptr;
+
+Process MakeProcess(uint32_t processId, const std::wstring& name) {
+    Process process;
+    process.processId = processId;
+    process.name = name;
+    process.foldedName = FoldText(name);
+    return process;
+}
+
+void TestMatch() {
+    ProcessTable::Snapshot snapshot(1, { MakeProcess(5, L"SearchHost.exe"), MakeProcess(7, L"chrome.exe"),
+                                         MakeProcess(3, L"Chrome.exe"), MakeProcess(9, L"notepad.exe"),
+                                         MakeProcess(4, L"cmd.exe") });
+    CHECK(snapshot.Size() == 5);
+    CHECK(snapshot.FindById(9) && snapshot.FindById(9)->name == L"notepad.exe");
+    CHECK(!snapshot.FindById(6));
+
+    // Namensanfang vor Teilstring, gleiche Namen nach Prozess-ID
+    std::vector<const Process*> matches;
+    snapshot.Match(FoldText(L"CH"), 10, matches);
+    CHECK(matches.size() == 3);
+    CHECK(matches.size() == 3 && matches[0]->processId == 3 && matches[1]->processId == 7);
+    CHECK(matches.size() == 3 && matches[2]->processId == 5);
+
+    snapshot.Match(FoldText(L"ch"), 1, matches);
+    CHECK(matches.size() == 1 && matches[0]->processId == 3);
+
+    // Vertauschte Buchstaben findet die Fehlertoleranz
+    snapshot.Match(FoldText(L"notpead"), 10, matches);
+    CHECK(matches.size() == 1 && matches[0]->processId == 9);
+
+    snapshot.Match(FoldText(L"xyz"), 10, matches);
+    CHECK(matches.empty());
+}
+
+void TestRefresh() {
+    ProcessTable& table = ProcessTable::Instance();
+    g_processes->AddProcess(10, L"Chrome.exe", 1, 100);
+    g_processes->AddProcess(11, L"chrome.exe", 10, 101);
+    g_processes->AddProcess(12, L"notepad.exe", 1, 102);
+    g_processes->AddProcess(13, L"Code.exe", 1, 103);
+
+    ProcessTable::SnapshotPtr first = table.Refresh();
+    CHECK(first->Size() == 4);
+    CHECK(first->FindById(11) && first->FindById(11)->parentProcessId == 10);
+
+    // Ohne Änderung bleibt derselbe Stand
+    ProcessTable::SnapshotPtr unchanged = table.Refresh();
+    CHECK(unchanged == first);
+    CHECK(table.Current() == first);
+
+    // Wiederverwendete Prozess-ID mit anderer Startzeit ist ein neuer Prozess
+    g_processes->Terminate(12);
+    g_processes->AddProcess(12, L"notepad.exe", 1, 200);
+    ProcessTable::SnapshotPtr reused = table.Refresh();
+    CHECK(reused != first);
+    CHECK(reused->Version() > first->Version());
+    CHECK(reused->FindById(12) && reused->FindById(12)->startTime == 200);
+    CHECK(reused->FindById(10) && reused->FindById(10)->foldedName == L"chrome.exe");
+
+    // Fresh aktualisiert auf dem aufrufenden Thread; alte Stände bleiben gültig
+    g_processes->Terminate(13);
+    ProcessTable::SnapshotPtr fresh = table.Fresh(milliseconds(0));
+    CHECK(!fresh->FindById(13));
+    CHECK(first->FindById(13) && first->FindById(13)->name == L"Code.exe");
+}
+
+void TestSuggestNames() {
+    ProcessTable& table = ProcessTable::Instance();
+    table.Refresh();
+
+    // Mehrere Instanzen ergeben einen Vorschlag, ohne ".exe"
+    std::vector<std::wstring> names = table.SuggestNames(L"ch", 6);
+    CHECK(names.size() == 1 && names[0] == L"Chrome");
+
+    names = table.SuggestNames(L"ntoepad", 6);
+    CHECK(names.size() == 1 && names[0] == L"notepad");
+
+    // Ohne Anfrage die zuletzt gestarteten zuerst
+    names = table.SuggestNames(L"", 4);
+    CHECK(names.size() == 2);
+    CHECK(names.size() == 2 && names[0] == L"notepad" && names[1] == L"chrome");
+
+    names = table.SuggestNames(L"", 1);
+    CHECK(names.size() == 1);
+}
+
+} // namespace
+
+int main() {
+    auto processes = std::make_unique<MockProcessEnumerator>();
+    g_processes = processes.get();
+    PlatformServices::Instance().SetProcessEnumerator(std::move(processes));
+
+    TestMatch();
+    TestRefresh();
+    TestSuggestNames();
+    return test::Result("ProcessTableTests");
+}
@@ -0,0 +1,172 @@
+// Allokationen pro Tastendruck: nach dem Aufwärmen darf die Suche in Commands, Apps und
+// Verlauf nicht mehr allokieren. Erlaubt ist nur das einmalige Wachsen der Puffer mit der
+// längsten bisherigen Query (Ebenen des Präfix-Stacks, Query-Wörter); andere Tipp-Sitzungen,
+// die nicht länger sind als die zum Aufwärmen, müssen ohne eine einzige Allokation auskommen.
+
+#include "Commands/CommandManager.h"
+#include "Commands/HistoryIndex.h"
+#include "Platform/Mock/MockPlatform.h"
+#include "Plugins/ApplicationLauncher/ApplicationIndex.h"
+#include "Search/TextFolding.h"
+#include "Tests/TestSupport.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// --- Allokationszähler wie in winpal_bench -----------------------------------
+
+namespace {
+std::atomic<uint64_t> g_allocations{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+const wchar_t* const kVendors[] = { L"Microsoft", L"Adobe", L"Google", L"Mozilla", L"JetBrains", L"Valve", L"Docker" };
+const wchar_t* const kProducts[] = { L"Studio", L"Code", L"Chrome", L"Firefox", L"Rider", L"Player", L"Terminal",
+                                     L"Manager", L"Desktop", L"Console", L"Designer" };
+
+struct Entry {
+    std::wstring name;
+    std::wstring description;
+};
+
+std::vector<Entry> MakeCatalogue(size_t count) {
+    std::vector<Entry> entries;
+    for (size_t i = 0; i < count; ++i) {
+        std::wstring vendor = kVendors[i % std::size(kVendors)];
+        std::wstring product = kProducts[(i / 3) % std::size(kProducts)];
+        entries.push_back({ vendor + L" " + product + L" " + std::to_wstring(i % 97),
+                            vendor + L" tool #" + std::to_wstring(i) });
+    }
+    return entries;
+}
+
+// Jede Zwischenstufe der Wörter ist ein Tastendruck; "Tippfehler" erzwingen die Fuzzy-Stufe
+std::vector<std::wstring> Keystrokes(const std::vector<std::wstring>& words) {
+    std::vector<std::wstring> keystrokes;
+    for (const std::wstring& word : words) {
+        for (size_t length = 1; length <= word.size(); ++length) {
+            keystrokes.push_back(word.substr(0, length));
+        }
+    }
+    return keystrokes;
+}
+
+// Zum Aufwärmen: bestimmt nur die erlaubte Tiefe. Absichtlich schmal (kaum Treffer, ein Wort),
+// damit die Sitzungen danach mehr Kandidaten und Wörter haben als alles zuvor
+const std::vector<std::wstring> kWarmup = Keystrokes({ L"qxqxqxqxqxqxqx", L"termnial" });
+
+// Breite Queries, teils mit Tippfehler, keine länger als die längste beim Aufwärmen
+const std::vector<std::wstring> kSessions = Keystrokes({
+    L"e", L"o o o o o o o", L"microsoft stu", L"goolge chr", L"mozilla fire", L"adobe designer",
+    L"rdier", L"console 12", L"valve player 4", L"docker desktop"
+});
+
+template <typename SearchFn>
+uint64_t CountAllocations(const std::vector<std::wstring>& keystrokes, SearchFn&& search) {
+    uint64_t before = g_allocations.load(std::memory_order_relaxed);
+    for (const std::wstring& query : keystrokes) {
+        search(query);
+    }
+    return g_allocations.load(std::memory_order_relaxed) - before;
+}
+
+class TestCommand : public ICommand {
+public:
+    TestCommand(const std::wstring& name, const std::wstring& description)
+        : m_name(name), m_description(description) {}
+
+    std::wstring GetName() const override { return m_name; }
+    std::wstring GetDescription() const override { return m_description; }
+    CommandCategory GetCategory() const override { return CommandCategory::UNKNOWN; }
+    void Execute() override {}
+
+private:
+    std::wstring m_name;
+    std::wstring m_description;
+};
+
+void TestCommands(const std::vector<Entry>& catalogue) {
+    CommandManager manager;
+    for (const Entry& entry : catalogue) {
+        manager.RegisterCommand(std::make_unique<TestCommand>(entry.name, entry.description));
+    }
+    manager.RebuildSearchIndex();
+
+    std::vector<SearchResult> results;
+    auto search = [&](const std::wstring& query) { manager.FindCommandsWithRelevance(std::wstring_view(query), results); };
+    CountAllocations(kWarmup, search);
+    CHECK(CountAllocations(kSessions, search) == 0);
+    CHECK(CountAllocations(kWarmup, search) == 0);
+    CHECK(!results.empty());
+}
+
+void TestApplications(const std::vector<Entry>& catalogue) {
+    ApplicationIndex index;
+    for (const Entry& entry : catalogue) {
+        index.Add(entry.name, entry.description);
+    }
+    index.BuildTrigrams();
+
+    std::wstring folded;
+    std::vector<uint32_t> ranked;
+    auto search = [&](const std::wstring& query) {
+        FoldInto(query, folded);
+        index.Rank(folded, 15, ranked);
+    };
+    CountAllocations(kWarmup, search);
+    CHECK(CountAllocations(kSessions, search) == 0);
+    CHECK(CountAllocations(kWarmup, search) == 0);
+    CHECK(!ranked.empty());
+}
+
+void TestHistory(const std::vector<Entry>& catalogue) {
+    HistoryIndex index;
+    for (const Entry& entry : catalogue) {
+        index.Add(HistoryEntry(L"Launch " + entry.name, entry.description, CommandCategory::APPLICATION_LAUNCHER));
+    }
+
+    std::wstring folded;
+    std::vector<HistoryIndex::Match> matches;
+    auto search = [&](const std::wstring& query) {
+        FoldInto(query, folded);
+        index.Search(folded, 6, matches);
+    };
+    CountAllocations(kWarmup, search);
+    CHECK(CountAllocations(kSessions, search) == 0);
+    CHECK(CountAllocations(kWarmup, search) == 0);
+}
+
+} // namespace
+
+int main() {
+    // CommandManager lädt Verlauf und Auswahlen; ein leeres Verzeichnis hält echte Daten heraus
+    test::TempDirectory temp("winpal-allocations");
+    PlatformServices::Instance().SetFileSystem(std::make_unique<MockFileSystem>(temp.Path()));
+
+    std::vector<Entry> catalogue = MakeCatalogue(3000);
+    TestCommands(catalogue);
+    TestApplications(catalogue);
+    TestHistory(catalogue);
+    return test::Result("SearchAllocationTests");
+}
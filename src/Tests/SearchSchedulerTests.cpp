@@ -0,0 +1,257 @@
+// SearchScheduler mit steuerbaren Providern: neuere Queries brechen ältere Generationen ab,
+// deren Treffer nie in einer neueren Generation landen, und die Zusammenführung sortiert nach
+// Score, fasst gleiche Commands zusammen und kürzt auf maxResults.
+
+#include "Search/SearchScheduler.h"
+#include "Tests/TestSupport.h"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace {
+
+class TestCommand : public ICommand {
+public:
+    explicit TestCommand(const std::wstring& name) : m_name(name) {}
+
+    std::wstring GetName() const override { return m_name; }
+    std::wstring GetDescription() const override { return L""; }
+    CommandCategory GetCategory() const override { return CommandCategory::UNKNOWN; }
+    void Execute() override {}
+
+private:
+    std::wstring m_name;
+};
+
+// Liefert je Query feste Treffer; mit Hold() bleibt Search hängen, bis Release() kommt
+// oder die Generation abgebrochen wird
+class ScriptedProvider : public ISearchProvider {
+public:
+    void SetHits(const std::wstring& query, std::vector<SearchHit> hits) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hits[query] = std::move(hits);
+    }
+
+    void Hold() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_holding = true;
+    }
+
+    void Release() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_holding = false;
+        }
+        m_changed.notify_all();
+    }
+
+    // Wartet, bis Search für query begonnen hat
+    bool WaitForStart(const std::wstring& query) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_changed.wait_for(lock, seconds(5), [&]() { return m_started.count(query) > 0; });
+    }
+
+    size_t CancelledCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_cancelled;
+    }
+
+    void Search(const std::wstring& query, const CancellationToken& token, std::vector<SearchHit>& hits) override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_started.insert(query);
+        m_changed.notify_all();
+        while (m_holding && !token.IsCancelled()) {
+            m_changed.wait_for(lock, milliseconds(5));
+        }
+        if (token.IsCancelled()) {
+            ++m_cancelled;
+        }
+        // Absichtlich auch abgebrochen liefern: der Scheduler muss veraltete Treffer verwerfen
+        auto it = m_hits.find(query);
+        if (it != m_hits.end()) {
+            hits = it->second;
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::map<std::wstring, std::vector<SearchHit>> m_hits;
+    std::set<std::wstring> m_started;
+    bool m_holding = false;
+    size_t m_cancelled = 0;
+};
+
+std::shared_ptr<ICommand> MakeCommand(const std::wstring& name) {
+    return std::make_shared<TestCommand>(name);
+}
+
+bool Contains(const std::vector<SearchHit>& hits, const std::shared_ptr<ICommand>& command) {
+    for (const SearchHit& hit : hits) {
+        if (hit.command == command) return true;
+    }
+    return false;
+}
+
+// Sammelt die Generationen aus dem Callback
+class CallbackLog {
+public:
+    SearchScheduler::ResultsCallback Callback() {
+        return [this](uint64_t generation) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_generations.push_back(generation);
+        };
+    }
+
+    size_t Count(uint64_t generation) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = 0;
+        for (uint64_t seen : m_generations) {
+            count += seen == generation;
+        }
+        return count;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<uint64_t> m_generations;
+};
+
+void TestCancellation() {
+    auto slow = std::make_unique<ScriptedProvider>();
+    auto fast = std::make_unique<ScriptedProvider>();
+    ScriptedProvider* slowProvider = slow.get();
+    ScriptedProvider* fastProvider = fast.get();
+
+    std::shared_ptr<ICommand> stale = MakeCommand(L"stale");
+    std::shared_ptr<ICommand> current = MakeCommand(L"current");
+    std::shared_ptr<ICommand> fastStale = MakeCommand(L"fast stale");
+    slowProvider->SetHits(L"a", { { stale, 9.0 } });
+    slowProvider->SetHits(L"ab", { { current, 5.0 } });
+    fastProvider->SetHits(L"a", { { fastStale, 8.0 } });
+
+    CallbackLog log;
+    SearchScheduler scheduler(2, 10, log.Callback());
+    scheduler.AddProvider(std::move(slow));
+    scheduler.AddProvider(std::move(fast));
+
+    slowProvider->Hold();
+    uint64_t first = scheduler.Submit(L"a");
+    CHECK(slowProvider->WaitForStart(L"a"));
+    CHECK(test::WaitUntil([&]() { return log.Count(first) == 1; }, seconds(5)));
+
+    // Teilweise Treffer der laufenden Generation sind sichtbar, aber nicht vollständig
+    std::vector<SearchHit> results;
+    bool complete = true;
+    CHECK(scheduler.TakeResults(first, results, complete));
+    CHECK(!complete);
+    CHECK(results.size() == 1 && results[0].command == fastStale);
+    CHECK(!scheduler.WaitForGeneration(first, milliseconds(50)));
+
+    // Die neue Query bricht den hängenden Provider ab; sein Ergebnis für "a" wird verworfen
+    uint64_t second = scheduler.Submit(L"ab");
+    CHECK(second > first);
+    CHECK(scheduler.LatestGeneration() == second);
+    CHECK(!scheduler.TakeResults(first, results, complete));
+    CHECK(!scheduler.WaitForGeneration(first, milliseconds(50)));
+    slowProvider->Release();
+
+    CHECK(scheduler.WaitForGeneration(second, seconds(5)));
+    CHECK(scheduler.TakeResults(second, results, complete));
+    CHECK(complete);
+    CHECK(results.size() == 1 && results[0].command == current);
+    CHECK(!Contains(results, stale));
+    CHECK(!Contains(results, fastStale));
+    CHECK(slowProvider->CancelledCount() == 1);
+    CHECK(test::WaitUntil([&]() { return log.Count(second) == 2; }, seconds(5)));
+    CHECK(log.Count(first) == 1);
+
+    // Cancel verwirft auch die fertige Generation
+    scheduler.Cancel();
+    CHECK(!scheduler.TakeResults(second, results, complete));
+    CHECK(!scheduler.WaitForGeneration(second, milliseconds(10)));
+
+    // Danach sucht der Scheduler normal weiter
+    uint64_t third = scheduler.Submit(L"ab");
+    CHECK(scheduler.WaitForGeneration(third, seconds(5)));
+    CHECK(scheduler.TakeResults(third, results, complete));
+    CHECK(complete && results.size() == 1);
+}
+
+void TestMerge() {
+    auto first = std::make_unique<ScriptedProvider>();
+    auto second = std::make_unique<ScriptedProvider>();
+
+    std::shared_ptr<ICommand> shared = MakeCommand(L"shared");
+    std::shared_ptr<ICommand> high = MakeCommand(L"high");
+    std::shared_ptr<ICommand> low = MakeCommand(L"low");
+    std::shared_ptr<ICommand> middle = MakeCommand(L"middle");
+    std::shared_ptr<ICommand> dropped = MakeCommand(L"dropped");
+    first->SetHits(L"q", { { shared, 2.0 }, { high, 10.0 }, { low, 1.0 }, { nullptr, 50.0 } });
+    second->SetHits(L"q", { { shared, 7.0 }, { middle, 5.0 }, { dropped, 0.5 } });
+
+    SearchScheduler scheduler(3, 4, nullptr);
+    scheduler.AddProvider(std::move(first));
+    scheduler.AddProvider(std::move(second));
+    scheduler.AddProvider(nullptr); // wird ignoriert
+
+    uint64_t generation = scheduler.Submit(L"q");
+    CHECK(scheduler.WaitForGeneration(generation, seconds(5)));
+    std::vector<SearchHit> results;
+    bool complete = false;
+    CHECK(scheduler.TakeResults(generation, results, complete));
+    CHECK(complete);
+
+    // Gleicher Command mit höchstem Score, absteigend sortiert, leere Treffer fallen weg,
+    // der schwächste über maxResults hinaus wird abgeschnitten
+    CHECK(results.size() == 4);
+    if (results.size() == 4) {
+        CHECK(results[0].command == high && results[0].score == 10.0);
+        CHECK(results[1].command == shared && results[1].score == 7.0);
+        CHECK(results[2].command == middle);
+        CHECK(results[3].command == low);
+    }
+    CHECK(!Contains(results, dropped));
+}
+
+// Ein Provider, der wirft, liefert keine Treffer, hält die Generation aber nicht auf
+class ThrowingProvider : public ISearchProvider {
+public:
+    void Search(const std::wstring&, const CancellationToken&, std::vector<SearchHit>& hits) override {
+        hits.push_back({ MakeCommand(L"half"), 1.0 });
+        throw std::runtime_error("provider");
+    }
+};
+
+void TestThrowingProvider() {
+    auto scripted = std::make_unique<ScriptedProvider>();
+    std::shared_ptr<ICommand> found = MakeCommand(L"found");
+    scripted->SetHits(L"q", { { found, 1.0 } });
+
+    SearchScheduler scheduler(2, 10, nullptr);
+    scheduler.AddProvider(std::make_unique<ThrowingProvider>());
+    scheduler.AddProvider(std::move(scripted));
+
+    uint64_t generation = scheduler.Submit(L"q");
+    CHECK(scheduler.WaitForGeneration(generation, seconds(5)));
+    std::vector<SearchHit> results;
+    bool complete = false;
+    CHECK(scheduler.TakeResults(generation, results, complete));
+    CHECK(complete && results.size() == 1 && results[0].command == found);
+}
+
+} // namespace
+
+int main() {
+    TestCancellation();
+    TestMerge();
+    TestThrowingProvider();
+    return test::Result("SearchSchedulerTests");
+}
@@ -0,0 +1,145 @@
+// FindFolded: jeder auf dieser CPU lauffähige Kernel (SSE2, AVX2) muss genau das liefern, was
+// FindFoldedScalar liefert. Zufällige Texte aus einem kleinen Alphabet erzeugen viele
+// Kandidaten; die Längen laufen über die Blockgrenzen (8/16 bzw. 4/8 Zeichen je Register,
+// je nach Breite von wchar_t) und das 16- bzw. 32-Zeichen-Raster hinaus.
+
+#include "Search/StringSearch.h"
+#include "Search/TextFolding.h"
+#include "Tests/TestSupport.h"
+#include <clocale>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Groß/klein, Zeichen, die sich nur im Bit 0x20 unterscheiden ohne Buchstaben zu sein
+// ('@'/'`', '['/'{'), und Nicht-ASCII, dessen unteres Byte wie ein ASCII-Buchstabe aussieht
+std::vector<wchar_t> Alphabet() {
+    std::vector<wchar_t> alphabet = { L'a', L'b', L'A', L'B', L'z', L'Z', L'@', L'`', L'[', L'{', L' ',
+                                      L'Ä', L'ä', L'Ł', L'š', L'中' };
+    if (sizeof(wchar_t) == 4) {
+        alphabet.push_back(static_cast<wchar_t>(0x10061));
+    }
+    return alphabet;
+}
+
+std::wstring RandomText(std::mt19937& random, const std::vector<wchar_t>& alphabet, size_t length) {
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::wstring text(length, L'\0');
+    for (wchar_t& c : text) {
+        c = alphabet[pick(random)];
+    }
+    return text;
+}
+
+size_t g_compared = 0;
+
+void Compare(const StringSearchKernel& kernel, const std::wstring& haystack, const std::wstring& needle) {
+    ++g_compared;
+    size_t expected = FindFoldedScalar(haystack, needle);
+    size_t actual = kernel.find(haystack, needle);
+    if (actual != expected) {
+        std::fprintf(stderr, "%s: haystack %zu, needle %zu: %zu statt %zu\n", kernel.name, haystack.size(),
+                     needle.size(), actual, expected);
+    }
+    CHECK(actual == expected);
+}
+
+void TestRandom(const StringSearchKernel& kernel) {
+    std::mt19937 random(20241017);
+    std::vector<wchar_t> alphabet = Alphabet();
+    for (size_t length = 0; length <= 80; ++length) {
+        for (int round = 0; round < 60; ++round) {
+            std::wstring haystack = RandomText(random, alphabet, length);
+
+            // Zufällige Nadeln treffen selten, gefaltete Ausschnitte immer
+            std::uniform_int_distribution<size_t> needleLength(1, 6);
+            Compare(kernel, haystack, FoldText(RandomText(random, alphabet, needleLength(random))));
+            if (length > 0) {
+                std::uniform_int_distribution<size_t> start(0, length - 1);
+                size_t from = start(random);
+                std::uniform_int_distribution<size_t> count(1, length - from);
+                Compare(kernel, haystack, FoldText(haystack.substr(from, count(random))));
+            }
+        }
+    }
+}
+
+void TestEdges(const StringSearchKernel& kernel) {
+    for (size_t length : { 1u, 7u, 8u, 9u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 48u, 63u, 64u, 65u }) {
+        std::wstring haystack(length, L'x');
+
+        // Einzelnes Zeichen an jeder Position, auch im letzten angebrochenen Block
+        for (size_t position = 0; position < length; ++position) {
+            std::wstring text = haystack;
+            text[position] = L'Q';
+            Compare(kernel, text, L"q");
+            CHECK(kernel.find(text, L"q") == position);
+        }
+
+        // Längere Nadel, die genau am Ende endet
+        for (size_t needle = 2; needle <= length; needle += 3) {
+            std::wstring text = haystack;
+            for (size_t k = length - needle; k < length; ++k) text[k] = L'N';
+            text[length - needle] = L'M';
+            Compare(kernel, text, L"m" + std::wstring(needle - 1, L'n'));
+            CHECK(kernel.find(text, L"m" + std::wstring(needle - 1, L'n')) == length - needle);
+        }
+
+        // Nadel länger als der Text, leere Nadel, leerer Text
+        Compare(kernel, haystack, std::wstring(length + 1, L'x'));
+        CHECK(kernel.find(haystack, std::wstring(length + 1, L'x')) == std::wstring_view::npos);
+        CHECK(kernel.find(haystack, L"") == 0);
+    }
+    CHECK(kernel.find(L"", L"") == 0);
+    CHECK(kernel.find(L"", L"a") == std::wstring_view::npos);
+}
+
+void TestNonAscii(const StringSearchKernel& kernel) {
+    // Ein Nicht-ASCII-Zeichen mit dem unteren Byte von 'A' darf kein 'a' treffen
+    std::wstring text = std::wstring(40, L'Ł') + L"xa";
+    CHECK(kernel.find(text, L"a") == 41);
+    CHECK(kernel.find(text, FoldText(L"ŁŁx")) == 38);
+    Compare(kernel, text, L"ax");
+
+    // '[' ist kein großes '{'
+    CHECK(kernel.find(std::wstring(20, L'[') + L"{", L"{") == 20);
+    CHECK(kernel.find(std::wstring(20, L'@'), L"`") == std::wstring_view::npos);
+
+    std::wstring mixed = L"Grüße aus MÜNCHEN und 中文 Überall " + std::wstring(20, L'-') + L"Straße";
+    for (const wchar_t* needle : { L"münchen", L"grüße", L"中文", L"straße", L"überall", L"-s" }) {
+        Compare(kernel, mixed, FoldText(needle));
+    }
+}
+
+} // namespace
+
+int main() {
+    // Erst mit einer UTF-8-Locale faltet towlower auch Nicht-ASCII (Ä -> ä); in der C-Locale
+    // bliebe der Nicht-ASCII-Pfad der Kernel ungeprüft
+    if (!std::setlocale(LC_CTYPE, "C.UTF-8") && !std::setlocale(LC_CTYPE, "en_US.UTF-8") &&
+        !std::setlocale(LC_CTYPE, ".UTF8")) {
+        std::printf("keine UTF-8-Locale, Nicht-ASCII wird nicht gefaltet\n");
+    }
+
+    std::vector<StringSearchKernel> kernels = AvailableStringSearchKernels();
+    CHECK(!kernels.empty());
+    for (const StringSearchKernel& kernel : kernels) {
+        std::printf("kernel %s\n", kernel.name);
+        TestRandom(kernel);
+        TestEdges(kernel);
+        TestNonAscii(kernel);
+    }
+
+    // Der aktive Kernel ist einer davon, FindFolded nutzt ihn
+    bool listed = false;
+    for (const StringSearchKernel& kernel : kernels) {
+        listed = listed || std::string(kernel.name) == ActiveStringSearchKernel();
+    }
+    CHECK(listed);
+    CHECK(FindFolded(L"Hello World", L"world") == 6);
+    CHECK(g_compared > 10000);
+    return test::Result("StringSearchTests");
+}
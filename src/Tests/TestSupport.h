@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+
+// Gemeinsame Hilfen der Headless-Tests. CHECK zählt Fehlschläge und läuft weiter;
+// main gibt am Ende test::Result zurück, ctest wertet den Exit-Code aus.
+
+namespace test {
+
+inline int& FailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void Fail(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+    ++FailureCount();
+}
+
+inline int Result(const char* name) {
+    if (FailureCount() == 0) {
+        std::printf("%s: ok\n", name);
+        return 0;
+    }
+    std::fprintf(stderr, "%s: %d check(s) failed\n", name, FailureCount());
+    return 1;
+}
+
+// Wartet, bis condition() gilt; false nach timeout
+template <typename Condition>
+bool WaitUntil(Condition&& condition, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+// Leeres Verzeichnis unter dem temporären Verzeichnis, wird mit dem Objekt gelöscht
+class TempDirectory {
+public:
+    explicit TempDirectory(const std::string& name)
+        : m_path(std::filesystem::temp_directory_path() / (name + "-" + std::to_string(Unique()))) {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+        std::filesystem::create_directories(m_path);
+    }
+
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+    }
+
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    const std::filesystem::path& Path() const { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+
+    // Parallel laufende Tests (ctest -j) dürfen sich nicht in die Quere kommen
+    static long long Unique() {
+        return static_cast<long long>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+};
+
+} // namespace test
+
+#define CHECK(condition) ((condition) ? (void)0 : ::test::Fail(__FILE__, __LINE__, #condition))
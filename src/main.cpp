@@ -18,6 +18,18 @@
 #include "Commands/ICommand.h"
 #include "Commands/ExecutionHistory.h"
 #include "Plugins/ApplicationLauncher/GenericLaunchCommand.h"
+#include "Plugins/ApplicationLauncher/LaunchApplicationCommand.h"
+#include "Plugins/ApplicationLauncher/ApplicationSearchProvider.h"
+#include "Plugins/ApplicationLauncher/IconCache.h"
+#include "Plugins/ApplicationLauncher/ApplicationFinder.h"
+#include "Plugins/ProcessTools/ProcessSearchProvider.h"
+#include "Plugins/ProcessTools/ProcessTable.h"
+#include "Commands/CommandSearchProvider.h"
+#include "Commands/HistorySearchProvider.h"
+#include "Search/SearchScheduler.h"
+#include "Platform/Win32/Win32Platform.h"
+#include "Storage/PersistenceService.h"
+#include "Diagnostics/StartupProfiler.h"
 
 #pragma comment(lib, "gdiplus.lib")
 #pragma comment(lib, "dwmapi.lib") // Link against the DWM API
@@ -28,7 +40,7 @@ using namespace Gdiplus;
 HWND g_hwnd;
 HotkeyManager g_hotkeyManager;
 GuiManager g_guiManager;
-CommandManager g_commandManager;
+std::unique_ptr<CommandManager> g_commandManager; // erst nach InstallWin32PlatformServices angelegt
 std::wstring g_inputBuffer;
 std::vector<ICommand*> g_foundCommands;
 int g_selectedCommand = 0;
@@ -40,6 +52,21 @@ ULONG_PTR g_gdiplusToken;
 
 // Einfache, begrenzte Suche für maximale Performance
 const int MAX_SEARCH_RESULTS = 15;  // Allow up to 15 results for better coverage
+
+// Asynchrone Suche: Provider laufen auf Worker-Threads, Ergebnisse kommen per Nachricht zurück.
+// g_foundCommands zeigt in g_searchHits, das die dynamischen Treffer (Apps, Prozesse) am Leben hält.
+const UINT WM_APP_SEARCH_RESULTS = WM_APP + 1;
+const UINT WM_APP_ICONS_READY = WM_APP + 2;
+const UINT WM_APP_CATALOG_CHANGED = WM_APP + 3;
+const size_t SEARCH_WORKER_COUNT = 4; // Ein Worker pro Provider
+std::unique_ptr<SearchScheduler> g_searchScheduler;
+uint64_t g_searchGeneration = 0;
+std::vector<SearchHit> g_searchHits;
+// Generation der angezeigten Liste und ob alle Provider darin enthalten sind
+uint64_t g_shownGeneration = 0;
+bool g_shownComplete = false;
+// So lange wartet Enter höchstens auf die Treffer der aktuellen Eingabe
+const std::chrono::milliseconds ENTER_SEARCH_TIMEOUT(1000);
 
 // Autocomplete-Feature Variablen
 std::vector<std::wstring> g_autocompleteSuggestions;
@@ -89,11 +116,15 @@ const std::wstring HISTORY_ICON = L"H";
 HICON GetIconFromCommand(ICommand* cmd) {
     // Check if this is a GenericLaunchCommand and try to get the icon
     if (cmd->GetCategory() == CommandCategory::APPLICATION_LAUNCHER) {
+        // Icons kommen aus dem IconCache; fehlt eins noch, zeichnet WM_APP_ICONS_READY nach
+        if (LaunchApplicationCommand* appCmd = dynamic_cast<LaunchApplicationCommand*>(cmd)) {
+            return appCmd->GetIcon();
+        }
         GenericLaunchCommand* launchCmd = dynamic_cast<GenericLaunchCommand*>(cmd);
         if (launchCmd) {
             auto apps = launchCmd->GetMatchingApplications();
-            if (!apps.empty() && apps[0].hIcon) {
-                return apps[0].hIcon;
+            if (!apps.empty()) {
+                return IconCache::Instance().Request(IconCache::KeyFor(apps[0]));
             }
         }
     }
@@ -143,7 +174,7 @@ void UpdateWindowSize() {
         windowHeight = 65 + (55 + 2) * displayedResults;
     } else if (g_inputBuffer.empty()) {
         // Zeige History wenn keine Eingabe vorhanden
-        const ExecutionHistory& history = g_commandManager.GetExecutionHistory();
+        const ExecutionHistory& history = g_commandManager->GetExecutionHistory();
         if (!history.IsEmpty()) {
             // Height for input bar + history entries (up to MAX_SEARCH_RESULTS)
             int historyCount = min((int)history.GetHistory().size(), MAX_SEARCH_RESULTS);
@@ -221,33 +252,12 @@ std::vector<std::wstring> GetShebangSuggestions(const std::wstring& input) {
                 }
                 break;
             }
-            case L't': // Terminate command - SCHNELLE statische Vorschläge
+            case L't': // Terminate command - laufende Prozesse aus der ProcessTable
             {
-                // KEINE Prozess-Auflistung mehr - nur vordefinierte häufige Prozesse
-                static const std::vector<std::wstring> commonProcesses = {
-                    L"notepad", L"chrome", L"firefox", L"spotify", 
-                    L"code", L"steam", L"explorer", L"word", L"excel"
-                };
-                
-                if (!searchTerm.empty()) {
-                    // Filtere nur aus der statischen Liste
-                    std::wstring lowerSearchTerm = searchTerm;
-                    std::transform(lowerSearchTerm.begin(), lowerSearchTerm.end(), lowerSearchTerm.begin(), ::towlower);
-                    
-                    for (const auto& process : commonProcesses) {
-                        std::wstring lowerProcess = process;
-                        std::transform(lowerProcess.begin(), lowerProcess.end(), lowerProcess.begin(), ::towlower);
-                        
-                        if (lowerProcess.find(lowerSearchTerm) != std::wstring::npos) {
-                            suggestions.push_back(L"!t " + process);
-                            if (suggestions.size() >= 6) break; // Begrenze Ergebnisse
-                        }
-                    }
-                } else {
-                    // Zeige nur die ersten 4 häufigen Prozesse
-                    for (size_t i = 0; i < commonProcesses.size() && i < 4; ++i) {
-                        suggestions.push_back(L"!t " + commonProcesses[i]);
-                    }
+                // Kein Prozess-Snapshot auf dem Tastendruck-Pfad: die Tabelle wird im Hintergrund aktuell gehalten
+                size_t limit = searchTerm.empty() ? 4 : 6; // Ohne Suchterm die zuletzt gestarteten
+                for (const auto& process : ProcessTable::Instance().SuggestNames(searchTerm, limit)) {
+                    suggestions.push_back(L"!t " + process);
                 }
                 break;
             }
@@ -290,7 +300,9 @@ void UpdateFoundCommands(const std::wstring& searchTerm) {
     
     // Wenn das Suchfeld leer ist, zeige keine Commands an (damit der Verlauf angezeigt wird)
     if (searchTerm.empty()) {
+        if (g_searchScheduler) g_searchScheduler->Cancel();
         g_foundCommands.clear();
+        g_searchHits.clear();
         g_selectedCommand = 0;
         UpdateWindowSize(); // Fenstergröße anpassen
         return;
@@ -298,6 +310,9 @@ void UpdateFoundCommands(const std::wstring& searchTerm) {
     
     // Prüfe auf Shebang-Commands und generiere Autocomplete-Vorschläge
     if (!searchTerm.empty() && searchTerm[0] == L'!') {
+        if (g_searchScheduler) g_searchScheduler->Cancel();
+        g_foundCommands.clear();
+        g_searchHits.clear();
         g_autocompleteSuggestions = GetShebangSuggestions(searchTerm);
         if (!g_autocompleteSuggestions.empty()) {
             g_isAutocompleteMode = true;
@@ -307,17 +322,71 @@ void UpdateFoundCommands(const std::wstring& searchTerm) {
         return;
     }
     
-    // Suche über den CommandManager und limitiere die Ergebnisse
-    g_foundCommands.clear();
-    auto results = g_commandManager.FindCommands(searchTerm);
-    for (size_t i = 0; i < results.size() && i < MAX_SEARCH_RESULTS; ++i) {
-        g_foundCommands.push_back(results[i]);
-    }
+    // Suche an die Worker übergeben; die bisherige Liste bleibt bis zu den neuen Treffern stehen
+    if (g_searchScheduler) {
+        g_searchGeneration = g_searchScheduler->Submit(searchTerm);
+    }
     
     g_selectedCommand = 0;
     UpdateWindowSize(); // Fenstergröße anpassen
 }
 
+// Übernimmt die zusammengeführten Treffer der aktuellen Generation (WM_APP_SEARCH_RESULTS)
+void ApplySearchResults() {
+    if (!g_searchScheduler) return;
+    
+    // Ausgewählten Treffer festhalten, damit er beim Nachladen weiterer Provider ausgewählt bleibt
+    std::shared_ptr<ICommand> selected;
+    if (g_selectedCommand >= 0 && g_selectedCommand < static_cast<int>(g_searchHits.size())) {
+        selected = g_searchHits[g_selectedCommand].command;
+    }
+    
+    bool complete = false;
+    if (!g_searchScheduler->TakeResults(g_searchGeneration, g_searchHits, complete)) {
+        return; // Veraltet, eine neuere Suche läuft bereits
+    }
+    g_shownGeneration = g_searchGeneration;
+    g_shownComplete = complete;
+    
+    g_foundCommands.clear();
+    g_selectedCommand = 0;
+    for (const auto& hit : g_searchHits) {
+        if (hit.command.get() == selected.get()) {
+            g_selectedCommand = static_cast<int>(g_foundCommands.size());
+        }
+        g_foundCommands.push_back(hit.command.get());
+    }
+    
+    UpdateWindowSize();
+    InvalidateRect(g_hwnd, NULL, FALSE);
+}
+
+// Enter darf nur auf den vollständigen Treffern der aktuellen Eingabe handeln. Sonst würde ein
+// Treffer der vorigen Eingabe ausgeführt (und vom Auswahlmodell für die neue gelernt) oder
+// mangels Treffern PowerShell gestartet. Wartet dazu auf die laufende Generation;
+// false, wenn sie nicht rechtzeitig fertig wird.
+bool FinishCurrentSearch() {
+    if (!g_searchScheduler || g_inputBuffer.empty() || g_inputBuffer[0] == L'!') {
+        return true; // Keine Suche: Verlauf bzw. Shebang-Vorschläge
+    }
+    if (g_shownGeneration == g_searchGeneration && g_shownComplete) {
+        return true;
+    }
+    g_searchScheduler->WaitForGeneration(g_searchGeneration, ENTER_SEARCH_TIMEOUT);
+    ApplySearchResults();
+    return g_shownGeneration == g_searchGeneration && g_shownComplete;
+}
+
+// Baut den Kern in fester Reihenfolge ab, nie über die statische Abbaureihenfolge: erst den
+// Scheduler (seine Provider halten Referenzen auf den Manager), dann den Manager, dessen
+// Verlauf, Frecency und Auswahlen im Destruktor über den PersistenceService flushen, zuletzt
+// die übrigen ausstehenden Schreibvorgänge. Mehrfacher Aufruf ist harmlos.
+void ShutdownCore() {
+    g_searchScheduler.reset();
+    g_commandManager.reset();
+    PersistenceService::Instance().Flush();
+}
+
 
 // Window Procedure
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
@@ -467,7 +536,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
             }
 
             // --- Results List Drawing ---
-            const ExecutionHistory& history = g_commandManager.GetExecutionHistory();
+            const ExecutionHistory& history = g_commandManager->GetExecutionHistory();
             bool hasHistory = !history.IsEmpty();
             bool hasSearchResults = !g_foundCommands.empty();
             bool hasSearchText = !g_inputBuffer.empty();
@@ -745,17 +814,21 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
                     // Navigation left/right is not needed anymore in the new layout.
                     break;
                 case VK_RETURN: {
+                    if (!FinishCurrentSearch()) {
+                        break; // Treffer kommen noch per WM_APP_SEARCH_RESULTS, erneutes Enter führt aus
+                    }
                     if (!g_foundCommands.empty() && g_selectedCommand < g_foundCommands.size()) {
-                        // Verwende die neue ExecuteCommand Methode mit History-Tracking
-                        g_commandManager.ExecuteCommand(g_foundCommands[g_selectedCommand]);
+                        // Verwende die neue ExecuteCommand Methode mit History-Tracking;
+                        // die Eingabe lernt, welcher Treffer dafür gewählt wurde
+                        g_commandManager->ExecuteCommand(g_foundCommands[g_selectedCommand], g_inputBuffer);
                         g_isWindowVisible = false;
                         ShowWindow(g_hwnd, SW_HIDE);
                         g_inputBuffer.clear();
                         UpdateFoundCommands(L"");
                     } else if (!g_inputBuffer.empty()) {
                         // Prüfe zuerst auf Shebang-Commands (!l, !t etc.)
-                        if (g_commandManager.IsShebangCommand(g_inputBuffer)) {
-                            if (g_commandManager.ExecuteShebangCommand(g_inputBuffer)) {
+                        if (g_commandManager->IsShebangCommand(g_inputBuffer)) {
+                            if (g_commandManager->ExecuteShebangCommand(g_inputBuffer)) {
                                 g_isWindowVisible = false;
                                 ShowWindow(g_hwnd, SW_HIDE);
                                 g_inputBuffer.clear();
@@ -764,8 +837,8 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
                             // Wenn Shebang-Command fehlschlägt, bleibe im Fenster für weitere Eingabe
                         } 
                         // Prüfe dann auf natürliche Commands (launch, start, terminate etc.)
-                        else if (g_commandManager.IsNaturalCommand(g_inputBuffer)) {
-                            if (g_commandManager.ExecuteNaturalCommand(g_inputBuffer)) {
+                        else if (g_commandManager->IsNaturalCommand(g_inputBuffer)) {
+                            if (g_commandManager->ExecuteNaturalCommand(g_inputBuffer)) {
                                 g_isWindowVisible = false;
                                 ShowWindow(g_hwnd, SW_HIDE);
                                 g_inputBuffer.clear();
@@ -775,7 +848,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
                         } 
                         else {
                             // PowerShell fallback mit History-Tracking
-                            g_commandManager.ExecutePowerShellCommand(g_inputBuffer);
+                            g_commandManager->ExecutePowerShellCommand(g_inputBuffer);
                             
                             SHELLEXECUTEINFOW sei = { sizeof(sei) };
                             sei.fMask = SEE_MASK_NOCLOSEPROCESS;
@@ -835,11 +908,24 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
                     // Use a simple natural command execution for now.
                     // This assumes commands like "notepad", "calculator" can be found.
                     std::wstring naturalCommand = L"launch " + commandToExecute;
-                    g_commandManager.ExecuteNaturalCommand(naturalCommand);
+                    g_commandManager->ExecuteNaturalCommand(naturalCommand);
                 }
             }
             break;
         }
+        case WM_APP_SEARCH_RESULTS:
+            ApplySearchResults();
+            break;
+        case WM_APP_ICONS_READY:
+            // Nachgeladene Icons der sichtbaren Treffer zeichnen
+            InvalidateRect(hwnd, NULL, FALSE);
+            break;
+        case WM_APP_CATALOG_CHANGED:
+            // Neuer Anwendungskatalog aus dem Hintergrund: laufende Suche darauf wiederholen
+            if (!g_inputBuffer.empty() && g_inputBuffer[0] != L'!') {
+                UpdateFoundCommands(g_inputBuffer);
+            }
+            break;
         case WM_ACTIVATE:
             // Redraw to show/hide focus glow
             InvalidateRect(hwnd, NULL, FALSE);
@@ -850,6 +936,7 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
 
         case WM_DESTROY:
             KillTimer(hwnd, 1);
+            ShutdownCore(); // Worker beenden und ausstehende Änderungen schreiben, bevor das Fenster verschwindet
             g_hotkeyManager.UnregisterHotkeys(hwnd);
             if (g_hFont) DeleteObject(g_hFont);
             if (g_hDescFont) DeleteObject(g_hDescFont);
@@ -878,6 +965,19 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
         return 0; // Exit silently
     }
 
+    // Launcher, Prozesse, Pfade und Meldungen über die Win32-Implementierungen
+    InstallWin32PlatformServices();
+
+    // Verlauf, Frecency und Auswahlen lösen ihre Dateipfade im Konstruktor über das IFileSystem auf
+    g_commandManager = std::make_unique<CommandManager>();
+
+    // Startphasen in die Debug-Ausgabe (z.B. DebugView)
+    StartupProfiler::Instance().SetOutput([](const std::wstring& line) {
+        OutputDebugStringW(line.c_str());
+    });
+    StartupProfiler::Phase startupPhase(L"startup");
+    StartupProfiler::Phase windowPhase(L"window");
+
     WNDCLASSW wc = {};
     wc.lpfnWndProc = WndProc;
     wc.hInstance = hInstance;
@@ -888,6 +988,7 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
 
     if (!RegisterClassW(&wc)) {
         MessageBoxW(NULL, L"Window Registration Failed!", L"Error", MB_ICONEXCLAMATION | MB_OK);
+        ShutdownCore();
         return 0;
     }
 
@@ -905,6 +1006,7 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
 
     if (g_hwnd == NULL) {
         MessageBoxW(NULL, L"Window Creation Failed!", L"Error", MB_ICONEXCLAMATION | MB_OK);
+        ShutdownCore();
         return 0;
     }
 
@@ -913,14 +1015,42 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
     DWM_WINDOW_CORNER_PREFERENCE cornerPreference = DWMWCP_ROUND;
     DwmSetWindowAttribute(g_hwnd, DWMWA_WINDOW_CORNER_PREFERENCE, &cornerPreference, sizeof(cornerPreference));
 #endif
+    windowPhase.End();
+
+    StartupProfiler::Phase pluginsPhase(L"plugins");
+    g_commandManager->RegisterAllPlugins();
+    pluginsPhase.End();
 
-    g_commandManager.RegisterAllPlugins();
+    // Der Katalog startet aus dem (evtl. veralteten) Cache und wird im Hintergrund ersetzt
+    ApplicationFinder::Instance().SetCatalogChangedCallback([]() {
+        PostMessageW(g_hwnd, WM_APP_CATALOG_CHANGED, 0, 0);
+    });
+
+    // Der IconCache lädt auf seinem eigenen Thread und meldet fertige Icons hierher
+    IconCache::Instance().SetReadyCallback([]() {
+        PostMessageW(g_hwnd, WM_APP_ICONS_READY, 0, 0);
+    });
+
+    // Die Prozesstabelle füllt sich auf ihrem eigenen Thread, bevor jemand "!t" tippt
+    ProcessTable::Instance();
+    
+    // Such-Provider erst nach der Registrierung anlegen; der Callback läuft auf einem Worker
+    g_searchScheduler = std::make_unique<SearchScheduler>(SEARCH_WORKER_COUNT, MAX_SEARCH_RESULTS, [](uint64_t) {
+        PostMessageW(g_hwnd, WM_APP_SEARCH_RESULTS, 0, 0);
+    });
+    g_searchScheduler->AddProvider(std::make_unique<CommandSearchProvider>(*g_commandManager));
+    g_searchScheduler->AddProvider(std::make_unique<HistorySearchProvider>(*g_commandManager));
+    g_searchScheduler->AddProvider(std::make_unique<ApplicationSearchProvider>(g_commandManager->GetSelectionModel()));
+    g_searchScheduler->AddProvider(std::make_unique<ProcessSearchProvider>());
+    
     UpdateFoundCommands(L"");
 
     if (!g_hotkeyManager.RegisterHotkeys(g_hwnd)) {
         MessageBoxW(NULL, L"Hotkey Registration Failed!", L"Error", MB_ICONEXCLAMATION | MB_OK);
+        ShutdownCore();
         return 0;
     }
+    startupPhase.End();
 
     // Message loop
     MSG msg = {};
@@ -930,6 +1060,7 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
     }
 
     g_hotkeyManager.UnregisterHotkeys(g_hwnd);
+    ShutdownCore(); // Falls die Schleife ohne WM_DESTROY endete
 
     ReleaseMutex(hMutex);
     CloseHandle(hMutex);